@@ -15,6 +15,9 @@ namespace Nastro
     static constexpr auto SETTINGS_RENDERING_BLANK_COLOR = "rendering/blankColor";
     static constexpr auto DEFAULT_BLANK_COLOR = Qt::black;
 
+    static constexpr auto SETTINGS_FILE_ACCESS_MEMORY_MAP = "fileAccess/memoryMap";
+    static constexpr auto DEFAULT_MEMORY_MAP = false;
+
     template <typename T>
     [[nodiscard]] T SafeGetSetting(const QSettings& settings, const QString& key, const T& defaultValue)
     {
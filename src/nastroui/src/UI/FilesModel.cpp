@@ -45,6 +45,11 @@ const FilesTreeItem* FilesTreeItem::GetChild(const std::size_t& index) const
     return m_children.at(index).get();
 }
 
+FilesTreeItem* FilesTreeItem::GetChild(const std::size_t& index)
+{
+    return m_children.at(index).get();
+}
+
 std::size_t FilesTreeItem::NumChildren() const
 {
     return m_children.size();
@@ -344,37 +349,74 @@ void FilesModel::AddFiles(const std::unordered_map<std::filesystem::path, std::v
 {
     for (const auto& fileIt : importedFiles)
     {
-        const auto newRowIndex = static_cast<int>(m_rootItem->NumChildren());
+        AddFileHDUs(fileIt.first, 0, fileIt.second);
+    }
+}
+
+void FilesModel::AddFileHDUs(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus)
+{
+    //
+    // Find the file's row, inserting a row for the file if it doesn't have one yet
+    //
+    FilesTreeItem* pFileItem = nullptr;
+    int fileRowIndex = 0;
+
+    for (std::size_t x = 0; x < m_rootItem->NumChildren(); ++x)
+    {
+        const auto pChild = m_rootItem->GetChild(x);
 
-        //
-        // Insert a row for the file
-        //
-        beginInsertRows(QModelIndex(), newRowIndex, newRowIndex);
+        if ((pChild->GetType() == FilesTreeItem::Type::FITS) && (dynamic_cast<const FITSFilesTreeItem*>(pChild)->GetFilePath() == filePath))
+        {
+            pFileItem = pChild;
+            fileRowIndex = static_cast<int>(x);
+            break;
+        }
+    }
 
-            auto fileItem = std::make_unique<FITSFilesTreeItem>(fileIt.first, m_rootItem.get());
-            auto pFileItem = fileItem.get();
+    if (pFileItem == nullptr)
+    {
+        fileRowIndex = static_cast<int>(m_rootItem->NumChildren());
+
+        beginInsertRows(QModelIndex(), fileRowIndex, fileRowIndex);
+
+            auto fileItem = std::make_unique<FITSFilesTreeItem>(filePath, m_rootItem.get());
+            pFileItem = fileItem.get();
             m_rootItem->AddChild(std::move(fileItem));
 
         endInsertRows();
+    }
 
-        // QModelIndex of the above inserted file row
-        const auto parentIndex = index(newRowIndex, 0, QModelIndex());
+    if (hdus.empty())
+    {
+        return;
+    }
 
-        //
-        // Insert child rows for the file's HDUs
-        //
-        std::size_t hduIndex = 0;
+    // HDUs must be added in order, following the file's existing HDUs
+    if (firstHDUIndex != pFileItem->NumChildren())
+    {
+        return;
+    }
 
-        for (const auto& hdu : fileIt.second)
-        {
-            beginInsertRows(parentIndex, (int)hduIndex, (int)hduIndex);
+    // QModelIndex of the file's row
+    const auto parentIndex = index(fileRowIndex, 0, QModelIndex());
+
+    //
+    // Insert child rows for the file's HDUs, all at once
+    //
+    const auto firstRowIndex = static_cast<int>(firstHDUIndex);
+    const auto lastRowIndex = static_cast<int>(firstHDUIndex + hdus.size() - 1U);
+
+    beginInsertRows(parentIndex, firstRowIndex, lastRowIndex);
 
-                auto hduItem = std::make_unique<HDUFilesTreeItem>(hdu, hduIndex++, pFileItem);
-                pFileItem->AddChild(std::move(hduItem));
+        std::size_t hduIndex = firstHDUIndex;
 
-            endInsertRows();
+        for (const auto& hdu : hdus)
+        {
+            auto hduItem = std::make_unique<HDUFilesTreeItem>(hdu, hduIndex++, pFileItem);
+            pFileItem->AddChild(std::move(hduItem));
         }
-    }
+
+    endInsertRows();
 }
 
 QVariant FilesModel::headerData(int section, Qt::Orientation orientation, int role) const
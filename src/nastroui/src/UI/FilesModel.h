@@ -45,6 +45,7 @@ namespace Nastro
 
             void AddChild(std::unique_ptr<FilesTreeItem> child);
             [[nodiscard]] const FilesTreeItem* GetChild(const std::size_t& index) const;
+            [[nodiscard]] FilesTreeItem* GetChild(const std::size_t& index);
             [[nodiscard]] std::size_t NumChildren() const;
             [[nodiscard]] std::size_t GetIndexOfChild(const FilesTreeItem* pFileTreeItem) const;
             void RemoveAllChildren();
@@ -104,6 +105,12 @@ namespace Nastro
 
             void AddFiles(const std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>>& importedFiles);
 
+            /**
+             * Adds a batch of a file's HDUs, adding a row for the file if it doesn't have one yet. A file's HDUs
+             * must be added in order; firstHDUIndex is the index of the batch's first HDU within the file.
+             */
+            void AddFileHDUs(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus);
+
             //
             // QAbstractItemModel
             //
@@ -76,8 +76,8 @@ void FilesWidget::InitUI()
 
 void FilesWidget::BindVM()
 {
-    // When VM has imported new files, add them to this widget
-    connect(m_pMainWindowVM, &MainWindowVM::Signal_FilesImported, this, &FilesWidget::AddFiles);
+    // As the VM imports files' HDUs, add them to this widget
+    connect(m_pMainWindowVM, &MainWindowVM::Signal_FileHDUsImported, this, &FilesWidget::AddFileHDUs);
 }
 
 void FilesWidget::InitialState()
@@ -95,6 +95,15 @@ void FilesWidget::AddFiles(const std::unordered_map<std::filesystem::path, std::
     m_pTreeView->expandAll();
 }
 
+void FilesWidget::AddFileHDUs(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus)
+{
+    // Add the HDUs to the model
+    m_pTreeViewModel->AddFileHDUs(filePath, firstHDUIndex, hdus);
+
+    // Force the treeview to expand its nodes
+    m_pTreeView->expandAll();
+}
+
 void FilesWidget::dragEnterEvent(QDragEnterEvent* pEvent)
 {
     for (const auto& url : pEvent->mimeData()->urls())
@@ -62,6 +62,7 @@ namespace Nastro
             void InitialState();
 
             void AddFiles(const std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>>& importedFiles);
+            void AddFileHDUs(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus);
 
             [[nodiscard]] std::vector<const FilesTreeItem*> GetSelectedTreeItems() const;
 
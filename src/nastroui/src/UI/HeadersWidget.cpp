@@ -83,7 +83,7 @@ void HeadersWidget::DisplayHDU(const NFITS::HDU& hdu)
 {
     m_pTableViewModel->clear();
 
-    for (const auto& headerBlock : hdu.header.headerBlocks)
+    for (const auto& headerBlock : hdu.header.GetHeaderBlocks())
     {
         for (const auto& keywordRecord : headerBlock.keywordRecords)
         {
@@ -27,6 +27,7 @@
 #include <QFileDialog>
 #include <QMdiArea>
 #include <QMdiSubWindow>
+#include <QStatusBar>
 
 #include <iostream>
 #include <ranges>
@@ -110,41 +111,46 @@ void MainWindow::InitWidgets()
 
 void MainWindow::BindVM()
 {
+    connect(m_pVM.get(), &MainWindowVM::Signal_FileHDUsImported, this, &MainWindow::Slot_VM_FileHDUsImported);
     connect(m_pVM.get(), &MainWindowVM::Signal_FilesImported, this, &MainWindow::Slot_VM_FilesImported);
 }
 
-void MainWindow::Slot_VM_FilesImported(const std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>>& files)
+void MainWindow::Slot_VM_FileHDUsImported(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus)
 {
     //
-    // When files have imported, if we had an initial launch path, automatically
-    // load and open the first image in the now loaded file
+    // If we had an initial launch path, automatically load and open the first image in its file as soon
+    // as it's been imported, rather than once the whole file has been imported
     //
-    if (m_initialLaunchPath && !files.empty())
+    if (!m_initialLaunchPath || (filePath != *m_initialLaunchPath))
     {
-        //
-        // Search through the file's HDUs for the first image HDU
-        //
-        const auto fileIt = files.cbegin(); // Note that we only use the first file
-
-        std::optional<std::size_t> firstImageIndex = 0;
+        return;
+    }
 
-        for (std::size_t x = 0; x < fileIt->second.size(); ++x)
+    for (std::size_t x = 0; x < hdus.size(); ++x)
+    {
+        if (hdus.at(x).ContainsAnyTypeOfImageData())
         {
-            const auto hdu = fileIt->second.at(x);
+            LoadAndDisplayHDU(FileHDU{.filePath = filePath, .hduIndex = firstHDUIndex + x});
 
-            if (hdu.ContainsAnyTypeOfImageData())
-            {
-                firstImageIndex = x;
-                break;
-            }
+            m_initialLaunchPath = std::nullopt;
+            return;
         }
+    }
+}
 
-        //
-        // If found a valid image HDU, automatically load and display it
-        //
-        if (firstImageIndex)
+void MainWindow::Slot_VM_FilesImported(const std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>>& files)
+{
+    //
+    // If the initial launch path's file has finished importing without any image HDU having been found,
+    // fall back to opening its first HDU
+    //
+    if (m_initialLaunchPath)
+    {
+        const auto fileIt = files.find(*m_initialLaunchPath);
+
+        if ((fileIt != files.cend()) && !fileIt->second.empty())
         {
-            LoadAndDisplayHDU(FileHDU{.filePath = fileIt->first, .hduIndex = *firstImageIndex});
+            LoadAndDisplayHDU(FileHDU{.filePath = fileIt->first, .hduIndex = 0});
         }
     }
 
@@ -157,13 +163,13 @@ void MainWindow::Slot_VM_FilesImported(const std::unordered_map<std::filesystem:
 
 void MainWindow::Slot_File_ImportFiles_ActionTriggered()
 {
-    // Produce a string that looks like "*.fits *.fit *.fts"
+    // Produce a string that looks like "*.fits *.fits.gz *.fit *.fit.gz *.fts *.fts.gz"
     std::string extensionsStr;
 
     std::size_t pos = 0;
     for (const auto& extension : VALID_FITS_EXTENSIONS)
     {
-        extensionsStr += std::format("*{}", extension);
+        extensionsStr += std::format("*{} *{}{}", extension, extension, GZIP_EXTENSION);
 
         if (pos++ != VALID_FITS_EXTENSIONS.size() - 1)
         {
@@ -247,6 +253,8 @@ void MainWindow::Slot_OpenHDU_LoadHDUData_Complete(Nastro::Worker* pWorker)
 
     auto pLoadHDUDataWorker = dynamic_cast<LoadHDUDataWorker*>(pWorker);
 
+    statusBar()->showMessage(QString::fromStdString(pLoadHDUDataWorker->GetIOStatsMsg()));
+
     auto& resultsOpt = pLoadHDUDataWorker->GetResult();
     if (!resultsOpt)
     {
@@ -316,6 +324,8 @@ void MainWindow::Slot_CompareHDUs_LoadHDUData_Complete(Nastro::Worker* pWorker)
 
     auto pLoadHDUDataWorker = dynamic_cast<LoadHDUDataWorker*>(pWorker);
 
+    statusBar()->showMessage(QString::fromStdString(pLoadHDUDataWorker->GetIOStatsMsg()));
+
     auto& resultsOpt = pLoadHDUDataWorker->GetResult();
     if (!resultsOpt)
     {
@@ -45,6 +45,7 @@ namespace Nastro
 
         private slots:
 
+            void Slot_VM_FileHDUsImported(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus);
             void Slot_VM_FilesImported(const std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>>& files);
 
             void Slot_File_ImportFiles_ActionTriggered();
@@ -6,6 +6,7 @@
  
 #include "SettingsDialog.h"
 #include "SettingsRenderingWidget.h"
+#include "SettingsFileAccessWidget.h"
 
 #include <QListWidget>
 #include <QDialogButtonBox>
@@ -27,6 +28,7 @@ SettingsDialog::SettingsDialog(QWidget* parent, Qt::WindowFlags f)
 void SettingsDialog::InitUI()
 {
     m_pSettingsRenderingWidget = new SettingsRenderingWidget();
+    m_pSettingsFileAccessWidget = new SettingsFileAccessWidget();
 
     auto pCategoriesListWidget = new QListWidget();
     auto pStackedWidget = new QStackedWidget();
@@ -34,6 +36,9 @@ void SettingsDialog::InitUI()
     pCategoriesListWidget->addItem(tr("Image Rendering"));
     pStackedWidget->addWidget(m_pSettingsRenderingWidget);
 
+    pCategoriesListWidget->addItem(tr("File Access"));
+    pStackedWidget->addWidget(m_pSettingsFileAccessWidget);
+
     connect(pCategoriesListWidget, &QListWidget::currentRowChanged, pStackedWidget, &QStackedWidget::setCurrentIndex);
 
     pCategoriesListWidget->setCurrentRow(0);
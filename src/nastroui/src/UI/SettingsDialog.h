@@ -26,6 +26,7 @@ namespace Nastro
         private:
 
             QWidget* m_pSettingsRenderingWidget{nullptr};
+            QWidget* m_pSettingsFileAccessWidget{nullptr};
     };
 }
 
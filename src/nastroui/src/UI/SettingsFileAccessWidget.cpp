@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "SettingsFileAccessWidget.h"
+
+#include "../Settings.h"
+
+#include <QLabel>
+#include <QFormLayout>
+#include <QCheckBox>
+
+namespace Nastro
+{
+
+SettingsFileAccessWidget::SettingsFileAccessWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    InitUI();
+}
+
+void SettingsFileAccessWidget::InitUI()
+{
+    //
+    // Memory mapping
+    //
+    auto pMemoryMapCheckBox = new QCheckBox(tr("Memory map files"));
+    pMemoryMapCheckBox->setChecked(SafeGetSetting<bool>(m_settings, SETTINGS_FILE_ACCESS_MEMORY_MAP, DEFAULT_MEMORY_MAP));
+    connect(pMemoryMapCheckBox, &QCheckBox::toggled, this, &SettingsFileAccessWidget::Slot_OnMemoryMapToggled);
+
+    auto pMemoryMapLabel = new QLabel(tr("Faster for large files, but the application will crash if a file is "
+                                         "truncated by another program while it's open. Applies to files opened "
+                                         "from now on."));
+    pMemoryMapLabel->setWordWrap(true);
+
+    //
+    // Main layout
+    //
+    auto pFormLayout = new QFormLayout(this);
+
+    pFormLayout->addRow(pMemoryMapCheckBox);
+    pFormLayout->addRow(pMemoryMapLabel);
+}
+
+void SettingsFileAccessWidget::Slot_OnMemoryMapToggled(bool checked)
+{
+    m_settings.setValue(SETTINGS_FILE_ACCESS_MEMORY_MAP, checked);
+}
+
+}
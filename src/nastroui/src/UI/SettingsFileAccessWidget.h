@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NASTROUI_SRC_UI_SETTINGSFILEACCESSWIDGET_H
+#define NASTROUI_SRC_UI_SETTINGSFILEACCESSWIDGET_H
+
+#include <QWidget>
+#include <QSettings>
+
+namespace Nastro
+{
+    class SettingsFileAccessWidget : public QWidget
+    {
+        Q_OBJECT
+
+        public:
+
+            explicit SettingsFileAccessWidget(QWidget* parent = nullptr);
+
+        private slots:
+
+            void Slot_OnMemoryMapToggled(bool checked);
+
+        private:
+
+            void InitUI();
+
+        private:
+
+            QSettings m_settings;
+    };
+}
+
+
+#endif //NASTROUI_SRC_UI_SETTINGSFILEACCESSWIDGET_H
@@ -6,9 +6,193 @@
  
 #include "Common.h"
 
+#include "../Settings.h"
+
+#include <NFITS/MappedFITSByteSource.h>
+#include <NFITS/ConcurrentDiskFITSByteSource.h>
+#include <NFITS/CachingFITSByteSource.h>
+#include <NFITS/ReadAheadFITSByteSource.h>
+#include <NFITS/InstrumentedFITSByteSource.h>
+#include <NFITS/GzipFITSByteSource.h>
+
+#include <chrono>
+#include <format>
+#include <functional>
+
 namespace Nastro
 {
 
+std::shared_ptr<NFITS::FITSByteCache> GetFileByteCache()
+{
+    static auto pCache = std::make_shared<NFITS::FITSByteCache>(NFITS::FITSByteCacheParams{});
+    return pCache;
+}
+
+bool IsFITSFilePath(const std::filesystem::path& filePath)
+{
+    if (filePath.extension() == GZIP_EXTENSION)
+    {
+        return VALID_FITS_EXTENSIONS.contains(filePath.stem().extension().string());
+    }
+
+    return VALID_FITS_EXTENSIONS.contains(filePath.extension().string());
+}
+
+std::expected<std::string, NFITS::Error> GetFileKey(const std::filesystem::path& filePath)
+{
+    std::error_code ec{};
+    const auto fileSize = std::filesystem::file_size(filePath, ec);
+    const auto lastWriteTime = std::filesystem::last_write_time(filePath, ec);
+    if (ec)
+    {
+        return std::unexpected(NFITS::Error::Msg("OpenFileByteSource: Failed to query file size/modification time"));
+    }
+
+    return std::format("{}|{}|{}", filePath.string(), fileSize, lastWriteTime.time_since_epoch().count());
+}
+
+/**
+ * @return Path of a file, within a temp directory subdirectory, which persists an index of the file with the
+ * provided key, or std::nullopt if the directory can't be created. Index files are named by their file's key, so
+ * that a modified file's stale index is never used.
+ */
+std::optional<std::filesystem::path> GetIndexFilePath(const std::string& indexDirectoryName, const std::string& fileKey)
+{
+    std::error_code ec{};
+    const auto indexDirectory = std::filesystem::temp_directory_path(ec) / indexDirectoryName;
+    if (!ec)
+    {
+        std::filesystem::create_directories(indexDirectory, ec);
+    }
+
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    return indexDirectory / std::format("{:x}.idx", std::hash<std::string>{}(fileKey));
+}
+
+std::expected<std::unique_ptr<NFITS::IFITSByteSource>, NFITS::Error> OpenGzipFileByteSource(const std::filesystem::path& filePath)
+{
+    auto pDiskByteSource = NFITS::ConcurrentDiskFITSByteSource::Open(filePath, NFITS::ConcurrentDiskFITSByteSource::Access::ReadOnly, false);
+    if (!pDiskByteSource)
+    {
+        return std::unexpected(pDiskByteSource.error());
+    }
+
+    const auto fileKey = GetFileKey(filePath);
+    if (!fileKey)
+    {
+        return std::unexpected(fileKey.error());
+    }
 
+    // Persist the file's seek index in the temp directory. If that's not possible the index is simply rebuilt
+    // on every open.
+    NFITS::GzipParams gzipParams{};
+    gzipParams.indexFilePath = GetIndexFilePath("nastro_gz_index", *fileKey);
+
+    auto pGzipByteSource = NFITS::GzipFITSByteSource::Create(std::move(*pDiskByteSource), gzipParams);
+    if (!pGzipByteSource)
+    {
+        return std::unexpected(pGzipByteSource.error());
+    }
+
+    // Inflated bytes are expensive to reproduce, so they're kept in the byte cache, keyed by the file's key, where
+    // they outlive the source; a file's headers, inflated when it's imported, are then already cached when it's
+    // opened again to load its HDUs' data
+    return NFITS::InstrumentedFITSByteSource::Create(
+        NFITS::CachingFITSByteSource::Create(std::move(*pGzipByteSource), GetFileByteCache(), *fileKey)
+    );
+}
+
+std::expected<std::unique_ptr<NFITS::IFITSByteSource>, NFITS::Error> OpenFileByteSource(const std::filesystem::path& filePath)
+{
+    if (filePath.extension() == GZIP_EXTENSION)
+    {
+        return OpenGzipFileByteSource(filePath);
+    }
+
+    //
+    // Memory map the file, if enabled and possible. Opt-in, as a mapped file which another process truncates
+    // while it's open (e.g. an acquisition pipeline rewriting it) raises SIGBUS when read, rather than a read
+    // error. Note that mapped files don't go through the byte cache, as their bytes are already cached by the
+    // OS's page cache, and are read without copying them.
+    //
+    if (SafeGetSetting<bool>(QSettings(), SETTINGS_FILE_ACCESS_MEMORY_MAP, DEFAULT_MEMORY_MAP))
+    {
+        auto pMappedByteSource = NFITS::MappedFITSByteSource::Open(filePath);
+        if (pMappedByteSource)
+        {
+            return NFITS::InstrumentedFITSByteSource::Create(std::move(*pMappedByteSource));
+        }
+    }
+
+    //
+    // Otherwise, positional reads, through the byte cache, with sequential reads of the file's data prefetched
+    // ahead of time
+    //
+    auto pDiskByteSource = NFITS::ConcurrentDiskFITSByteSource::Open(filePath, NFITS::ConcurrentDiskFITSByteSource::Access::ReadOnly, false);
+    if (!pDiskByteSource)
+    {
+        return std::unexpected(pDiskByteSource.error());
+    }
+
+    // Key the file's cached bytes by its path, size, and modification time, so that a modified file's stale
+    // cached bytes are never used
+    const auto cacheKey = GetFileKey(filePath);
+    if (!cacheKey)
+    {
+        return std::unexpected(cacheKey.error());
+    }
+
+    return NFITS::InstrumentedFITSByteSource::Create(
+        NFITS::ReadAheadFITSByteSource::Create(
+            NFITS::CachingFITSByteSource::Create(std::move(*pDiskByteSource), GetFileByteCache(), *cacheKey)
+        )
+    );
+}
+
+NFITS::FITSFileOpenParams GetFITSFileOpenParams(const std::filesystem::path& filePath)
+{
+    NFITS::FITSFileOpenParams params{};
+    params.lazyHeaders = true;
+
+    // Persist the file's HDU index in the temp directory. If the file's key can't be determined, or the index
+    // can't be persisted, the file's headers are simply read on every open.
+    if (const auto fileKey = GetFileKey(filePath))
+    {
+        params.hduIndexFilePath = GetIndexFilePath("nastro_hdu_index", *fileKey);
+        params.hduIndexKey = *fileKey;
+    }
+
+    return params;
+}
+
+std::optional<std::string> GetIOStatsSummary(const NFITS::IFITSByteSource* pByteSource)
+{
+    if (pByteSource->GetType() != NFITS::BYTE_SOURCE_TYPE_INSTRUMENTED)
+    {
+        return std::nullopt;
+    }
+
+    const auto stats = static_cast<const NFITS::InstrumentedFITSByteSource*>(pByteSource)->GetStats();
+    const auto& reads = stats.reads;
+
+    auto summary = std::format("{} reads, {:.1f} MiB, p50 {}us, p99 {}us, {:.1f}ms total",
+                               reads.count,
+                               static_cast<double>(reads.byteSize) / (1024.0 * 1024.0),
+                               reads.latency.GetPercentile(50.0).count(),
+                               reads.latency.GetPercentile(99.0).count(),
+                               std::chrono::duration<double, std::milli>(reads.totalDuration).count());
+
+    // Mapped sources are read through views of their memory rather than with reads
+    if (stats.views.count != 0)
+    {
+        summary += std::format("; {} views, {:.1f} MiB", stats.views.count, static_cast<double>(stats.views.byteSize) / (1024.0 * 1024.0));
+    }
+
+    return summary;
+}
 
 }
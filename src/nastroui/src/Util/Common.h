@@ -8,6 +8,8 @@
 #define SRC_UTIL_COMMON_H
 
 #include <NFITS/WCS/WCS.h>
+#include <NFITS/IFITSByteSource.h>
+#include <NFITS/FITSFile.h>
 
 #include <unordered_set>
 #include <string>
@@ -15,11 +17,16 @@
 #include <utility>
 #include <vector>
 #include <optional>
+#include <memory>
+#include <expected>
 
 namespace Nastro
 {
     static const std::unordered_set<std::string> VALID_FITS_EXTENSIONS = { ".fts", ".fits", ".fit" };
 
+    // Extension of gzip-compressed FITS files, following a valid FITS extension, such as .fits.gz
+    static const std::string GZIP_EXTENSION = ".gz";
+
     struct FileHDU
     {
         std::filesystem::path filePath;
@@ -40,6 +47,38 @@ namespace Nastro
         // WCS coordinates derived from the pixel's coordinate
         std::vector<NFITS::WCSWorldCoord> wcsCoords;
     };
+
+    /**
+     * @return Whether the path has a FITS file extension, either plain or gzip-compressed
+     */
+    [[nodiscard]] bool IsFITSFilePath(const std::filesystem::path& filePath);
+
+    /**
+     * Opens a filesystem file as a FITS byte source. The returned source supports concurrent reads.
+     *
+     * The file is read via positional reads through a process-wide byte cache, so that re-opening a file, or
+     * re-reading its headers/data, is served from memory. If the memory map setting is enabled, the file is
+     * instead memory mapped where possible.
+     *
+     * Gzip-compressed files are inflated transparently. Their seek index is persisted to a temp directory file,
+     * so that re-opening the file doesn't inflate all of it again.
+     *
+     * Either way, the returned source records I/O stats for the file; see GetIOStatsSummary.
+     */
+    [[nodiscard]] std::expected<std::unique_ptr<NFITS::IFITSByteSource>, NFITS::Error> OpenFileByteSource(const std::filesystem::path& filePath);
+
+    /**
+     * @return Params for opening a filesystem file's byte source as a FITSFile. Headers are parsed lazily, and the
+     * file's HDU index is persisted to a temp directory file, so that re-opening the file doesn't read its headers
+     * again unless it's been modified.
+     */
+    [[nodiscard]] NFITS::FITSFileOpenParams GetFITSFileOpenParams(const std::filesystem::path& filePath);
+
+    /**
+     * @return A one line, human readable, summary of the reads a byte source opened by OpenFileByteSource has
+     * performed, or std::nullopt if the source doesn't record I/O stats
+     */
+    [[nodiscard]] std::optional<std::string> GetIOStatsSummary(const NFITS::IFITSByteSource* pByteSource);
 }
 
 #endif //SRC_UTIL_COMMON_H
@@ -5,15 +5,19 @@
  */
  
 #include "ImportFilesWorker.h"
+#include "Common.h"
 
-#include <NFITS/DiskFITSByteSource.h>
 #include <NFITS/FITSFile.h>
 
+#include <chrono>
 #include <iostream>
 
 namespace Nastro
 {
 
+// Max time that read HDUs are held back before being reported
+static constexpr auto HDU_REPORT_INTERVAL = std::chrono::milliseconds(100);
+
 ImportFilesWorker::ImportFilesWorker(std::vector<std::filesystem::path> filePaths)
     : m_filePaths(std::move(filePaths))
 {
@@ -49,27 +53,58 @@ void ImportFilesWorker::ImportFile(const std::filesystem::path& filePath)
         return;
     }
 
-    auto byteSource = NFITS::DiskFITSByteSource::Open(filePath, false);
+    auto byteSource = OpenFileByteSource(filePath);
     if (!byteSource)
     {
         std::cerr << "ImportFilesWorker: Failed to open file as byte source, error: " << byteSource.error().msg << std::endl;
         return;
     }
 
-    auto result = NFITS::FITSFile::OpenBlocking(std::move(*byteSource));
+    //
+    // Report the file's HDUs in batches as they're read, so that the first HDUs of a file with thousands of them
+    // can be shown/opened long before the rest have been read
+    //
+    std::vector<NFITS::HDU> hduBatch;
+    std::size_t hduBatchStartIndex = 0;
+    auto lastReportTime = std::chrono::steady_clock::now();
+
+    const auto reportHDUBatch = [&](){
+        if (!hduBatch.empty())
+        {
+            emit Signal_FileHDUsImported(filePath, hduBatchStartIndex, hduBatch);
+            emit Signal_StatusMsg(QString::fromStdString(std::format("{}: {} ({} HDUs)",
+                tr("Importing file").toStdString(), filePath.filename().string(), hduBatchStartIndex + hduBatch.size())));
+
+            hduBatchStartIndex += hduBatch.size();
+            hduBatch.clear();
+        }
+
+        lastReportTime = std::chrono::steady_clock::now();
+    };
+
+    auto openParams = GetFITSFileOpenParams(filePath);
+
+    openParams.onHDU = [&](const NFITS::HDU& hdu, std::size_t){
+        hduBatch.push_back(hdu);
+
+        if ((std::chrono::steady_clock::now() - lastReportTime) >= HDU_REPORT_INTERVAL)
+        {
+            reportHDUBatch();
+        }
+    };
+
+    openParams.isCancelled = [this](){ return IsCancelled(); };
+
+    const auto result = NFITS::FITSFile::OpenBlocking(std::move(*byteSource), openParams);
+
+    // Note that HDUs read before a failure are still reported
+    reportHDUBatch();
+
     if (!result)
     {
         std::cerr << "ImportFilesWorker: Failed to open file as fits file, error: " << result.error().msg << std::endl;
         return;
     }
-
-    std::vector<NFITS::HDU> hdus;
-    for (std::size_t x = 0; x < (*result)->GetNumHDUs(); ++x)
-    {
-        hdus.push_back(*(*(*result)->GetHDU(x)));
-    }
-
-    m_importedHDUs.insert({filePath, hdus});
 }
 
 }
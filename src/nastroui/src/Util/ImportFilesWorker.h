@@ -11,21 +11,32 @@
 
 #include <NFITS/HDU.h>
 
+#include <cstddef>
 #include <filesystem>
 #include <vector>
-#include <unordered_map>
 
 namespace Nastro
 {
+    /**
+     * Imports the HDUs of FITS files. Each file's HDUs are reported, in batches, as soon as they've been read,
+     * rather than once all of the files have been imported.
+     */
     class ImportFilesWorker : public Worker
     {
+        Q_OBJECT
+
+        signals:
+
+            /** Emitted with a file's next batch of imported HDUs, the first of which has index firstHDUIndex */
+            void Signal_FileHDUsImported(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus);
+
         public:
 
             explicit ImportFilesWorker(std::vector<std::filesystem::path> filePaths);
 
             void DoWork() override;
 
-            const std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>>& GetResult() const { return m_importedHDUs; }
+            [[nodiscard]] const std::vector<std::filesystem::path>& GetFilePaths() const noexcept { return m_filePaths; }
 
         private:
 
@@ -34,8 +45,6 @@ namespace Nastro
         private:
 
             std::vector<std::filesystem::path> m_filePaths;
-
-            std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>> m_importedHDUs;
     };
 }
 
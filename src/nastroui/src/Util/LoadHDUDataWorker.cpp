@@ -6,11 +6,13 @@
  
 #include "LoadHDUDataWorker.h"
 
-#include <NFITS/DiskFITSByteSource.h>
 #include <NFITS/FITSFile.h>
 #include <NFITS/Data/DataUtil.h>
 
+#include <algorithm>
 #include <iostream>
+#include <ranges>
+#include <unordered_map>
 
 namespace Nastro
 {
@@ -25,32 +27,126 @@ LoadHDUDataWorker::~LoadHDUDataWorker() = default;
 
 void LoadHDUDataWorker::DoWork()
 {
-    std::vector<std::unique_ptr<NFITS::Data>> result;
+    //
+    // Open each distinct file that HDUs are being loaded from, once. Each file is only read as far as the
+    // last of its HDUs being loaded, as its later HDUs aren't needed; for a large file which is still being
+    // imported, it's far quicker than reading all of its HDUs again.
+    //
+    std::unordered_map<std::filesystem::path, std::size_t> fileNumHDUs;
 
     for (const auto& hdu : m_hdus)
     {
-        auto data = LoadHDU(hdu);
-        if (!data)
+        auto& numHDUs = fileNumHDUs[hdu.filePath];
+        numHDUs = std::max(numHDUs, static_cast<std::size_t>(hdu.hduIndex) + 1U);
+    }
+
+    std::unordered_map<std::filesystem::path, std::unique_ptr<NFITS::FITSFile>> files;
+
+    for (const auto& it : fileNumHDUs)
+    {
+        auto pFITSFile = OpenFile(it.first, it.second);
+        if (!pFITSFile)
         {
             return;
         }
 
-        result.push_back(std::move(*data));
+        files.insert({it.first, std::move(*pFITSFile)});
+    }
+
+    //
+    // Load the HDUs' data. HDUs from files which support concurrent reads are loaded in parallel, a bounded
+    // number at a time, reading from the file that was opened for them above.
+    //
+    emit Signal_StatusMsg(QString::fromStdString(std::format("Loading HDU data")));
+
+    std::vector<NFITS::HDUDataLoad> loads;
+
+    for (const auto& hdu : m_hdus)
+    {
+        const auto pFITSFile = files.at(hdu.filePath).get();
+
+        const auto pHDU = pFITSFile->GetHDU(hdu.hduIndex);
+        if (!pHDU)
+        {
+            std::cout << "LoadHDUDataWorker::DoWork: No such HDU index exists in file: " << hdu.hduIndex << std::endl;
+            emit Signal_WorkCompleteError();
+            return;
+        }
+
+        std::cout << "Loading HDU " << hdu.hduIndex << " data from file " << hdu.filePath.filename() << std::endl;
+
+        loads.push_back(NFITS::HDUDataLoad{.pFile = pFITSFile, .pHDU = *pHDU});
+    }
+
+    auto loadResults = NFITS::LoadHDUsDataBlocking(loads, NFITS::ImageLoadParams{
+        .isCancelled = [this](){ return IsCancelled(); }
+    });
+
+    //
+    // Collect the loaded data, in HDU order
+    //
+    std::vector<std::unique_ptr<NFITS::Data>> result;
+    bool loadFailed = false;
+
+    for (auto& pHDUData : loadResults)
+    {
+        if (!pHDUData)
+        {
+            std::cerr << "LoadHDUDataWorker::DoWork: Failed to load HDU data: " << pHDUData.error().msg << std::endl;
+            loadFailed = true;
+            continue;
+        }
+
+        result.push_back(std::move(*pHDUData));
+    }
+
+    //
+    // Report the I/O the loads performed, per file
+    //
+    std::vector<std::string> ioStatsSummaries;
+
+    for (const auto& it : files)
+    {
+        const auto summary = GetIOStatsSummary(it.second->GetByteSource());
+        if (summary)
+        {
+            ioStatsSummaries.push_back(std::format("{}: {}", it.first.filename().string(), *summary));
+        }
+    }
+
+    m_ioStatsMsg = ioStatsSummaries | std::views::join_with(std::string("; ")) | std::ranges::to<std::string>();
+
+    if (!m_ioStatsMsg.empty())
+    {
+        std::cout << "LoadHDUDataWorker::DoWork: I/O stats: " << m_ioStatsMsg << std::endl;
+        emit Signal_StatusMsg(QString::fromStdString(m_ioStatsMsg));
+    }
+
+    // Note: checked first, as cancelled loads also fail
+    if (IsCancelled())
+    {
+        emit Signal_WorkCancelled();
+        return;
+    }
+    if (loadFailed)
+    {
+        emit Signal_WorkCompleteError();
+        return;
     }
 
     m_result = std::move(result);
     emit Signal_WorkCompleteSuccess();
 }
 
-std::expected<std::unique_ptr<NFITS::Data>, bool> LoadHDUDataWorker::LoadHDU(const FileHDU& hdu)
+std::expected<std::unique_ptr<NFITS::FITSFile>, bool> LoadHDUDataWorker::OpenFile(const std::filesystem::path& filePath,
+                                                                                   std::size_t numHDUs)
 {
-    std::cout << "Loading HDU " << hdu.hduIndex << " data from file " << hdu.filePath.filename() << std::endl;
-    emit Signal_StatusMsg(QString::fromStdString(std::format("Opening file: {}", hdu.filePath.filename().string())));
+    emit Signal_StatusMsg(QString::fromStdString(std::format("Opening file: {}", filePath.filename().string())));
 
     //
     // Open the file path as a FITS byte source
     //
-    auto pByteSource = NFITS::DiskFITSByteSource::Open(hdu.filePath, false);
+    auto pByteSource = OpenFileByteSource(filePath);
     if (!pByteSource)
     {
         std::cout << "LoadHDUDataWorker::DoWork: Failed to open byte source, error: " << pByteSource.error().msg << std::endl;
@@ -66,48 +162,28 @@ std::expected<std::unique_ptr<NFITS::Data>, bool> LoadHDUDataWorker::LoadHDU(con
     //
     // Open the FITS byte source as a FITS file
     //
-    emit Signal_StatusMsg(QString::fromStdString(std::format("Parsing file: {}", hdu.filePath.filename().string())));
+    emit Signal_StatusMsg(QString::fromStdString(std::format("Parsing file: {}", filePath.filename().string())));
 
-    auto pFITSFile = NFITS::FITSFile::OpenBlocking(std::move(*pByteSource));
-    if (!pFITSFile)
-    {
-        std::cout << "LoadHDUDataWorker::DoWork: Failed to open fits file, error: " << pFITSFile.error().msg << std::endl;
-        emit Signal_WorkCompleteError();
-        return std::unexpected(false);
-    }
+    auto openParams = GetFITSFileOpenParams(filePath);
+    openParams.maxNumHDUs = numHDUs;
+    openParams.isCancelled = [this](){ return IsCancelled(); };
+
+    auto pFITSFile = NFITS::FITSFile::OpenBlocking(std::move(*pByteSource), openParams);
+
+    // Note: checked first, as cancelled opens also fail
     if (IsCancelled())
     {
         emit Signal_WorkCancelled();
         return std::unexpected(false);
     }
-
-    //
-    // Load the HDU's data
-    //
-    emit Signal_StatusMsg(QString::fromStdString(std::format("Loading HDU data")));
-
-    const auto pHDU = (*pFITSFile)->GetHDU(hdu.hduIndex);
-    if (!pHDU)
-    {
-        std::cout << "LoadHDUDataWorker::DoWork: No such HDU index exists in file: " << hdu.hduIndex << std::endl;
-        emit Signal_WorkCompleteError();
-        std::unexpected(false);
-    }
-
-    auto pHDUData = LoadHDUDataBlocking(pFITSFile->get(), *pHDU);
-    if (!pHDUData)
+    if (!pFITSFile)
     {
-        std::cerr << "LoadHDUDataWorker::DoWork: Failed to load HDU data: " << pHDUData.error().msg << std::endl;
+        std::cout << "LoadHDUDataWorker::DoWork: Failed to open fits file, error: " << pFITSFile.error().msg << std::endl;
         emit Signal_WorkCompleteError();
         return std::unexpected(false);
     }
-    if (IsCancelled())
-    {
-        emit Signal_WorkCancelled();
-        return std::unexpected(false);
-    }
 
-    return std::move(*pHDUData);
+    return std::move(*pFITSFile);
 }
 
 }
@@ -12,10 +12,12 @@
 
 #include <expected>
 #include <filesystem>
+#include <string>
 
 namespace NFITS
 {
     class Data;
+    class FITSFile;
 }
 
 namespace Nastro
@@ -34,15 +36,26 @@ namespace Nastro
             [[nodiscard]] const std::vector<FileHDU>& GetHDUs() const noexcept { return m_hdus; }
             [[nodiscard]] std::optional<std::vector<std::unique_ptr<NFITS::Data>>>& GetResult() noexcept { return m_result; }
 
+            /**
+             * @return Summary of the I/O performed on the loaded HDUs' files, or an empty string if
+             * their byte sources don't record I/O stats
+             */
+            [[nodiscard]] const std::string& GetIOStatsMsg() const noexcept { return m_ioStatsMsg; }
+
         private:
 
-            [[nodiscard]] std::expected<std::unique_ptr<NFITS::Data>, bool> LoadHDU(const FileHDU& hdu);
+            /**
+             * Opens a file, only reading its first numHDUs HDUs
+             */
+            [[nodiscard]] std::expected<std::unique_ptr<NFITS::FITSFile>, bool> OpenFile(const std::filesystem::path& filePath,
+                                                                                        std::size_t numHDUs);
 
         private:
 
             std::vector<FileHDU> m_hdus;
 
             std::optional<std::vector<std::unique_ptr<NFITS::Data>>> m_result;
+            std::string m_ioStatsMsg;
     };
 }
 
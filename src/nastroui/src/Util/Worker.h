@@ -9,6 +9,7 @@
 
 #include <QObject>
 
+#include <atomic>
 #include <utility>
 #include <optional>
 
@@ -40,7 +41,8 @@ namespace Nastro
 
         protected:
 
-            bool m_isCancelled{false};
+            // Note: atomic, as it's polled from the threads that work is spread across
+            std::atomic<bool> m_isCancelled{false};
     };
 }
 
@@ -64,7 +64,7 @@ void MainWindowVM::OnImportDirectory(const std::filesystem::path& directoryPath)
             return;
         }
 
-        if (VALID_FITS_EXTENSIONS.contains(dirEntry.path().extension().string()))
+        if (IsFITSFilePath(dirEntry.path()))
         {
             filePaths.push_back(dirEntry.path());
         }
@@ -75,16 +75,28 @@ void MainWindowVM::OnImportDirectory(const std::filesystem::path& directoryPath)
 
 void MainWindowVM::OnImportFiles(const std::vector<std::filesystem::path>& filePaths)
 {
-    std::error_code ec{};
+    // Skip files which have already been imported, or are being imported
+    std::vector<std::filesystem::path> toImport;
 
-    if (filePaths.empty())
+    for (const auto& filePath : filePaths)
+    {
+        if (!m_importedFiles.contains(filePath) && !m_importingFiles.contains(filePath))
+        {
+            toImport.push_back(filePath);
+            m_importingFiles.insert(filePath);
+        }
+    }
+
+    if (toImport.empty())
     {
         return;
     }
 
-    auto pImportFilesWorker = new ImportFilesWorker(filePaths);
+    auto pImportFilesWorker = new ImportFilesWorker(toImport);
+    connect(pImportFilesWorker, &ImportFilesWorker::Signal_FileHDUsImported, this, &MainWindowVM::Slot_ImportFiles_FileHDUsImported);
 
-    auto pProgressDialog = new ProgressDialogWork(pImportFilesWorker, ProgressDialogArgs{.isModal = true, .canBeCancelled = true}, m_pParent);
+    // Not modal; files' HDUs can be browsed and opened as soon as they've been imported, while the import continues
+    auto pProgressDialog = new ProgressDialogWork(pImportFilesWorker, ProgressDialogArgs{.isModal = false, .canBeCancelled = true}, m_pParent);
     connect(pProgressDialog, &ProgressDialogWork::Signal_WorkFinished, this, &MainWindowVM::Slot_ImportFiles_WorkFinished);
 }
 
@@ -99,21 +111,34 @@ void MainWindowVM::OnPixelHovered(const std::optional<PixelDetails>& pixelDetail
     emit Signal_OnPixelHoveredChanged(m_hoveredPixelDetails);
 }
 
-void MainWindowVM::Slot_ImportFiles_WorkFinished(Worker* pWorker)
+void MainWindowVM::Slot_ImportFiles_FileHDUsImported(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus)
 {
-    const auto& importedFiles = dynamic_cast<ImportFilesWorker*>(pWorker)->GetResult();
+    auto& fileHDUs = m_importedFiles[filePath];
+
+    if (firstHDUIndex != fileHDUs.size())
+    {
+        std::cerr << "Slot_ImportFiles_FileHDUsImported: HDUs imported out of order for: " << filePath << std::endl;
+        return;
+    }
+
+    fileHDUs.insert(fileHDUs.end(), hdus.cbegin(), hdus.cend());
+
+    emit Signal_FileHDUsImported(filePath, firstHDUIndex, hdus);
+}
 
+void MainWindowVM::Slot_ImportFiles_WorkFinished(Worker* pWorker)
+{
     std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>> newlyImported;
 
-    for (const auto& fileIt : importedFiles)
+    for (const auto& filePath : dynamic_cast<ImportFilesWorker*>(pWorker)->GetFilePaths())
     {
-        if (m_importedFiles.contains(fileIt.first))
+        m_importingFiles.erase(filePath);
+
+        const auto it = m_importedFiles.find(filePath);
+        if (it != m_importedFiles.cend())
         {
-            continue;
+            newlyImported.insert(*it);
         }
-
-        m_importedFiles.insert({fileIt.first, fileIt.second});
-        newlyImported.insert({fileIt.first, fileIt.second});
     }
 
     emit Signal_FilesImported(newlyImported);
@@ -16,6 +16,7 @@
 #include <filesystem>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <optional>
 
 namespace Nastro
@@ -41,12 +42,17 @@ namespace Nastro
 
         signals:
 
+            /** Emitted with a file's next batch of imported HDUs, as soon as they've been read */
+            void Signal_FileHDUsImported(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus);
+
+            /** Emitted once an import has finished, with all of the files, and HDUs, it imported */
             void Signal_FilesImported(const std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>>& files);
             void Signal_OnActivatedHDUChanged(const std::optional<FileHDU>& activatedHDU);
             void Signal_OnPixelHoveredChanged(const std::optional<PixelDetails>& pixelDetails);
 
         private slots:
 
+            void Slot_ImportFiles_FileHDUsImported(const std::filesystem::path& filePath, std::size_t firstHDUIndex, const std::vector<NFITS::HDU>& hdus);
             void Slot_ImportFiles_WorkFinished(Nastro::Worker* pWorker);
 
         private:
@@ -54,6 +60,7 @@ namespace Nastro
             QWidget* m_pParent;
 
             std::unordered_map<std::filesystem::path, std::vector<NFITS::HDU>> m_importedFiles;
+            std::unordered_set<std::filesystem::path> m_importingFiles; // Files whose import is still in progress
             std::optional<FileHDU> m_activatedHDU;
             std::optional<PixelDetails> m_hoveredPixelDetails;
     };
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_BENCHMARKS_BENCHMARKS_H
+#define NFITS_BENCHMARKS_BENCHMARKS_H
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <string>
+
+namespace NFITS::Benchmarks
+{
+    struct BenchmarkResult
+    {
+        std::size_t numItems{0};                // Number of items (cards, values, etc.) processed
+        std::size_t numBytes{0};                // Number of input bytes processed, if relevant
+        std::chrono::nanoseconds duration{0};
+    };
+
+    /**
+     * Prints the average time taken, and throughput, per item processed by a benchmark
+     */
+    inline void PrintResult(const std::string& name, const std::string& itemName, const BenchmarkResult& result)
+    {
+        const auto nsPerItem = static_cast<double>(result.duration.count()) / static_cast<double>(result.numItems);
+        const auto itemsPerSecond = 1e9 / nsPerItem;
+
+        auto line = std::format("{:<40} {:>12} {}s {:>10.2f} ns/{} {:>14.0f} {}s/s",
+                                name, result.numItems, itemName, nsPerItem, itemName, itemsPerSecond, itemName);
+
+        if (result.numBytes != 0)
+        {
+            const auto seconds = static_cast<double>(result.duration.count()) / 1e9;
+            line += std::format(" {:>8.2f} GiB/s", (static_cast<double>(result.numBytes) / seconds) / (1024.0 * 1024.0 * 1024.0));
+        }
+
+        std::cout << line << std::endl;
+    }
+
+    void RunParsingBenchmarks(std::size_t numIterations);
+    void RunImageKernelBenchmarks(std::size_t numIterations);
+}
+
+#endif //NFITS_BENCHMARKS_BENCHMARKS_H
@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "Benchmarks.h"
+
+#include <Image/ImageKernels.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+//
+// Microbenchmarks of the image value decode kernels. Each benchmark decodes a large buffer of big endian
+// image values repeatedly, and reports the average time taken per value and the input bandwidth achieved.
+// A plain memcpy of the same buffer is included as a reference for the machine's memory bandwidth.
+//
+
+namespace NFITS::Benchmarks
+{
+
+static constexpr std::size_t SRC_BYTE_SIZE = 64U * 1024U * 1024U;
+
+static BenchmarkResult RunBenchmark(std::size_t numIterations, std::size_t numValues, const std::function<void()>& decodeFunc)
+{
+    // Warm up, so that the output is paged in before timing starts
+    decodeFunc();
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for (std::size_t x = 0; x < numIterations; ++x)
+    {
+        decodeFunc();
+    }
+
+    const auto endTime = std::chrono::steady_clock::now();
+
+    return BenchmarkResult{
+        .numItems = numIterations * numValues,
+        .numBytes = numIterations * SRC_BYTE_SIZE,
+        .duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime)
+    };
+}
+
+template <typename T>
+static void RunDecodeBenchmarks(const std::string& typeName,
+                                int64_t bitpix,
+                                const std::vector<std::byte>& src,
+                                std::size_t numIterations)
+{
+    const auto numValues = src.size() / sizeof(T);
+
+    std::vector<T> rawValues(numValues);
+    std::vector<float> floatValues(numValues);
+    std::vector<double> doubleValues(numValues);
+
+    const auto transform = PhysicalValueTransform{.zero = 32768.0, .scale = 0.5, .blank = -1};
+
+    PrintResult(std::format("DecodeBigEndianValues<{}>", typeName), "value",
+        RunBenchmark(numIterations, numValues, [&](){
+            DecodeBigEndianValues(src, std::span<T>(rawValues));
+        })
+    );
+
+    PrintResult(std::format("DecodeToPhysicalValues<{}, float>", typeName), "value",
+        RunBenchmark(numIterations, numValues, [&](){
+            (void)DecodeBigEndianToPhysicalValues(src, bitpix, transform, std::span<float>(floatValues));
+        })
+    );
+
+    PrintResult(std::format("DecodeToPhysicalValues<{}, double>", typeName), "value",
+        RunBenchmark(numIterations, numValues, [&](){
+            (void)DecodeBigEndianToPhysicalValues(src, bitpix, transform, std::span<double>(doubleValues));
+        })
+    );
+}
+
+void RunImageKernelBenchmarks(std::size_t numIterations)
+{
+    std::vector<std::byte> src(SRC_BYTE_SIZE);
+    for (std::size_t x = 0; x < src.size(); ++x)
+    {
+        src[x] = static_cast<std::byte>((x * 37U) % 251U);
+    }
+
+    std::vector<std::byte> dst(SRC_BYTE_SIZE);
+
+    PrintResult("memcpy (reference)", "byte",
+        RunBenchmark(numIterations, SRC_BYTE_SIZE, [&](){
+            std::memcpy(dst.data(), src.data(), src.size());
+        })
+    );
+
+    RunDecodeBenchmarks<int16_t>("int16", 16, src, numIterations);
+    RunDecodeBenchmarks<int32_t>("int32", 32, src, numIterations);
+    RunDecodeBenchmarks<float>("float", -32, src, numIterations);
+    RunDecodeBenchmarks<double>("double", -64, src, numIterations);
+}
+
+}
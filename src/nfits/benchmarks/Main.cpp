@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+//
+// Usage: libNFITSBenchmarks [numIterations]
+//
+// numIterations scales how long every benchmark runs for
+//
+
+static constexpr std::size_t DEFAULT_NUM_ITERATIONS = 200000;
+
+// Number of iterations of the parsing benchmarks per pass over the image data of the image kernel benchmarks
+static constexpr std::size_t ITERATIONS_PER_IMAGE_PASS = 20000;
+
+int main(int argc, char** argv)
+{
+    std::size_t numIterations = DEFAULT_NUM_ITERATIONS;
+
+    if (argc > 1)
+    {
+        numIterations = std::strtoull(argv[1], nullptr, 10);
+        if (numIterations == 0)
+        {
+            std::cerr << "Usage: libNFITSBenchmarks [numIterations]" << std::endl;
+            return 1;
+        }
+    }
+
+    NFITS::Benchmarks::RunParsingBenchmarks(numIterations);
+    NFITS::Benchmarks::RunImageKernelBenchmarks(std::max<std::size_t>(1U, numIterations / ITERATIONS_PER_IMAGE_PASS));
+
+    return 0;
+}
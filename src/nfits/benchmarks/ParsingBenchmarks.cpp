@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "Benchmarks.h"
+
+#include <Parsing.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//
+// Microbenchmarks of keyword value parsing. Each benchmark parses a set of keyword records repeatedly, and
+// reports the average time taken, and throughput, per parsed record (card).
+//
+
+namespace NFITS::Benchmarks
+{
+
+static const std::vector<std::string> INTEGER_RECORDS = {
+    "BITPIX  =                  -32 / array data type                                ",
+    "NAXIS1  =                 4096 / length of data axis 1                          ",
+    "NAXIS2  =                 4096 / length of data axis 2                          ",
+    "BLANK   =          -2147483648                                                  ",
+    "EXPTIME =                 +300                                                  ",
+    "BIGVALUE=  1234567890123456789                                                  ",
+};
+
+static const std::vector<std::string> REAL_RECORDS = {
+    "BSCALE  =                  1.0                                                  ",
+    "BZERO   =              32768.0                                                  ",
+    "CRVAL1  =        2.8988638E+02 / RA at reference pixel                          ",
+    "CRVAL2  =       -1.2345678E-01 / DEC at reference pixel                         ",
+    "CDELT1  =   -2.777777777778D-04                                                 ",
+    "EQUINOX =               2000.0                                                  ",
+    "AIRMASS =              +1.0234                                                  ",
+};
+
+template <typename T>
+static BenchmarkResult RunBenchmark(const std::vector<std::string>& records,
+                                    std::size_t numIterations,
+                                    const std::function<std::expected<T, Error>(KeywordRecordCSpan)>& parseFunc)
+{
+    // Accumulates the parsed values so that the parsing can't be optimized away
+    T sink{};
+    std::size_t numFailed = 0;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for (std::size_t x = 0; x < numIterations; ++x)
+    {
+        for (const auto& record : records)
+        {
+            const auto value = parseFunc(KeywordRecordCSpan(record));
+            if (value) { sink += *value; } else { ++numFailed; }
+        }
+    }
+
+    const auto endTime = std::chrono::steady_clock::now();
+
+    if (numFailed != 0)
+    {
+        std::cerr << std::format("Failed to parse {} records", numFailed) << std::endl;
+        std::exit(1);
+    }
+
+    volatile T result = sink;
+    (void)result;
+
+    return BenchmarkResult{
+        .numItems = numIterations * records.size(),
+        .duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime)
+    };
+}
+
+void RunParsingBenchmarks(std::size_t numIterations)
+{
+    PrintResult("ParseKeywordValue_AsInteger", "card", RunBenchmark<int64_t>(INTEGER_RECORDS, numIterations, ParseKeywordValue_AsInteger));
+    PrintResult("ParseKeywordValue_AsReal", "card", RunBenchmark<double>(REAL_RECORDS, numIterations, ParseKeywordValue_AsReal));
+}
+
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_CACHINGFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_CACHINGFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "FITSByteCache.h"
+#include "SharedLib.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace NFITS
+{
+    /**
+     * IFITSByteSource decorator which serves reads of a wrapped source from a FITSByteCache, only reading
+     * from the wrapped source on cache misses.
+     *
+     * Writes are passed through to the wrapped source and invalidate any cached bytes they overlap. Reads which
+     * span at least READ_CHUNK_BYTE_SIZE worth of cache pages bypass the cache, so that streaming a large HDU's
+     * data through the source, a chunk at a time, doesn't evict everything else from the cache.
+     *
+     * Supports concurrent reads, regardless of whether the wrapped source does; reads of the wrapped source are
+     * serialized when it doesn't.
+     */
+    class NFITS_PUBLIC CachingFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            /**
+             * Create a CachingFITSByteSource instance which wraps a source
+             *
+             * @param pSource The source to be wrapped
+             * @param pCache The cache which holds the source's bytes. May be shared between multiple sources.
+             * @param cacheKey Key which identifies the source's bytes within the cache. Sources created with the same
+             * key share cached bytes, so the key must uniquely identify the source's contents, for example a file's
+             * path along with its size and modification time. If empty, a key unique to this source is used.
+             *
+             * @return A CachingFITSByteSource
+             */
+            [[nodiscard]] static std::unique_ptr<CachingFITSByteSource> Create(
+                std::unique_ptr<IFITSByteSource> pSource,
+                std::shared_ptr<FITSByteCache> pCache,
+                const std::string& cacheKey
+            );
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            CachingFITSByteSource(Tag tag, std::unique_ptr<IFITSByteSource> pSource, std::shared_ptr<FITSByteCache> pCache, uint64_t keyId);
+            ~CachingFITSByteSource() override;
+
+            CachingFITSByteSource(const CachingFITSByteSource&) = delete;
+            CachingFITSByteSource& operator=(const CachingFITSByteSource&) = delete;
+
+            [[nodiscard]] IFITSByteSource* GetWrappedSource() const noexcept { return m_pSource.get(); }
+            [[nodiscard]] const std::shared_ptr<FITSByteCache>& GetCache() const noexcept { return m_pCache; }
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_CACHING; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+            [[nodiscard]] std::optional<std::span<const std::byte>> GetBytesView(const ByteOffset& byteOffset,
+                                                                                 const ByteSize& byteSize) const override;
+            void AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint) override;
+
+        private:
+
+            [[nodiscard]] Result ReadFromSource(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const;
+
+        private:
+
+            std::unique_ptr<IFITSByteSource> m_pSource;
+            std::shared_ptr<FITSByteCache> m_pCache;
+            uint64_t m_keyId;
+
+            // Serializes access to the wrapped source, if it doesn't support concurrent reads
+            mutable std::mutex m_sourceMutex;
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_CACHINGFITSBYTESOURCE_H
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_CONCURRENTDISKFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_CONCURRENTDISKFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "SharedLib.h"
+
+#include <filesystem>
+#include <memory>
+#include <expected>
+#include <mutex>
+
+namespace NFITS
+{
+    class IOUring;
+
+    /**
+     * Concrete IFITSByteSource which is backed by a filesystem file, and which reads/writes via positional
+     * (pread/pwrite style) calls rather than via a shared stream position.
+     *
+     * Supports concurrent reads, so one instance can serve multiple threads loading data from the same file.
+     *
+     * On non-Windows platforms, vectored reads are performed with preadv, scattering each coalesced group of
+     * ranges directly into their destinations.
+     *
+     * On Linux, async reads are submitted to an io_uring, so that many of them can be in flight at once without
+     * a thread blocked on each; elsewhere, or if io_uring isn't available, they're serviced by the IO thread pool.
+     */
+    class NFITS_PUBLIC ConcurrentDiskFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            enum class Access
+            {
+                ReadOnly,
+                ReadWrite
+            };
+
+            /**
+             * Create a ConcurrentDiskFITSByteSource instance by opening a filesystem file
+             *
+             * @param filePath The file to be opened
+             * @param access Whether the file is opened for reading, or for reading and writing
+             * @param createIfNotExists Whether to create the file if it doesn't already exist. Only
+             * applicable for ReadWrite access.
+             *
+             * @return A ConcurrentDiskFITSByteSource, or an Error on error
+             */
+            [[nodiscard]] static std::expected<std::unique_ptr<ConcurrentDiskFITSByteSource>, Error> Open(
+                const std::filesystem::path& filePath,
+                Access access,
+                bool createIfNotExists
+            );
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            ConcurrentDiskFITSByteSource(Tag tag, std::filesystem::path filePath, Access access);
+            ~ConcurrentDiskFITSByteSource() override;
+
+            ConcurrentDiskFITSByteSource(const ConcurrentDiskFITSByteSource&) = delete;
+            ConcurrentDiskFITSByteSource& operator=(const ConcurrentDiskFITSByteSource&) = delete;
+
+            [[nodiscard]] std::filesystem::path GetFilesystemPath() const noexcept { return m_filePath; }
+
+            /**
+             * Copy a range of this source's bytes to the same range of another disk source, without the bytes
+             * passing through user space where the platform allows it (copy_file_range, or sendfile, on Linux).
+             * Falls back to buffered reads and writes otherwise.
+             *
+             * @param dst The source to copy bytes to. Must have been opened ReadWrite, and already be large
+             * enough to hold the range.
+             * @param byteOffset Byte offset, within both sources, of the range to copy
+             * @param byteSize Number of bytes to copy
+             *
+             * @return Whether all bytes were copied successfully
+             */
+            Result CopyBytesTo(ConcurrentDiskFITSByteSource& dst, const ByteOffset& byteOffset, const ByteSize& byteSize);
+
+            /**
+             * Waits for the file's written bytes to reach the disk (fsync, or FlushFileBuffers on Windows). Note
+             * that Flush() is a no-op, as writes aren't buffered in user space; this is only needed for durability.
+             *
+             * @return Whether the file was synced successfully
+             */
+            Result SyncToDisk();
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_CONCURRENT_DISK; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result ReadBytesV(std::span<const ReadRequest> requests) override;
+            [[nodiscard]] std::future<Result> ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+
+        private:
+
+            [[nodiscard]] Result CopyBytesToBuffered(ConcurrentDiskFITSByteSource& dst, const ByteOffset& byteOffset, const ByteSize& byteSize);
+
+            [[nodiscard]] Result OpenFile(bool createIfNotExists);
+            void CloseFile();
+
+        private:
+
+            std::filesystem::path m_filePath;
+            Access m_access;
+
+        #if defined(_WIN32)
+            void* m_hFile{nullptr};
+        #else
+            int m_fd{-1};
+        #endif
+
+            // Backend for async reads, created on first use
+            std::once_flag m_ioUringOnceFlag;
+            std::unique_ptr<IOUring> m_pIOUring;
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_CONCURRENTDISKFITSBYTESOURCE_H
@@ -9,6 +9,7 @@
 
 #include "Data.h"
 
+#include "../Bytes.h"
 #include "../Error.h"
 
 #include <expected>
@@ -59,13 +60,22 @@ namespace NFITS
         BinFieldForm form;
     };
 
+    struct BinTableLoadParams
+    {
+        // Whether the table's heap is read into memory. If not, the loaded data's heap bytes are empty, and
+        // the heap's location within the file can be used to read only the heap entries which are needed.
+        bool loadHeap{true};
+    };
+
     class BinTableData : public Data
     {
         public:
 
             BinTableData(std::vector<BinField> fields,
                          std::vector<BinTableRowBytes> rowBytes,
-                         BinTableHeapBytes heapBytes);
+                         BinTableHeapBytes heapBytes,
+                         const ByteOffset& heapSourceByteOffset,
+                         const ByteSize& heapSourceByteSize);
 
             [[nodiscard]] const std::vector<BinField>& GetFields() const noexcept { return m_fields; }
             [[nodiscard]] std::optional<std::pair<uintmax_t, BinField>> GetFieldByName(const std::string& fieldName) const;
@@ -80,6 +90,11 @@ namespace NFITS
 
             [[nodiscard]] const BinTableHeapBytes& GetHeapBytes() const noexcept { return m_heapBytes; }
 
+            /** @return The byte offset of the table's heap within the file's byte source */
+            [[nodiscard]] ByteOffset GetHeapSourceByteOffset() const noexcept { return m_heapSourceByteOffset; }
+            /** @return The byte size of the table's heap within the file's byte source, whether it was loaded or not */
+            [[nodiscard]] ByteSize GetHeapSourceByteSize() const noexcept { return m_heapSourceByteSize; }
+
             //
             // Data
             //
@@ -90,10 +105,12 @@ namespace NFITS
             std::vector<BinField> m_fields;
             std::vector<BinTableRowBytes> m_rowBytes;
             BinTableHeapBytes m_heapBytes;
+            ByteOffset m_heapSourceByteOffset;
+            ByteSize m_heapSourceByteSize;
     };
 
     [[nodiscard]] NFITS_PUBLIC std::expected<std::unique_ptr<BinTableData>, Error>
-        LoadBinTableDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU);
+        LoadBinTableDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU, const BinTableLoadParams& params = {});
 }
 
 #endif //NFITS_INCLUDE_NFITS_DATA_BINTABLEDATA_H
@@ -30,7 +30,7 @@ namespace NFITS
      * Loads a compressed image from a bintable HDU
      */
     [[nodiscard]] NFITS_PUBLIC std::expected<std::unique_ptr<BinTableImageData>, Error>
-        LoadBinTableImageDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU);
+        LoadBinTableImageDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU, const ImageLoadParams& params = {});
 }
 
 #endif //NFITS_INCLUDE_NFITS_DATA_BINTABLEIMAGEDATA_H
@@ -8,19 +8,58 @@
 #define NFITS_INCLUDE_NFITS_DATA_DATAUTIL_H
 
 #include "Data.h"
+#include "ImageData.h"
 
 #include "../SharedLib.h"
 #include "../Error.h"
 
+#include <cstddef>
 #include <expected>
 #include <memory>
+#include <vector>
 
 namespace NFITS
 {
     class FITSFile;
     struct HDU;
 
-    [[nodiscard]] NFITS_PUBLIC std::expected<std::unique_ptr<Data>, Error> LoadHDUDataBlocking(const FITSFile* pFile, const HDU* pHDU);
+    /**
+     * Loads the data of an HDU which contains any type of image data
+     *
+     * @param imageParams Parameters which control how image data is loaded
+     */
+    [[nodiscard]] NFITS_PUBLIC std::expected<std::unique_ptr<Data>, Error> LoadHDUDataBlocking(const FITSFile* pFile,
+                                                                                             const HDU* pHDU,
+                                                                                             const ImageLoadParams& imageParams = {});
+
+    // Default max number of HDUs whose data LoadHDUsDataBlocking loads at once. Each load spreads its own
+    // decoding across the compute pool, so a few loads are enough to keep both the disk and the cores busy.
+    constexpr std::size_t DEFAULT_MAX_CONCURRENT_HDU_LOADS = 4U;
+
+    /**
+     * An HDU whose data is to be loaded, and the file it's loaded from
+     */
+    struct HDUDataLoad
+    {
+        const FITSFile* pFile{nullptr};
+        const HDU* pHDU{nullptr};
+    };
+
+    /**
+     * Loads the data of multiple HDUs, as LoadHDUDataBlocking does for each. HDUs from files whose byte sources
+     * support concurrent reads are loaded in parallel, at most maxConcurrentLoads at a time; the others are
+     * loaded one at a time.
+     *
+     * @param imageParams Parameters which control how image data is loaded. Once imageParams.isCancelled
+     * returns true, no further loads are started, and the loads which weren't started fail.
+     *
+     * @return The result of each HDU's load, in the same order as loads
+     */
+    [[nodiscard]] NFITS_PUBLIC std::vector<std::expected<std::unique_ptr<Data>, Error>> LoadHDUsDataBlocking(
+        const std::vector<HDUDataLoad>& loads,
+        const ImageLoadParams& imageParams = {},
+        std::size_t maxConcurrentLoads = DEFAULT_MAX_CONCURRENT_HDU_LOADS
+    );
 }
 
 #endif //NFITS_INCLUDE_NFITS_DATA_DATAUTIL_H
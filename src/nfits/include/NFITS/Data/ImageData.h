@@ -13,6 +13,7 @@
 #include "../Error.h"
 
 #include "../Image/ImageSliceSource.h"
+#include "../Image/PhysicalValues.h"
 #include "../WCS/WCSParams.h"
 
 #include <unordered_map>
@@ -22,6 +23,7 @@
 #include <span>
 #include <memory>
 #include <expected>
+#include <functional>
 #include <string>
 
 namespace NFITS
@@ -29,6 +31,20 @@ namespace NFITS
     class FITSFile;
     struct HDU;
 
+    struct ImageLoadParams
+    {
+        // Whether image values which are stored as 32 or 64 bit values (BITPIX=32, -32, -64, and compressed
+        // images) are converted to float32 physical values as they're loaded, rather than being held as they're
+        // stored. Halves the memory of 64 bit images, and the bandwidth of every pass over scaled images, at the
+        // cost of precision which display and percentile ranging don't need. Narrower integer images are always
+        // held as they're stored, as they're already smaller.
+        bool float32PhysicalValues{false};
+
+        // Optional; polled before each chunk of image data is read and decoded. The load stops, and fails, once
+        // it returns true. May be called from multiple threads at once.
+        std::function<bool()> isCancelled{};
+    };
+
     class NFITS_PUBLIC ImageData : public Data, public ImageSliceSource
     {
         public:
@@ -36,7 +52,8 @@ namespace NFITS
             ImageData() = default;
 
             ImageData(ImageSliceSpan sliceSpan,
-                      std::vector<double> physicalValues,
+                      RawImageValues rawValues,
+                      PhysicalValueTransform transform,
                       std::vector<PhysicalStats> slicePhysicalStats,
                       std::vector<PhysicalStats> sliceCubePhysicalStats,
                       std::optional<std::string> physicalUnit,
@@ -57,6 +74,11 @@ namespace NFITS
             [[nodiscard]] ImageSliceSpan GetImageSliceSpan() const override { return m_sliceSpan; }
             [[nodiscard]] std::optional<ImageSlice> GetImageSlice(const ImageSliceKey& sliceKey) const override;
 
+            /**
+             * @return A view of all of the image's physical values, across all of its slices
+             */
+            [[nodiscard]] PhysicalValuesView GetPhysicalValues() const;
+
         private:
 
             [[nodiscard]] std::optional<uintmax_t> GetSliceIndex(const ImageSliceKey& sliceKey) const;
@@ -65,7 +87,8 @@ namespace NFITS
         private:
 
             ImageSliceSpan m_sliceSpan;
-            std::vector<double> m_physicalValues;
+            RawImageValues m_rawValues;             // The image's values, as stored in the file, in native endianness
+            PhysicalValueTransform m_transform;     // Transforms the stored values to physical values
             std::vector<PhysicalStats> m_slicePhysicalStats;
             std::vector<PhysicalStats> m_sliceCubePhysicalStats;
             std::optional<std::string> m_physicalUnit;
@@ -73,7 +96,7 @@ namespace NFITS
     };
 
     [[nodiscard]] NFITS_PUBLIC std::expected<std::unique_ptr<ImageData>, Error>
-        LoadImageDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU);
+        LoadImageDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU, const ImageLoadParams& params = {});
 }
 
 #endif //NFITS_INCLUDE_NFITS_DATA_IMAGEDATA_H
@@ -11,6 +11,7 @@
 
 #include <span>
 #include <array>
+#include <numeric>
 
 namespace NFITS
 {
@@ -20,6 +21,28 @@ namespace NFITS
     constexpr auto KEYWORD_RECORD_BYTE_SIZE = ByteSize(80U);
     constexpr auto KEYWORD_RECORDS_PER_HEADER_BLOCK = 36U;
 
+    // Number of blocks (~5.6 MiB) transferred per read when bulk reading data from a source
+    constexpr auto READ_CHUNK_BLOCK_COUNT = 2048U;
+    constexpr auto READ_CHUNK_BYTE_SIZE = BLOCK_BYTE_SIZE * READ_CHUNK_BLOCK_COUNT;
+
+    // Max gap between two ranges of a vectored read across which they're coalesced into one read; reading
+    // through a small gap is cheaper than issuing another read
+    constexpr auto READV_COALESCE_GAP_BYTE_SIZE = ByteSize(64U * 1024U);
+
+    // Alignment of the file offsets, sizes, and memory addresses of direct (unbuffered) I/O. Covers both 512 and
+    // 4096 byte sector devices.
+    constexpr auto DIRECT_IO_ALIGNMENT_BYTE_SIZE = ByteSize(4096U);
+
+    // Smallest byte size which is a whole number of both FITS blocks and direct I/O alignment units (45 blocks,
+    // 180 KiB). A range of blocks which starts at a multiple of it is also aligned for direct I/O.
+    constexpr auto DIRECT_IO_BLOCK_ALIGNED_BYTE_SIZE = ByteSize(std::lcm(BLOCK_BYTE_SIZE.value, DIRECT_IO_ALIGNMENT_BYTE_SIZE.value));
+
+    // Max number of requested bytes (~5.6 MiB) which an unaligned direct read covers; the same as
+    // READ_CHUNK_BYTE_SIZE. An unaligned read is widened out to aligned offsets, by up to one alignment unit on
+    // either side, into a bounce buffer with room for the widening, so unaligned bulk reads of data are still one
+    // direct read each. Aligned reads go straight into their destination.
+    constexpr auto DIRECT_IO_CHUNK_BYTE_SIZE = DIRECT_IO_BLOCK_ALIGNED_BYTE_SIZE * (READ_CHUNK_BYTE_SIZE.value / DIRECT_IO_BLOCK_ALIGNED_BYTE_SIZE.value);
+
     using BlockSpan = std::span<std::byte, BLOCK_BYTE_SIZE.value>;
     using BlockCSpan = std::span<const std::byte, BLOCK_BYTE_SIZE.value>;
     using BlockBytes = std::array<std::byte, BLOCK_BYTE_SIZE.value>;
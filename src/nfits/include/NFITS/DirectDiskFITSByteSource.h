@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_DIRECTDISKFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_DIRECTDISKFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "SharedLib.h"
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <memory>
+
+namespace NFITS
+{
+    /**
+     * Concrete, read-only, IFITSByteSource which is backed by a filesystem file, and which reads it with direct
+     * I/O, bypassing the OS page cache: O_DIRECT on Linux, F_NOCACHE on macOS, and FILE_FLAG_NO_BUFFERING on
+     * Windows.
+     *
+     * Intended for one-shot, streaming, reads of files larger than memory, such as batch processing of large
+     * cubes, where caching the file's pages would only evict more useful ones. Reads of small or repeated
+     * ranges, such as headers, are much slower than through the page cache; prefer ConcurrentDiskFITSByteSource
+     * for interactive use.
+     *
+     * Direct reads must be aligned to DIRECT_IO_ALIGNMENT_BYTE_SIZE in file offset, size, and memory address.
+     * FITS blocks are 2880 bytes, so reads of blocks generally aren't; unaligned reads are widened to aligned
+     * ranges, read into aligned bounce buffers, and copied out. Reads which are already aligned, into aligned
+     * memory, are read directly into their destination. The bounce buffers are owned by the source, and reused
+     * by its reads, so it holds about one per concurrent reader until it's destroyed.
+     *
+     * If the filesystem doesn't support direct I/O (e.g. O_DIRECT fails with EINVAL), the file is instead read
+     * normally and, on Linux, the pages of each read are dropped from the page cache afterwards; see IsDirect.
+     *
+     * Supports concurrent reads.
+     */
+    class NFITS_PUBLIC DirectDiskFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            /**
+             * Create a DirectDiskFITSByteSource instance by opening a filesystem file for reading
+             *
+             * @param filePath The file to be opened
+             *
+             * @return A DirectDiskFITSByteSource, or an Error on error
+             */
+            [[nodiscard]] static std::expected<std::unique_ptr<DirectDiskFITSByteSource>, Error> Open(const std::filesystem::path& filePath);
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            DirectDiskFITSByteSource(Tag tag, std::filesystem::path filePath);
+            ~DirectDiskFITSByteSource() override;
+
+            DirectDiskFITSByteSource(const DirectDiskFITSByteSource&) = delete;
+            DirectDiskFITSByteSource& operator=(const DirectDiskFITSByteSource&) = delete;
+
+            [[nodiscard]] std::filesystem::path GetFilesystemPath() const noexcept { return m_filePath; }
+
+            /**
+             * @return Whether the file is read with direct I/O, or has fallen back to normal reads because the
+             * filesystem doesn't support it
+             */
+            [[nodiscard]] bool IsDirect() const noexcept { return m_isDirect; }
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_DIRECT_DISK; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+
+        private:
+
+            struct BounceBufferPool;
+
+        private:
+
+            [[nodiscard]] Result OpenFile();
+            void CloseFile();
+
+            /**
+             * Reads from the file with one positional read call.
+             *
+             * @return The number of bytes read, which is only fewer than requested at the end of the file
+             */
+            [[nodiscard]] std::expected<std::size_t, Error> ReadAt(std::byte* pDst, uintmax_t byteOffset, std::size_t byteSize) const;
+
+            // Reads directly into dst. For direct reads, the range and dst must be aligned.
+            [[nodiscard]] Result ReadInto(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const;
+
+            // Reads the aligned range surrounding the requested range into bounce buffers, and copies it out
+            [[nodiscard]] Result ReadViaBounceBuffer(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const;
+
+        private:
+
+            std::filesystem::path m_filePath;
+            bool m_isDirect{false};
+
+            std::unique_ptr<BounceBufferPool> m_pBounceBufferPool;
+
+        #if defined(_WIN32)
+            void* m_hFile{nullptr};
+        #else
+            int m_fd{-1};
+        #endif
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_DIRECTDISKFITSBYTESOURCE_H
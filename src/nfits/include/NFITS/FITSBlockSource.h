@@ -9,16 +9,18 @@
 
 #include "Def.h"
 
+#include "IFITSByteSource.h"
 #include "Result.h"
 #include "SharedLib.h"
 
 #include <expected>
+#include <future>
 #include <memory>
+#include <optional>
+#include <span>
 
 namespace NFITS
 {
-    class IFITSByteSource;
-
     /**
      * Wrapper around an IFITSByteSource which allows for reading/writing FITS blocks
      */
@@ -35,6 +37,62 @@ namespace NFITS
             Result ReadBlock(BlockSpan dst, const uintmax_t& blockIndex);
             Result WriteBlock(BlockCSpan src, const uintmax_t& blockIndex, bool flush);
 
+            /**
+             * Reads a contiguous range of blocks with one read from the underlying byte source
+             *
+             * @param dst Destination which receives the blocks' bytes; must hold at least blockCount blocks
+             * @param blockStartIndex Index of the first block to read
+             * @param blockCount Number of blocks to read
+             *
+             * @return Whether all blocks were read successfully
+             */
+            Result ReadBlocks(std::span<std::byte> dst, const uintmax_t& blockStartIndex, const uintmax_t& blockCount);
+
+            /**
+             * Writes a contiguous range of blocks with one write to the underlying byte source
+             *
+             * @param src Source of the blocks' bytes; must hold at least blockCount blocks
+             * @param blockStartIndex Index of the first block to write
+             * @param blockCount Number of blocks to write
+             * @param flush Whether the write should be immediately flushed
+             *
+             * @return Whether all blocks were written successfully
+             */
+            Result WriteBlocks(std::span<const std::byte> src, const uintmax_t& blockStartIndex, const uintmax_t& blockCount, bool flush);
+
+            /**
+             * Reads an arbitrary, not necessarily block aligned, byte range with one read from the underlying
+             * byte source. Useful for reading regions of a HDU's data which don't start or end on a block boundary.
+             *
+             * @param dst Destination which receives the bytes; must hold at least byteSize bytes
+             * @param byteOffset Byte offset within the source of the first byte to read
+             * @param byteSize Number of bytes to read
+             *
+             * @return Whether all bytes were read successfully
+             */
+            Result ReadSpan(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize);
+
+            /**
+             * Begins reading an arbitrary byte range from the underlying byte source, without waiting for the
+             * read to finish. See IFITSByteSource::ReadBytesAsync.
+             *
+             * @return A future which receives whether all bytes were read successfully
+             */
+            [[nodiscard]] std::future<Result> ReadSpanAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize);
+
+            /**
+             * @return A zero-copy view of the specified blocks' bytes, or std::nullopt if the underlying byte
+             * source can't provide one. See IFITSByteSource::GetBytesView.
+             */
+            [[nodiscard]] std::optional<std::span<const std::byte>> GetBlocksView(const uintmax_t& blockStartIndex,
+                                                                                  const uintmax_t& blockCount) const;
+
+            /**
+             * Advises the underlying byte source of how the specified blocks are about to be accessed.
+             * See IFITSByteSource::AdviseAccess.
+             */
+            void AdviseBlocks(const uintmax_t& blockStartIndex, const uintmax_t& blockCount, ByteAccessHint hint);
+
             // Passthrough access to the underlying byte source
             [[nodiscard]] IFITSByteSource* GetByteSource() const noexcept { return m_pByteSource; }
 
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_FITSBYTECACHE_H
+#define NFITS_INCLUDE_NFITS_FITSBYTECACHE_H
+
+#include "Def.h"
+#include "SharedLib.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NFITS
+{
+    struct FITSByteCacheParams
+    {
+        // Max number of bytes the cache holds, across all of its shards
+        ByteSize byteBudget{256U * 1024U * 1024U};
+
+        // Number of FITS blocks held by each cached page
+        uintmax_t pageBlockCount{16U};
+
+        // Number of independently locked shards the cache is split into
+        std::size_t shardCount{16U};
+    };
+
+    struct FITSByteCacheStats
+    {
+        uint64_t hits{0};               // Number of page lookups which were served from the cache
+        uint64_t misses{0};             // Number of page lookups which weren't, and so were read from the source
+        uint64_t evictions{0};          // Number of pages evicted to stay within the byte budget
+        uintmax_t residentByteSize{0};  // Number of bytes currently held by the cache
+    };
+
+    /**
+     * Thread-safe, sharded, LRU cache of pages of bytes, keyed by the source the bytes belong to and the
+     * page's index within that source.
+     *
+     * Used by CachingFITSByteSource; one cache may be shared between any number of CachingFITSByteSources,
+     * which allows cached bytes to outlive the sources which read them.
+     */
+    class NFITS_PUBLIC FITSByteCache
+    {
+        public:
+
+            explicit FITSByteCache(const FITSByteCacheParams& params);
+            ~FITSByteCache();
+
+            FITSByteCache(const FITSByteCache&) = delete;
+            FITSByteCache& operator=(const FITSByteCache&) = delete;
+
+            [[nodiscard]] ByteSize GetByteBudget() const noexcept { return m_byteBudget; }
+            [[nodiscard]] ByteSize GetPageByteSize() const noexcept { return m_pageByteSize; }
+
+            [[nodiscard]] FITSByteCacheStats GetStats() const;
+
+            /**
+             * Removes all pages from the cache
+             */
+            void Clear();
+
+            /**
+             * @return A key id for the provided key. The same key always results in the same key id.
+             */
+            [[nodiscard]] uint64_t GetKeyId(const std::string& key);
+
+            /**
+             * @return A key id which is unique to the caller
+             */
+            [[nodiscard]] uint64_t GetUniqueKeyId();
+
+            /**
+             * Copies bytes from a cached page, marking the page as most recently used.
+             *
+             * @param keyId Key id of the page's source
+             * @param pageIndex Index of the page within its source
+             * @param pageByteOffset Byte offset, within the page, of the first byte to copy
+             * @param dst Destination for the copied bytes; dst.size() bytes are copied
+             *
+             * @return Whether the page was cached and all the requested bytes were copied
+             */
+            [[nodiscard]] bool ReadPage(uint64_t keyId, uintmax_t pageIndex, uintmax_t pageByteOffset, std::span<std::byte> dst);
+
+            /**
+             * @return Whether the specified page is cached. Doesn't affect the cache's LRU order. As with ReadPage,
+             * a lookup of a page which isn't cached counts as a miss, as the page is then read from its source.
+             */
+            [[nodiscard]] bool ContainsPage(uint64_t keyId, uintmax_t pageIndex);
+
+            /**
+             * Inserts, or replaces, a page in the cache, evicting least recently used pages as needed.
+             */
+            void InsertPage(uint64_t keyId, uintmax_t pageIndex, std::span<const std::byte> pageBytes);
+
+            /**
+             * Removes a specific page from the cache, if it's cached
+             */
+            void InvalidatePage(uint64_t keyId, uintmax_t pageIndex);
+
+            /**
+             * Removes all pages belonging to the specified key id from the cache
+             */
+            void InvalidateKey(uint64_t keyId);
+
+        private:
+
+            struct Shard;
+
+            [[nodiscard]] Shard& GetShard(uint64_t keyId, uintmax_t pageIndex) const;
+
+        private:
+
+            ByteSize m_byteBudget;
+            ByteSize m_pageByteSize;
+            uintmax_t m_shardByteBudget;
+
+            std::vector<std::unique_ptr<Shard>> m_shards;
+
+            std::mutex m_keysMutex;
+            std::unordered_map<std::string, uint64_t> m_keyIds;
+            uint64_t m_nextKeyId{0};
+
+            std::atomic<uint64_t> m_hits{0};
+            std::atomic<uint64_t> m_misses{0};
+            std::atomic<uint64_t> m_evictions{0};
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_FITSBYTECACHE_H
@@ -14,6 +14,9 @@
 
 #include <memory>
 #include <expected>
+#include <filesystem>
+#include <functional>
+#include <string>
 #include <vector>
 #include <optional>
 
@@ -21,6 +24,38 @@ namespace NFITS
 {
     class IFITSByteSource;
 
+    struct FITSFileOpenParams
+    {
+        // Whether HDU headers are parsed lazily. If so, opening only locates each header's END keyword and parses
+        // the few keyword records which determine its HDU's type and data size (SIMPLE/XTENSION, BITPIX, NAXISn,
+        // PCOUNT, GCOUNT). The rest of a header is parsed the first time any of its keyword records are accessed.
+        // Speeds up opening files with many HDUs, most of whose headers are never looked at.
+        bool lazyHeaders{false};
+
+        // Optional path of a sidecar file which persists the file's HDU index: each HDU's position, type, data
+        // size, and the raw bytes of its header. If the file holds an index saved with the same hduIndexKey, for
+        // a source of the same byte size, the HDUs are loaded from it rather than read from the source, and
+        // their headers are parsed as specified by lazyHeaders. Otherwise, the HDUs are read from the source
+        // and the index is then written to the file.
+        std::optional<std::filesystem::path> hduIndexFilePath{};
+
+        // Identifies the version of the source's bytes that an HDU index describes, such as the path, size, and
+        // modification time of the file the source reads from. The index is only used if its key matches.
+        std::string hduIndexKey{};
+
+        // Optional; called with each HDU, in file order, as soon as it's been read and before any following HDUs
+        // are read, so that callers can make use of a large file's first HDUs while the rest are still being read
+        std::function<void(const HDU& hdu, std::size_t hduIndex)> onHDU{};
+
+        // Optional; polled before each HDU is read. The open stops, and fails, once it returns true.
+        std::function<bool()> isCancelled{};
+
+        // Optional; the open stops, successfully, once this many HDUs have been read, and the opened file only
+        // holds the file's first maxNumHDUs HDUs. For callers which only need specific HDUs near the start of
+        // a large file. Note that an HDU index isn't written for a file which is only partially read.
+        std::optional<std::size_t> maxNumHDUs{};
+    };
+
     /**
      * Provides access to a FITS file via a provided IFITSByteSource
      */
@@ -39,6 +74,15 @@ namespace NFITS
              */
             [[nodiscard]] static std::expected<std::unique_ptr<FITSFile>, Error> OpenBlocking(std::unique_ptr<IFITSByteSource> pSource);
 
+            /**
+             * Opens a FITS file contained within the provided IFITSByteSource, as above, with the provided params.
+             * If params specifies a valid HDU index for the source, no blocks are read at all.
+             *
+             * @return A valid FITSFile, or an Error on failure to open, including if the open was cancelled
+             */
+            [[nodiscard]] static std::expected<std::unique_ptr<FITSFile>, Error> OpenBlocking(std::unique_ptr<IFITSByteSource> pSource,
+                                                                                             const FITSFileOpenParams& params);
+
         public:
 
             struct Tag{};
@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_FITSSTREAMREADER_H
+#define NFITS_INCLUDE_NFITS_FITSSTREAMREADER_H
+
+#include "Def.h"
+#include "Error.h"
+#include "HDU.h"
+#include "Result.h"
+#include "SharedLib.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <istream>
+#include <span>
+
+namespace NFITS
+{
+    /**
+     * An HDU read from a FITS stream
+     */
+    struct StreamedHDU
+    {
+        // Index of the HDU within the stream
+        uintmax_t hduIndex{0};
+
+        // Block index, within the stream, of the HDU's first header block
+        uintmax_t streamBlockStartIndex{0};
+
+        // The HDU's metadata and header. Note that the HDU is positioned as if it were the only HDU in its
+        // file, starting at block 0.
+        const HDU* pHDU{nullptr};
+    };
+
+    /**
+     * Reads bytes from a stream into dst, blocking until at least one byte is available.
+     *
+     * @return The number of bytes read, which is 0 only at the end of the stream, or an Error on failure
+     */
+    using StreamReadFunc = std::function<std::expected<std::size_t, Error>(std::span<std::byte> dst)>;
+
+    /**
+     * Called with each HDU as soon as its header has arrived, before any of its data. The StreamedHDU and
+     * everything it references is only valid until the HDU's last data chunk has been handed off.
+     *
+     * @return Whether to continue reading the stream
+     */
+    using StreamedHDUCallback = std::function<bool(const StreamedHDU& streamedHDU)>;
+
+    /**
+     * Called with consecutive chunks of an HDU's data bytes, excluding block padding, as they arrive. The
+     * chunk's bytes are only valid for the duration of the call.
+     *
+     * @param dataByteOffset Byte offset of the chunk's first byte within the HDU's data
+     *
+     * @return Whether to continue reading the stream
+     */
+    using StreamedHDUDataCallback = std::function<bool(const StreamedHDU& streamedHDU,
+                                                       uintmax_t dataByteOffset,
+                                                       std::span<const std::byte> dataBytes)>;
+
+    struct FITSStreamParams
+    {
+        // Optional; called with each HDU, in stream order, once its header has arrived
+        StreamedHDUCallback onHDU{};
+
+        // Optional; called with each chunk of each HDU's data, in stream order
+        StreamedHDUDataCallback onHDUData{};
+
+        // Max number of data bytes read from the stream at a time, and so held in memory at once, and handed to
+        // onHDUData per call. Rounded up to a whole number of blocks.
+        ByteSize dataChunkByteSize{READ_CHUNK_BYTE_SIZE};
+
+        // Max number of header blocks an HDU's header may span. Reading fails, rather than buffering header
+        // blocks without bound, if an END keyword hasn't arrived within this many blocks.
+        uintmax_t maxHeaderBlockCount{4096U};
+    };
+
+    /**
+     * Reads a FITS file from a forward-only stream, such as a pipe, socket or stdin, in a single pass. Each
+     * HDU is handed to params.onHDU as soon as its header has arrived, and its data is then handed to
+     * params.onHDUData in chunks, as it arrives, before any following HDUs are read.
+     *
+     * At most one HDU's header, and one chunk of its data, are held in memory at a time, however large the
+     * HDU's data is.
+     *
+     * @return Whether the stream was read successfully, up to its end or until a callback stopped reading.
+     * Fails if the stream ends partway through an HDU, or if an HDU's header is invalid.
+     */
+    [[nodiscard]] NFITS_PUBLIC Result ReadFITSStreamBlocking(const StreamReadFunc& readFunc, const FITSStreamParams& params);
+
+    /**
+     * Convenience overload of ReadFITSStreamBlocking which reads from a std::istream. The stream should
+     * be opened in binary mode.
+     */
+    [[nodiscard]] NFITS_PUBLIC Result ReadFITSStreamBlocking(std::istream& stream, const FITSStreamParams& params);
+}
+
+#endif //NFITS_INCLUDE_NFITS_FITSSTREAMREADER_H
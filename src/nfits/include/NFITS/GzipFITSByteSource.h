@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_GZIPFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_GZIPFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "SharedLib.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace NFITS
+{
+    struct GzipParams
+    {
+        // Min number of uncompressed bytes between seek index checkpoints. Each checkpoint holds 32KiB of
+        // decompressor state, while a read inflates, on average, half of this many bytes before reaching its
+        // first byte.
+        ByteSize checkpointSpacing{4U * 1024U * 1024U};
+
+        // Number of recently inflated spans of bytes, between consecutive checkpoints, which are kept in memory
+        // so that nearby reads don't inflate them again
+        std::size_t cachedSpanCount{4U};
+
+        // Optional path of a file which persists the seek index. If the file holds a valid index for the
+        // compressed bytes it's loaded from the file, rather than built by inflating all of them. Otherwise, the
+        // index is built and then written to the file.
+        std::optional<std::filesystem::path> indexFilePath{};
+    };
+
+    /**
+     * Concrete, read-only, IFITSByteSource which provides the uncompressed bytes of a gzip-compressed FITS
+     * file, such as a .fits.gz file, read from a wrapped source of its compressed bytes.
+     *
+     * When created, all of the compressed bytes are inflated once, in a single pass, to build a seek index of
+     * checkpoints, each of which holds the state needed to resume inflating from its position. Reads then
+     * inflate from the nearest checkpoint before their bytes, rather than from the start of the file. The index
+     * can be persisted, so that later opens of the same file skip the initial pass entirely.
+     *
+     * Files with multiple concatenated gzip members are supported.
+     *
+     * Supports concurrent reads, regardless of whether the wrapped source does; reads of the wrapped source are
+     * serialized when it doesn't.
+     */
+    class NFITS_PUBLIC GzipFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            /**
+             * Create a GzipFITSByteSource instance which inflates a source of gzip-compressed bytes
+             *
+             * @param pCompressedSource Source of the compressed bytes
+             * @param params Parameters which control the seek index and caching of inflated bytes
+             *
+             * @return A GzipFITSByteSource, or an Error if the bytes aren't valid gzip data
+             */
+            [[nodiscard]] static std::expected<std::unique_ptr<GzipFITSByteSource>, Error> Create(
+                std::unique_ptr<IFITSByteSource> pCompressedSource,
+                const GzipParams& params = {}
+            );
+
+            /**
+             * @return Whether the bytes start with the gzip magic number
+             */
+            [[nodiscard]] static bool IsGzipData(std::span<const std::byte> bytes);
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            struct Checkpoint
+            {
+                uintmax_t uncompressedOffset{0};    // Offset of the first uncompressed byte following the checkpoint
+                uintmax_t compressedOffset{0};      // Offset of the first compressed byte not fully consumed
+                uint8_t bits{0};                    // Number of bits of the previous compressed byte not yet consumed
+                std::vector<std::byte> window;      // Up to 32KiB of uncompressed bytes preceding the checkpoint
+            };
+
+            struct SeekIndex
+            {
+                uintmax_t compressedByteSize{0};
+                uintmax_t uncompressedByteSize{0};
+                std::array<std::byte, 8> compressedTrailer{};   // Last 8 compressed bytes; the final member's CRC32 and ISIZE
+                std::vector<Checkpoint> checkpoints;
+            };
+
+        public:
+
+            GzipFITSByteSource(Tag tag, std::unique_ptr<IFITSByteSource> pCompressedSource, const GzipParams& params, SeekIndex seekIndex);
+            ~GzipFITSByteSource() override;
+
+            GzipFITSByteSource(const GzipFITSByteSource&) = delete;
+            GzipFITSByteSource& operator=(const GzipFITSByteSource&) = delete;
+
+            [[nodiscard]] IFITSByteSource* GetWrappedSource() const noexcept { return m_pSource.get(); }
+            [[nodiscard]] std::size_t GetNumCheckpoints() const noexcept { return m_seekIndex.checkpoints.size(); }
+
+            /**
+             * Writes the source's seek index to a file, which can later be provided via GzipParams::indexFilePath
+             *
+             * @return Whether the index was written successfully
+             */
+            [[nodiscard]] Result SaveIndex(const std::filesystem::path& indexFilePath) const;
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_GZIP; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+
+        private:
+
+            using Span = std::shared_ptr<const std::vector<std::byte>>;
+
+        private:
+
+            [[nodiscard]] std::expected<Span, Error> GetSpan(std::size_t checkpointIndex);
+            [[nodiscard]] std::expected<Span, Error> InflateSpan(std::size_t checkpointIndex) const;
+
+            [[nodiscard]] Result ReadFromSource(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const;
+
+        private:
+
+            std::unique_ptr<IFITSByteSource> m_pSource;
+            GzipParams m_params;
+            SeekIndex m_seekIndex;
+
+            // Serializes access to the wrapped source, if it doesn't support concurrent reads
+            mutable std::mutex m_sourceMutex;
+
+            // Recently inflated spans, keyed by the index of the checkpoint they start at, least recently used first
+            std::mutex m_spansMutex;
+            std::vector<std::pair<std::size_t, Span>> m_spans;
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_GZIPFITSBYTESOURCE_H
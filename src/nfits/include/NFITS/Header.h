@@ -10,19 +10,69 @@
 #include "HeaderBlock.h"
 #include "SharedLib.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
 #include <vector>
 #include <optional>
 
 namespace NFITS
 {
     /**
-     * Contains the data for all header blocks related to a particular HDU
+     * Contains the data for all header blocks related to a particular HDU.
+     *
+     * When a Header's blocks are parsed, an index of its keyword records by keyword name is built, so that
+     * looking up keyword records by name, or name prefix, doesn't scan the whole header. The values of the
+     * first keyword records with each name are parsed once, the first time any value is requested via the
+     * GetFirstKeywordRecord_As* methods, rather than on every request.
+     *
+     * A Header is either created from already parsed header blocks, or lazily from the raw bytes of its header
+     * blocks, in which case the bytes are only parsed into header blocks the first time any of its keyword
+     * records are accessed. Parsing is thread safe, and copies of a Header share both its raw bytes and parsed
+     * header blocks.
      */
     struct NFITS_PUBLIC Header
     {
+        Header() = default;
+        explicit Header(std::vector<HeaderBlock> headerBlocks);
+
+        /**
+         * Create a Header which lazily parses its header blocks from raw bytes
+         *
+         * @param pRawBytes The raw bytes of the header's blocks. Must be a whole number of blocks.
+         *
+         * @return The Header
+         */
+        [[nodiscard]] static Header FromRawBytes(std::shared_ptr<const std::vector<std::byte>> pRawBytes);
+
+        /**
+         * @return The header blocks that define this Header. Parses the header's raw bytes if they haven't
+         * been parsed yet.
+         */
+        [[nodiscard]] const std::vector<HeaderBlock>& GetHeaderBlocks() const;
+
+        /**
+         * @return The number of header blocks that define this Header. Never requires parsing.
+         */
+        [[nodiscard]] std::size_t GetNumHeaderBlocks() const noexcept;
+
+        /**
+         * @return Whether the header's blocks have been parsed; always true for a Header created from parsed
+         * header blocks
+         */
+        [[nodiscard]] bool IsParsed() const noexcept;
+
+        /**
+         * @return The raw bytes of the header's blocks, as they appear in the FITS file. Never requires parsing;
+         * a Header whose blocks haven't been parsed yet returns its raw bytes as-is.
+         */
+        [[nodiscard]] std::vector<std::byte> GetRawBytes() const;
+
         /**
-         * Helper method which looks through all header blocks and returns the first KeywordRecord it finds matching
-         * the provided keyword name.
+         * Helper method which returns the first KeywordRecord, across all header blocks, matching the provided
+         * keyword name.
          *
          * @param keywordName The keyword name to search for
          *
@@ -30,20 +80,36 @@ namespace NFITS
          */
         [[nodiscard]] std::optional<KeywordRecord> GetFirstKeywordRecord(const std::string& keywordName) const;
 
+        /**
+         * @return All KeywordRecords, in header order, whose keyword names start with the provided prefix
+         */
         [[nodiscard]] std::vector<KeywordRecord> GetKeywordsStartingWith(const std::string& keywordNamePrefix) const;
 
         //
-        // Helper methods which look through all header blocks and returns the first KeywordRecord it finds matching
-        // the provided keyword name, interpreted as the specified type.
+        // Helper methods which return the first KeywordRecord, across all header blocks, matching the provided
+        // keyword name, interpreted as the specified type.
         [[nodiscard]] std::expected<int64_t, Error> GetFirstKeywordRecord_AsInteger(const std::string& keywordName) const;
         [[nodiscard]] std::expected<double, Error> GetFirstKeywordRecord_AsReal(const std::string& keywordName) const;
         [[nodiscard]] std::expected<bool, Error> GetFirstKeywordRecord_AsLogical(const std::string& keywordName) const;
         [[nodiscard]] std::expected<std::string, Error> GetFirstKeywordRecord_AsString(const std::string& keywordName) const;
 
-        /**
-         * The header blocks that define this Header
-         */
-        std::vector<HeaderBlock> headerBlocks;
+        private:
+
+            struct State;
+
+            using KeywordValue = std::variant<std::monostate, int64_t, double, bool, std::string>;
+
+            [[nodiscard]] const State* GetParsedState() const;
+
+            /**
+             * @return The parsed value of the first keyword record with the provided name, or nullptr if no such
+             * keyword record exists
+             */
+            [[nodiscard]] const KeywordValue* GetFirstKeywordValue(const std::string& keywordName) const;
+
+        private:
+
+            std::shared_ptr<State> m_pState;
     };
 }
 
@@ -15,14 +15,49 @@
 #include <cstdint>
 #include <span>
 #include <expected>
+#include <future>
+#include <optional>
 
 namespace NFITS
 {
     static constexpr unsigned int BYTE_SOURCE_TYPE_DISK = 0U;
     static constexpr unsigned int BYTE_SOURCE_TYPE_MEMORY = 1U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_MAPPED = 2U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_CONCURRENT_DISK = 3U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_CACHING = 4U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_READ_AHEAD = 5U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_INSTRUMENTED = 6U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_SPAN = 7U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_GZIP = 8U;
+    static constexpr unsigned int BYTE_SOURCE_TYPE_DIRECT_DISK = 9U;
+
+    /**
+     * Hint describing how a range of a source's bytes is about to be accessed
+     */
+    enum class ByteAccessHint
+    {
+        Normal,     // No particular access pattern
+        Sequential, // Bytes will be accessed once, in increasing offset order
+        Random,     // Bytes will be accessed in no particular order
+        WillNeed    // Bytes will be accessed soon
+    };
+
+    /**
+     * One byte range of a vectored read. See IFITSByteSource::ReadBytesV.
+     */
+    struct ReadRequest
+    {
+        std::span<std::byte> dst;   // Destination which receives the range's bytes
+        ByteOffset byteOffset;      // Byte offset within the source of the range
+        ByteSize byteSize;          // Number of bytes in the range
+    };
 
     /**
      * Interface for writing/reading bytes to/from a FITS source
+     *
+     * Thread safety: Unless a source's SupportsConcurrentReads() returns true, all calls into it must be externally
+     * synchronized. If it does return true, any number of threads may concurrently call GetByteSize, ReadBytes,
+     * GetBytesView and AdviseAccess. Resize, WriteBytes and Flush always require exclusive access to the source.
      */
     class NFITS_PUBLIC IFITSByteSource
     {
@@ -60,6 +95,39 @@ namespace NFITS
              */
             virtual Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) = 0;
 
+            /**
+             * Read many, possibly disjoint, byte ranges from the FITS source with one call.
+             *
+             * Requests may be provided in any order. Ranges which are adjacent, or separated by small gaps, are
+             * read together rather than each with its own read. The default implementation copies ranges out of
+             * GetBytesView when possible, and otherwise reads each coalesced group of ranges with one ReadBytes.
+             *
+             * @param requests The byte ranges to read, and the destinations which receive their bytes
+             *
+             * @return Whether all ranges were read successfully
+             */
+            virtual Result ReadBytesV(std::span<const ReadRequest> requests);
+
+            /**
+             * Begin reading bytes from the FITS source, without waiting for the read to finish.
+             *
+             * Any number of async reads may be in flight at once, allowing sources backed by storage which
+             * services requests in parallel to be read at a queue depth greater than one.
+             *
+             * The default implementation performs the read on a shared pool of IO threads for sources which
+             * support concurrent reads, and performs it synchronously, before returning, for sources which don't.
+             *
+             * dst must remain valid, and the source must not be destroyed, until the returned future is ready.
+             * Reads in flight count as concurrent reads of the source; see the class's thread safety notes.
+             *
+             * @param dst Destination which receives the read bytes
+             * @param byteOffset Byte offset within the source to read from
+             * @param byteSize Number of bytes to read from the source and write to dst
+             *
+             * @return A future which receives whether all bytes were read successfully
+             */
+            [[nodiscard]] virtual std::future<Result> ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize);
+
             /**
              * Write bytes to the FITS source
              *
@@ -78,6 +146,37 @@ namespace NFITS
              * @return Whether the flush was successful
              */
             virtual Result Flush() = 0;
+
+            /**
+             * @return Whether the source allows for concurrent reads from multiple threads. See the class
+             * documentation for the specific calls this covers.
+             */
+            [[nodiscard]] virtual bool SupportsConcurrentReads() const { return false; }
+
+            /**
+             * Provides direct, zero-copy, access to bytes of the source, for sources which hold their bytes in
+             * addressable memory. The returned view is borrowed from the source and is only valid until the source
+             * is resized or destroyed.
+             *
+             * The default implementation returns std::nullopt; callers should fall back to ReadBytes in that case.
+             *
+             * @param byteOffset Byte offset within the source of the first byte to view
+             * @param byteSize Number of bytes to view
+             *
+             * @return A view of the requested bytes, or std::nullopt if the source can't provide one
+             */
+            [[nodiscard]] virtual std::optional<std::span<const std::byte>> GetBytesView(const ByteOffset& byteOffset,
+                                                                                         const ByteSize& byteSize) const;
+
+            /**
+             * Advises the source of how a range of its bytes is about to be accessed, allowing it to prepare
+             * for the access. Purely a hint; the default implementation ignores it.
+             *
+             * @param byteOffset Byte offset within the source of the first byte of the range
+             * @param byteSize Number of bytes in the range
+             * @param hint How the range will be accessed
+             */
+            virtual void AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint);
     };
 }
 
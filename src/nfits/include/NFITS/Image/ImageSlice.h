@@ -9,6 +9,7 @@
 
 #include "ImageCommon.h"
 #include "PhysicalStats.h"
+#include "PhysicalValues.h"
 
 #include "../Error.h"
 #include "../SharedLib.h"
@@ -51,7 +52,8 @@ namespace NFITS
     /**
      * Contains the data relevant to a specific 2D slice of a N-dimensional image.
      *
-     * Non-owning; only references the physical values from the owning ImageData.
+     * Non-owning; only references the values from the owning ImageData, which derives physical values from
+     * them as they're accessed.
      */
     struct ImageSlice
     {
@@ -59,7 +61,7 @@ namespace NFITS
         uint64_t height{0};
         PhysicalStats physicalStats{};              // Physical stats compiled from the specific image slice
         PhysicalStats cubePhysicalStats{};          // Physical stats compiled from the slice cube the slice is contained within
-        std::span<const double> physicalValues;     // Physical values for the image slice
+        PhysicalValuesView physicalValues;          // Physical values for the image slice
         std::optional<std::string> physicalUnit;    // Optional string describing the physical values unit
         std::optional<WCSParams> wcsParams;         // Optional parameters for WCS transformation
     };
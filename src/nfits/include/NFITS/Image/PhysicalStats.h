@@ -7,11 +7,12 @@
 #ifndef NFITS_INCLUDE_NFITS_IMAGE_PHYSICALSTATS_H
 #define NFITS_INCLUDE_NFITS_IMAGE_PHYSICALSTATS_H
 
+#include "PhysicalValues.h"
+
 #include <NFITS/SharedLib.h>
 
 #include <vector>
 #include <utility>
-#include <span>
 
 namespace NFITS
 {
@@ -39,7 +40,7 @@ namespace NFITS
     /**
      * Takes in image physical values and returns PhysicalStats calculated from those values
      */
-    [[nodiscard]] NFITS_PUBLIC PhysicalStats CompilePhysicalStats(const std::vector<std::span<const double>>& values);
+    [[nodiscard]] NFITS_PUBLIC PhysicalStats CompilePhysicalStats(const std::vector<PhysicalValuesView>& values);
 }
 
 #endif //NFITS_INCLUDE_NFITS_IMAGE_PHYSICALSTATS_H
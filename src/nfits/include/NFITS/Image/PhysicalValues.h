@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_IMAGE_PHYSICALVALUES_H
+#define NFITS_INCLUDE_NFITS_IMAGE_PHYSICALVALUES_H
+
+#include "../SharedLib.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace NFITS
+{
+    /**
+     * Owning storage of an image's raw values, as they're stored in the file (per BITPIX), but in native
+     * endianness. Physical values are only derived from them when accessed, via a PhysicalValueTransform.
+     */
+    using RawImageValues = std::variant<
+        std::vector<uint8_t>,
+        std::vector<int16_t>,
+        std::vector<int32_t>,
+        std::vector<float>,
+        std::vector<double>
+    >;
+
+    /**
+     * The transform which maps an image's raw values to physical values: zero + (scale * value).
+     *
+     * Integral raw values which match the optional blank value are undefined, and are mapped to NaN.
+     */
+    struct PhysicalValueTransform
+    {
+        double zero{0.0};
+        double scale{1.0};
+        std::optional<int64_t> blank{};
+
+        template <typename T>
+        [[nodiscard]] double Apply(T rawValue) const noexcept
+        {
+            if constexpr (std::integral<T>)
+            {
+                if (blank && (static_cast<int64_t>(rawValue) == *blank))
+                {
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+
+            return zero + (scale * static_cast<double>(rawValue));
+        }
+    };
+
+    /**
+     * Non-owning view of a sequence of an image's physical values.
+     *
+     * References the image's raw values, of whichever type they're stored as, and applies the image's
+     * PhysicalValueTransform to each value as it's accessed. Use Visit to process the raw values in bulk,
+     * without paying for a type dispatch per value.
+     */
+    class NFITS_PUBLIC PhysicalValuesView
+    {
+        public:
+
+            using RawValuesSpan = std::variant<
+                std::span<const uint8_t>,
+                std::span<const int16_t>,
+                std::span<const int32_t>,
+                std::span<const float>,
+                std::span<const double>
+            >;
+
+            /**
+             * Iterates over the view's physical values, by value
+             */
+            class Iterator
+            {
+                public:
+
+                    using iterator_concept = std::forward_iterator_tag;
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = double;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = void;
+                    using reference = double;
+
+                    Iterator() = default;
+                    Iterator(const PhysicalValuesView* pView, std::size_t index) : m_pView(pView), m_index(index) {}
+
+                    [[nodiscard]] double operator*() const { return (*m_pView)[m_index]; }
+
+                    Iterator& operator++() { ++m_index; return *this; }
+                    Iterator operator++(int) { auto it = *this; ++m_index; return it; }
+
+                    [[nodiscard]] bool operator==(const Iterator&) const = default;
+
+                private:
+
+                    const PhysicalValuesView* m_pView{nullptr};
+                    std::size_t m_index{0};
+            };
+
+        public:
+
+            PhysicalValuesView() = default;
+
+            PhysicalValuesView(RawValuesSpan rawValues, PhysicalValueTransform transform);
+
+            /**
+             * Views physical values which are already stored as doubles, with an identity transform
+             */
+            explicit PhysicalValuesView(std::span<const double> physicalValues);
+
+            /**
+             * Views all of the raw values held by a RawImageValues
+             */
+            PhysicalValuesView(const RawImageValues& rawValues, PhysicalValueTransform transform);
+
+            [[nodiscard]] std::size_t size() const noexcept;
+            [[nodiscard]] bool empty() const noexcept { return size() == 0U; }
+
+            /**
+             * @return The physical value at the specified index. Not bounds checked.
+             */
+            [[nodiscard]] double operator[](std::size_t index) const;
+
+            [[nodiscard]] Iterator begin() const { return {this, 0U}; }
+            [[nodiscard]] Iterator end() const { return {this, size()}; }
+
+            /**
+             * @return A view of a sub-range of this view's values, which shares its transform
+             */
+            [[nodiscard]] PhysicalValuesView subspan(std::size_t offset, std::size_t count) const;
+
+            /**
+             * Writes the view's physical values into dst, which must be at least size() values in size
+             */
+            void CopyTo(std::span<double> dst) const;
+
+            [[nodiscard]] const RawValuesSpan& GetRawValues() const noexcept { return m_rawValues; }
+            [[nodiscard]] const PhysicalValueTransform& GetTransform() const noexcept { return m_transform; }
+
+            /**
+             * Invokes func with the std::span of raw values the view references, in their stored type
+             */
+            template <typename Func>
+            decltype(auto) Visit(Func&& func) const
+            {
+                return std::visit(std::forward<Func>(func), m_rawValues);
+            }
+
+        private:
+
+            RawValuesSpan m_rawValues{std::span<const double>{}};
+            PhysicalValueTransform m_transform{};
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_IMAGE_PHYSICALVALUES_H
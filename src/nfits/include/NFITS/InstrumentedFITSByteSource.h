@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_INSTRUMENTEDFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_INSTRUMENTEDFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "SharedLib.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+
+namespace NFITS
+{
+    /**
+     * Histogram of operation latencies, bucketed by powers of two microseconds.
+     *
+     * Bucket 0 counts operations which took less than 1us. Bucket N counts operations which took [2^(N-1), 2^N)us.
+     * The last bucket also counts all operations which took longer than it covers.
+     */
+    struct NFITS_PUBLIC LatencyHistogram
+    {
+        static constexpr std::size_t BUCKET_COUNT = 32U;
+
+        std::array<uint64_t, BUCKET_COUNT> buckets{};
+
+        void Record(std::chrono::nanoseconds duration);
+
+        /**
+         * @return The total number of operations recorded
+         */
+        [[nodiscard]] uint64_t GetCount() const;
+
+        /**
+         * @param percentile Percentile, in the range [0.0, 100.0], to look up
+         *
+         * @return An upper bound on the latency which the given percentile of operations completed within, or
+         * zero if no operations have been recorded. Accurate to within a factor of two.
+         */
+        [[nodiscard]] std::chrono::microseconds GetPercentile(double percentile) const;
+    };
+
+    struct ByteSourceOpStats
+    {
+        uint64_t count{0};                          // Number of operations performed
+        uint64_t failedCount{0};                    // Number of operations which failed
+        uintmax_t byteSize{0};                      // Number of bytes moved by operations which succeeded
+        std::chrono::nanoseconds totalDuration{0};  // Total time spent in operations
+        LatencyHistogram latency;                   // Per-operation latencies
+    };
+
+    struct ByteSourceIOStats
+    {
+        ByteSourceOpStats reads;    // ReadBytes, ReadBytesV and ReadBytesAsync calls. A vectored read counts as one operation.
+        ByteSourceOpStats writes;   // WriteBytes calls
+        ByteSourceOpStats flushes;  // Flush calls
+        ByteSourceOpStats views;    // GetBytesView calls which returned a view, and the bytes they viewed. Untimed.
+    };
+
+    /**
+     * IFITSByteSource decorator which records the number of reads, writes and flushes performed on a wrapped
+     * source, the number of bytes they moved, and histograms of their latencies.
+     *
+     * Views of the wrapped source's bytes, returned by GetBytesView, are counted along with the bytes they
+     * cover. Accesses of a view's memory don't call into the source at all, so they can't be timed. Async reads
+     * are passed through to the wrapped source's ReadBytesAsync, so that it can keep its own async mechanism,
+     * and are recorded when their result is collected from the returned future; their latency is measured from
+     * when the read was begun until then. All other calls are passed through without being recorded.
+     *
+     * Supports concurrent reads if the wrapped source does.
+     */
+    class NFITS_PUBLIC InstrumentedFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            /**
+             * Create an InstrumentedFITSByteSource instance which wraps a source
+             *
+             * @param pSource The source to be wrapped
+             *
+             * @return An InstrumentedFITSByteSource
+             */
+            [[nodiscard]] static std::unique_ptr<InstrumentedFITSByteSource> Create(std::unique_ptr<IFITSByteSource> pSource);
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            InstrumentedFITSByteSource(Tag tag, std::unique_ptr<IFITSByteSource> pSource);
+            ~InstrumentedFITSByteSource() override;
+
+            InstrumentedFITSByteSource(const InstrumentedFITSByteSource&) = delete;
+            InstrumentedFITSByteSource& operator=(const InstrumentedFITSByteSource&) = delete;
+
+            [[nodiscard]] IFITSByteSource* GetWrappedSource() const noexcept { return m_pSource.get(); }
+
+            /**
+             * @return A snapshot of the stats recorded since the source was created or its stats were last reset
+             */
+            [[nodiscard]] ByteSourceIOStats GetStats() const;
+            void ResetStats();
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_INSTRUMENTED; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result ReadBytesV(std::span<const ReadRequest> requests) override;
+            [[nodiscard]] std::future<Result> ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return m_pSource->SupportsConcurrentReads(); }
+            [[nodiscard]] std::optional<std::span<const std::byte>> GetBytesView(const ByteOffset& byteOffset,
+                                                                                 const ByteSize& byteSize) const override;
+            void AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint) override;
+
+        private:
+
+            // Locks m_statsMutex; opStats must be one of m_stats's members
+            void RecordOp(ByteSourceOpStats& opStats, const Result& result, uintmax_t byteSize, std::chrono::nanoseconds duration) const;
+
+        private:
+
+            std::unique_ptr<IFITSByteSource> m_pSource;
+
+            mutable std::mutex m_statsMutex;
+            mutable ByteSourceIOStats m_stats;  // Mutable as views are recorded by the const GetBytesView
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_INSTRUMENTEDFITSBYTESOURCE_H
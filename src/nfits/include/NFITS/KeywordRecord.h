@@ -43,6 +43,11 @@ namespace NFITS
              */
             [[nodiscard]] std::expected<std::optional<std::string>, Error> GetKeywordName() const;
 
+            /**
+             * @return The unprocessed, space padded, 8 characters of the record's keyword name field
+             */
+            [[nodiscard]] KeywordNameCSpan GetKeywordNameRaw() const noexcept { return std::span<const char>(m_keywordRecord).subspan<0, 8>(); }
+
             /**
              * @return Whether the keyword record has the '= ' characters indicating the record contains a value
              */
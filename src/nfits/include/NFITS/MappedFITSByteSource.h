@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_MAPPEDFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_MAPPEDFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "SharedLib.h"
+
+#include <filesystem>
+#include <memory>
+#include <expected>
+
+namespace NFITS
+{
+    /**
+     * Concrete, read-only, IFITSByteSource which memory maps a filesystem file.
+     *
+     * Reads are served directly from the mapping, and GetBytesView provides zero-copy access to the
+     * file's bytes. Writing and resizing are not supported.
+     *
+     * Warning: the mapping's size is fixed when the file is opened, and it's shared with the file. If another
+     * process truncates the file while it's open, touching the mapping beyond the file's new end, whether via
+     * ReadBytes or a view, raises SIGBUS and kills the process, where a disk source would instead fail the read.
+     * Rewritten files' bytes can also change underneath views. Only use this source for files which won't be
+     * modified while they're open.
+     */
+    class NFITS_PUBLIC MappedFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            /**
+             * Create a MappedFITSByteSource instance by opening and memory mapping a filesystem file
+             *
+             * @param filePath The file to be opened
+             *
+             * @return A MappedFITSByteSource, or an Error on error
+             */
+            [[nodiscard]] static std::expected<std::unique_ptr<MappedFITSByteSource>, Error> Open(
+                const std::filesystem::path& filePath
+            );
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            MappedFITSByteSource(Tag tag, std::filesystem::path filePath);
+            ~MappedFITSByteSource() override;
+
+            MappedFITSByteSource(const MappedFITSByteSource&) = delete;
+            MappedFITSByteSource& operator=(const MappedFITSByteSource&) = delete;
+
+            [[nodiscard]] std::filesystem::path GetFilesystemPath() const noexcept { return m_filePath; }
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_MAPPED; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+            [[nodiscard]] std::optional<std::span<const std::byte>> GetBytesView(const ByteOffset& byteOffset,
+                                                                                 const ByteSize& byteSize) const override;
+            void AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint) override;
+
+        private:
+
+            [[nodiscard]] Result Map();
+            void Unmap();
+
+        private:
+
+            std::filesystem::path m_filePath;
+
+            const std::byte* m_pData{nullptr};
+            std::uintmax_t m_byteSize{0};
+
+        #if defined(_WIN32)
+            void* m_hFile{nullptr};
+            void* m_hMapping{nullptr};
+        #else
+            int m_fd{-1};
+        #endif
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_MAPPEDFITSBYTESOURCE_H
@@ -35,6 +35,8 @@ namespace NFITS
 
             Result Flush() override;
 
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+
         private:
 
             std::vector<std::byte> m_data;
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_READAHEADFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_READAHEADFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "SharedLib.h"
+
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NFITS
+{
+    struct ReadAheadParams
+    {
+        // Number of bytes prefetched ahead of a sequential reader, per prefetch
+        ByteSize windowByteSize{8U * 1024U * 1024U};
+
+        // Number of consecutive back-to-back reads after which access is considered sequential. Advising
+        // ByteAccessHint::Sequential for a range considers access within that range sequential immediately.
+        unsigned int sequentialReadThreshold{2U};
+    };
+
+    struct ReadAheadStats
+    {
+        uintmax_t prefetchedByteSize{0};    // Number of bytes read from the wrapped source by prefetches
+        uintmax_t servedByteSize{0};        // Number of requested bytes which were served from prefetched bytes
+        uintmax_t directByteSize{0};        // Number of requested bytes which were read directly from the wrapped source
+        uint64_t prefetchWaits{0};          // Number of times a read had to wait for an in-flight prefetch to finish
+    };
+
+    /**
+     * IFITSByteSource decorator which detects sequential reads of a wrapped source and prefetches the bytes
+     * which follow them on a background thread, so that reading the next bytes from the wrapped source overlaps
+     * with the caller's processing of the previous ones.
+     *
+     * Prefetched bytes are double buffered: the bytes most recently prefetched are served to reads from one
+     * window while the next window's worth of bytes are prefetched into the other.
+     *
+     * Reads of at least READ_CHUNK_BYTE_SIZE bytes are always read directly from the wrapped source, so that
+     * parallel chunked loads aren't serialized behind the prefetch thread.
+     *
+     * Writes and resizes are passed through to the wrapped source and discard any prefetched bytes.
+     *
+     * Supports concurrent reads, regardless of whether the wrapped source does; reads of the wrapped source are
+     * serialized when it doesn't.
+     */
+    class NFITS_PUBLIC ReadAheadFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            /**
+             * Create a ReadAheadFITSByteSource instance which wraps a source
+             *
+             * @param pSource The source to be wrapped
+             * @param params Parameters which control when and how far ahead bytes are prefetched
+             *
+             * @return A ReadAheadFITSByteSource
+             */
+            [[nodiscard]] static std::unique_ptr<ReadAheadFITSByteSource> Create(std::unique_ptr<IFITSByteSource> pSource,
+                                                                                 const ReadAheadParams& params = {});
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            ReadAheadFITSByteSource(Tag tag, std::unique_ptr<IFITSByteSource> pSource, const ReadAheadParams& params);
+            ~ReadAheadFITSByteSource() override;
+
+            ReadAheadFITSByteSource(const ReadAheadFITSByteSource&) = delete;
+            ReadAheadFITSByteSource& operator=(const ReadAheadFITSByteSource&) = delete;
+
+            [[nodiscard]] IFITSByteSource* GetWrappedSource() const noexcept { return m_pSource.get(); }
+            [[nodiscard]] ReadAheadStats GetStats() const;
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_READ_AHEAD; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+            [[nodiscard]] std::optional<std::span<const std::byte>> GetBytesView(const ByteOffset& byteOffset,
+                                                                                 const ByteSize& byteSize) const override;
+            void AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint) override;
+
+        private:
+
+            enum class PrefetchState
+            {
+                Idle,       // No prefetch has been requested; the back window holds nothing
+                Requested,  // A prefetch into the back window has been requested but not yet started
+                InFlight,   // The prefetch thread is reading into the back window
+                Complete    // The prefetch finished; the back window holds its bytes, if it succeeded
+            };
+
+            struct Window
+            {
+                std::vector<std::byte> bytes;
+                uintmax_t byteOffset{0};
+                uintmax_t byteSize{0};
+                bool valid{false};
+
+                [[nodiscard]] uintmax_t EndOffset() const noexcept { return byteOffset + byteSize; }
+                [[nodiscard]] bool Contains(uintmax_t offset) const noexcept { return valid && offset >= byteOffset && offset < EndOffset(); }
+            };
+
+        private:
+
+            void PrefetchThreadFunc();
+
+            // All of the following require m_mutex to be held
+            [[nodiscard]] Window& FrontWindow() { return m_windows[m_frontWindowIndex]; }
+            [[nodiscard]] Window& BackWindow() { return m_windows[1U - m_frontWindowIndex]; }
+            [[nodiscard]] bool IsSequential(uintmax_t byteOffset) const;
+            void EnsurePrefetch(uintmax_t byteOffset);
+            void WaitForPrefetch(std::unique_lock<std::mutex>& lock);
+            void DiscardPrefetchedBytes(std::unique_lock<std::mutex>& lock);
+
+            [[nodiscard]] Result ReadFromSource(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const;
+
+        private:
+
+            std::unique_ptr<IFITSByteSource> m_pSource;
+            ReadAheadParams m_params;
+
+            // Serializes access to the wrapped source, if it doesn't support concurrent reads
+            mutable std::mutex m_sourceMutex;
+
+            // Guards all of the following state, which is shared with the prefetch thread
+            mutable std::mutex m_mutex;
+            std::condition_variable m_cv;
+
+            std::array<Window, 2> m_windows;
+            std::size_t m_frontWindowIndex{0};
+            PrefetchState m_prefetchState{PrefetchState::Idle};
+
+            uintmax_t m_nextSequentialOffset;
+            unsigned int m_sequentialReadCount{0};
+
+            bool m_sequentialAdvised{false};
+            uintmax_t m_sequentialAdvisedEndOffset{0};
+
+            ReadAheadStats m_stats;
+
+            bool m_stopPrefetchThread{false};
+            std::thread m_prefetchThread;
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_READAHEADFITSBYTESOURCE_H
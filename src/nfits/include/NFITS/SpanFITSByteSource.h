@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_INCLUDE_NFITS_SPANFITSBYTESOURCE_H
+#define NFITS_INCLUDE_NFITS_SPANFITSBYTESOURCE_H
+
+#include "IFITSByteSource.h"
+#include "SharedLib.h"
+
+#include <memory>
+
+namespace NFITS
+{
+    /**
+     * Concrete, read-only, IFITSByteSource which is backed by memory it doesn't own, such as a buffer
+     * received from elsewhere which already holds a FITS file's bytes.
+     *
+     * No bytes are copied when the source is created. Reads are served directly from the memory, and
+     * GetBytesView provides zero-copy access to it. Writing and resizing are not supported.
+     */
+    class NFITS_PUBLIC SpanFITSByteSource : public IFITSByteSource
+    {
+        public:
+
+            /**
+             * Create a SpanFITSByteSource instance which borrows memory. The memory must remain valid, and
+             * unmodified, for the lifetime of the source.
+             *
+             * @param bytes The memory to be read from
+             *
+             * @return A SpanFITSByteSource
+             */
+            [[nodiscard]] static std::unique_ptr<SpanFITSByteSource> Create(std::span<const std::byte> bytes);
+
+            /**
+             * Create a SpanFITSByteSource instance which shares ownership of memory. The source keeps pOwner
+             * alive for its lifetime, so the memory remains valid for as long as the source exists.
+             *
+             * @param bytes The memory to be read from
+             * @param pOwner Owner of the memory, for example a shared_ptr to the container which holds it
+             *
+             * @return A SpanFITSByteSource
+             */
+            [[nodiscard]] static std::unique_ptr<SpanFITSByteSource> Create(std::span<const std::byte> bytes,
+                                                                            std::shared_ptr<const void> pOwner);
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            SpanFITSByteSource(Tag tag, std::span<const std::byte> bytes, std::shared_ptr<const void> pOwner);
+            ~SpanFITSByteSource() override;
+
+            SpanFITSByteSource(const SpanFITSByteSource&) = delete;
+            SpanFITSByteSource& operator=(const SpanFITSByteSource&) = delete;
+
+            //
+            // IFITSByteSource
+            //
+            [[nodiscard]] unsigned int GetType() const override { return BYTE_SOURCE_TYPE_SPAN; }
+            [[nodiscard]] std::expected<ByteSize, Error> GetByteSize() const override;
+            Result Resize(const ByteSize& byteSize) override;
+
+            Result ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override;
+            Result WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush) override;
+
+            Result Flush() override;
+
+            [[nodiscard]] bool SupportsConcurrentReads() const override { return true; }
+            [[nodiscard]] std::optional<std::span<const std::byte>> GetBytesView(const ByteOffset& byteOffset,
+                                                                                 const ByteSize& byteSize) const override;
+
+        private:
+
+            std::span<const std::byte> m_bytes;
+            std::shared_ptr<const void> m_pOwner;
+    };
+}
+
+#endif //NFITS_INCLUDE_NFITS_SPANFITSBYTESOURCE_H
@@ -7,18 +7,20 @@
 #ifndef NFITS_INCLUDE_NFITS_UTIL_TRANSFER_H
 #define NFITS_INCLUDE_NFITS_UTIL_TRANSFER_H
 
+#include "../Def.h"
 #include "../SharedLib.h"
 #include "../Result.h"
 
 #include <optional>
 #include <cstdint>
+#include <functional>
 
 namespace NFITS
 {
     class IFITSByteSource;
 
     /**
-     * Copies the entirety of a source IFITSByteSource to a dest IFITSByteSource, on a per-block basis.
+     * Copies the entirety of a source IFITSByteSource to a dest IFITSByteSource, in chunks of whole blocks.
      *
      * Will Resize() the destination before copying, so that it's sized the same as the source.
      *
@@ -26,11 +28,46 @@ namespace NFITS
      *
      * @param pSrc Source IFITSByteSource to read data from
      * @param pDst Destination IFITSByteSource to write data to
-     * @param flush Whether to flush after each transferred block
+     * @param flush Whether to flush after each transferred chunk of blocks
      *
      * @return Whether all blocks were transferred successfully
      */
     NFITS_PUBLIC Result CopyFITSSource(IFITSByteSource* pSrc, IFITSByteSource* pDst, bool flush);
+
+    struct CopyParams
+    {
+        // Whether to flush the destination after each transferred chunk of blocks
+        bool flush{false};
+
+        // Number of bytes transferred per chunk, rounded down to whole blocks. Progress is reported, and
+        // cancellation checked, once per chunk.
+        ByteSize chunkByteSize{READ_CHUNK_BYTE_SIZE};
+
+        // Optional; called after each chunk is transferred with the number of bytes copied so far, and the total
+        // number of bytes being copied
+        std::function<void(uintmax_t copiedByteSize, uintmax_t totalByteSize)> onProgress{};
+
+        // Optional; polled before each chunk is transferred. The copy stops, and fails, once it returns true.
+        std::function<bool()> isCancelled{};
+    };
+
+    /**
+     * Copies the entirety of a source IFITSByteSource to a dest IFITSByteSource, in chunks of whole blocks.
+     *
+     * Will Resize() the destination before copying, so that it's sized the same as the source.
+     *
+     * Copies between two ConcurrentDiskFITSByteSources are performed without the bytes passing through user
+     * space where the platform allows it. Other copies are pipelined, reading the next chunk from the source
+     * while the current chunk is written to the destination.
+     *
+     * @param pSrc Source IFITSByteSource to read data from
+     * @param pDst Destination IFITSByteSource to write data to
+     * @param params Parameters which control the copy
+     *
+     * @return Whether all blocks were transferred successfully. Fails if the copy was cancelled, in which case
+     * the destination holds only some of the source's blocks.
+     */
+    NFITS_PUBLIC Result CopyFITSSource(IFITSByteSource* pSrc, IFITSByteSource* pDst, const CopyParams& params);
 }
 
 #endif //NFITS_INCLUDE_NFITS_UTIL_TRANSFER_H
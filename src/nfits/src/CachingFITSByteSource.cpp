@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/CachingFITSByteSource.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace NFITS
+{
+
+std::unique_ptr<CachingFITSByteSource> CachingFITSByteSource::Create(std::unique_ptr<IFITSByteSource> pSource,
+                                                                     std::shared_ptr<FITSByteCache> pCache,
+                                                                     const std::string& cacheKey)
+{
+    const auto keyId = cacheKey.empty() ? pCache->GetUniqueKeyId() : pCache->GetKeyId(cacheKey);
+
+    return std::make_unique<CachingFITSByteSource>(Tag{}, std::move(pSource), std::move(pCache), keyId);
+}
+
+CachingFITSByteSource::CachingFITSByteSource(CachingFITSByteSource::Tag,
+                                             std::unique_ptr<IFITSByteSource> pSource,
+                                             std::shared_ptr<FITSByteCache> pCache,
+                                             uint64_t keyId)
+    : m_pSource(std::move(pSource))
+    , m_pCache(std::move(pCache))
+    , m_keyId(keyId)
+{
+
+}
+
+CachingFITSByteSource::~CachingFITSByteSource() = default;
+
+std::expected<ByteSize, Error> CachingFITSByteSource::GetByteSize() const
+{
+    if (m_pSource->SupportsConcurrentReads())
+    {
+        return m_pSource->GetByteSize();
+    }
+
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    return m_pSource->GetByteSize();
+}
+
+Result CachingFITSByteSource::Resize(const ByteSize& byteSize)
+{
+    const auto result = m_pSource->Resize(byteSize);
+
+    // Whether the resize succeeded or not, the cached bytes can no longer be trusted
+    m_pCache->InvalidateKey(m_keyId);
+
+    return result;
+}
+
+Result CachingFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("CachingFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    if (byteSize.value == 0)
+    {
+        return Result::Success();
+    }
+
+    const auto pageByteSize = m_pCache->GetPageByteSize().value;
+    const auto readStartOffset = byteOffset.value;
+    const auto readEndOffset = byteOffset.value + byteSize.value;
+
+    const auto firstPageIndex = readStartOffset / pageByteSize;
+    const auto endPageIndex = ((readEndOffset - 1) / pageByteSize) + 1;
+
+    // Bulk reads, whose pages hold at least a read chunk's worth of bytes, bypass the cache entirely. Note
+    // that a read of one page is always cached, however large the cache's pages are.
+    const auto numPages = endPageIndex - firstPageIndex;
+    const auto minBypassPageCount = std::max<uintmax_t>((READ_CHUNK_BYTE_SIZE.value + pageByteSize - 1U) / pageByteSize, 2U);
+
+    if (numPages >= minBypassPageCount)
+    {
+        return ReadFromSource(dst, byteOffset, byteSize);
+    }
+
+    const auto sourceByteSize = GetByteSize();
+    if (!sourceByteSize)
+    {
+        return Result::Fail(sourceByteSize.error());
+    }
+
+    if ((byteOffset.value > sourceByteSize->value) || (byteSize.value > (sourceByteSize->value - byteOffset.value)))
+    {
+        return Result::Fail("CachingFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+    }
+
+    // Copies the portion of a page's bytes which overlaps the requested read into dst
+    const auto copyPageOverlap = [&](uintmax_t pageIndex, std::span<const std::byte> pageBytes){
+        const auto pageStartOffset = pageIndex * pageByteSize;
+        const auto overlapStartOffset = std::max(pageStartOffset, readStartOffset);
+        const auto overlapEndOffset = std::min(pageStartOffset + pageBytes.size(), readEndOffset);
+
+        std::ranges::copy(
+            pageBytes.subspan(overlapStartOffset - pageStartOffset, overlapEndOffset - overlapStartOffset),
+            dst.begin() + static_cast<std::ptrdiff_t>(overlapStartOffset - readStartOffset)
+        );
+    };
+
+    std::vector<std::byte> runBytes;
+
+    uintmax_t pageIndex = firstPageIndex;
+
+    while (pageIndex < endPageIndex)
+    {
+        //
+        // Serve the page's portion of the read from the cache, if the page is cached
+        //
+        const auto pageStartOffset = pageIndex * pageByteSize;
+        const auto overlapStartOffset = std::max(pageStartOffset, readStartOffset);
+        const auto overlapEndOffset = std::min(pageStartOffset + pageByteSize, readEndOffset);
+
+        const auto pageDst = dst.subspan(overlapStartOffset - readStartOffset, overlapEndOffset - overlapStartOffset);
+
+        if (m_pCache->ReadPage(m_keyId, pageIndex, overlapStartOffset - pageStartOffset, pageDst))
+        {
+            pageIndex++;
+            continue;
+        }
+
+        //
+        // Otherwise, read the run of consecutive uncached pages starting at the page from the source with
+        // one read, and cache each page of the run. Each of the run's pages counts as a cache miss.
+        //
+        auto runEndPageIndex = pageIndex + 1;
+        while ((runEndPageIndex < endPageIndex) && !m_pCache->ContainsPage(m_keyId, runEndPageIndex))
+        {
+            runEndPageIndex++;
+        }
+
+        const auto runStartOffset = pageIndex * pageByteSize;
+        const auto runEndOffset = std::min(runEndPageIndex * pageByteSize, sourceByteSize->value);
+
+        runBytes.resize(static_cast<std::size_t>(runEndOffset - runStartOffset));
+
+        const auto result = ReadFromSource(runBytes, ByteOffset(runStartOffset), ByteSize(runBytes.size()));
+        if (!result)
+        {
+            return result;
+        }
+
+        for (auto runPageIndex = pageIndex; runPageIndex < runEndPageIndex; ++runPageIndex)
+        {
+            const auto runPageOffset = (runPageIndex - pageIndex) * pageByteSize;
+            const auto runPageBytes = std::span<const std::byte>(runBytes).subspan(
+                runPageOffset,
+                std::min(pageByteSize, runBytes.size() - runPageOffset)
+            );
+
+            m_pCache->InsertPage(m_keyId, runPageIndex, runPageBytes);
+
+            copyPageOverlap(runPageIndex, runPageBytes);
+        }
+
+        pageIndex = runEndPageIndex;
+    }
+
+    return Result::Success();
+}
+
+Result CachingFITSByteSource::WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush)
+{
+    const auto result = m_pSource->WriteBytes(src, byteOffset, byteSize, flush);
+
+    // Invalidate any cached pages which the write overlapped
+    if (byteSize.value > 0)
+    {
+        const auto pageByteSize = m_pCache->GetPageByteSize().value;
+        const auto firstPageIndex = byteOffset.value / pageByteSize;
+        const auto endPageIndex = ((byteOffset.value + byteSize.value - 1) / pageByteSize) + 1;
+
+        for (auto pageIndex = firstPageIndex; pageIndex < endPageIndex; ++pageIndex)
+        {
+            m_pCache->InvalidatePage(m_keyId, pageIndex);
+        }
+    }
+
+    return result;
+}
+
+Result CachingFITSByteSource::Flush()
+{
+    return m_pSource->Flush();
+}
+
+std::optional<std::span<const std::byte>> CachingFITSByteSource::GetBytesView(const ByteOffset& byteOffset,
+                                                                               const ByteSize& byteSize) const
+{
+    // If the wrapped source can provide zero-copy access to its bytes, that's better than anything the cache can do
+    return m_pSource->GetBytesView(byteOffset, byteSize);
+}
+
+void CachingFITSByteSource::AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint)
+{
+    m_pSource->AdviseAccess(byteOffset, byteSize, hint);
+}
+
+Result CachingFITSByteSource::ReadFromSource(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const
+{
+    if (m_pSource->SupportsConcurrentReads())
+    {
+        return m_pSource->ReadBytes(dst, byteOffset, byteSize);
+    }
+
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    return m_pSource->ReadBytes(dst, byteOffset, byteSize);
+}
+
+}
@@ -0,0 +1,646 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/ConcurrentDiskFITSByteSource.h>
+
+#include "Util/IOUring.h"
+#include "Util/ReadRequestUtil.h"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #if defined(__linux__)
+        #include <sys/sendfile.h>
+    #endif
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#include <NFITS/Def.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace NFITS
+{
+
+// Max number of async reads in flight at once, per source
+static constexpr unsigned int IO_URING_QUEUE_DEPTH = 64U;
+
+std::expected<std::unique_ptr<ConcurrentDiskFITSByteSource>, Error> ConcurrentDiskFITSByteSource::Open(
+    const std::filesystem::path& filePath,
+    Access access,
+    bool createIfNotExists)
+{
+    auto source = std::make_unique<ConcurrentDiskFITSByteSource>(Tag{}, filePath, access);
+
+    const auto result = source->OpenFile(createIfNotExists);
+    if (!result)
+    {
+        return std::unexpected(*result.error);
+    }
+
+    return source;
+}
+
+ConcurrentDiskFITSByteSource::ConcurrentDiskFITSByteSource(ConcurrentDiskFITSByteSource::Tag,
+                                                           std::filesystem::path filePath,
+                                                           Access access)
+    : m_filePath(std::move(filePath))
+    , m_access(access)
+{
+
+}
+
+ConcurrentDiskFITSByteSource::~ConcurrentDiskFITSByteSource()
+{
+    // Destroy the ring before the file it reads from is closed
+    m_pIOUring.reset();
+
+    CloseFile();
+}
+
+Result ConcurrentDiskFITSByteSource::Flush()
+{
+    // no-op, writes are made directly to the file, without any intermediate buffering
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::CopyBytesToBuffered(ConcurrentDiskFITSByteSource& dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    std::vector<std::byte> chunkBytes(static_cast<std::size_t>(std::min(byteSize.value, READ_CHUNK_BYTE_SIZE.value)));
+
+    for (uintmax_t numBytesCopied = 0; numBytesCopied < byteSize.value; )
+    {
+        const auto chunkByteSize = ByteSize(std::min(byteSize.value - numBytesCopied, READ_CHUNK_BYTE_SIZE.value));
+        const auto chunkByteOffset = ByteOffset(byteOffset.value + numBytesCopied);
+
+        auto result = ReadBytes(chunkBytes, chunkByteOffset, chunkByteSize);
+        if (!result) { return result; }
+
+        result = dst.WriteBytes(chunkBytes, chunkByteOffset, chunkByteSize, false);
+        if (!result) { return result; }
+
+        numBytesCopied += chunkByteSize.value;
+    }
+
+    return Result::Success();
+}
+
+#if defined(_WIN32)
+
+// Max number of bytes transferred by one ReadFile/WriteFile call
+static constexpr uintmax_t MAX_TRANSFER_BYTE_SIZE = 1U << 30U;
+
+std::expected<ByteSize, Error> ConcurrentDiskFITSByteSource::GetByteSize() const
+{
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(static_cast<HANDLE>(m_hFile), &fileSize))
+    {
+        return std::unexpected(Error::Msg("ConcurrentDiskFITSByteSource::GetByteSize: Call to GetFileSizeEx() failed"));
+    }
+
+    return ByteSize{static_cast<uintmax_t>(fileSize.QuadPart)};
+}
+
+Result ConcurrentDiskFITSByteSource::Resize(const ByteSize& byteSize)
+{
+    if (m_access != Access::ReadWrite)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::Resize: Source was opened read-only");
+    }
+
+    FILE_END_OF_FILE_INFO endOfFileInfo{};
+    endOfFileInfo.EndOfFile.QuadPart = static_cast<LONGLONG>(byteSize.value);
+
+    if (!SetFileInformationByHandle(static_cast<HANDLE>(m_hFile), FileEndOfFileInfo, &endOfFileInfo, sizeof(endOfFileInfo)))
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::Resize: Call to SetFileInformationByHandle() failed");
+    }
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    uintmax_t numBytesRead = 0;
+
+    while (numBytesRead < byteSize.value)
+    {
+        const auto offset = byteOffset.value + numBytesRead;
+        const auto toRead = static_cast<DWORD>(std::min(byteSize.value - numBytesRead, MAX_TRANSFER_BYTE_SIZE));
+
+        // An OVERLAPPED with an offset makes the read positional, independent of the handle's file pointer
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFU);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32U);
+
+        DWORD chunkBytesRead = 0;
+
+        if (!ReadFile(static_cast<HANDLE>(m_hFile), dst.data() + numBytesRead, toRead, &chunkBytesRead, &overlapped))
+        {
+            return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytes: Call to ReadFile() failed");
+        }
+
+        if (chunkBytesRead == 0)
+        {
+            return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+        }
+
+        numBytesRead += chunkBytesRead;
+    }
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::ReadBytesV(std::span<const ReadRequest> requests)
+{
+    return IFITSByteSource::ReadBytesV(requests);
+}
+
+std::future<Result> ConcurrentDiskFITSByteSource::ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    // No completion-based backend on this platform; service async reads with the IO thread pool
+    return IFITSByteSource::ReadBytesAsync(dst, byteOffset, byteSize);
+}
+
+Result ConcurrentDiskFITSByteSource::WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool)
+{
+    if (m_access != Access::ReadWrite)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::WriteBytes: Source was opened read-only");
+    }
+
+    if (src.size() < byteSize.value)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::WriteBytes: src size is too small for requested write");
+    }
+
+    uintmax_t numBytesWritten = 0;
+
+    while (numBytesWritten < byteSize.value)
+    {
+        const auto offset = byteOffset.value + numBytesWritten;
+        const auto toWrite = static_cast<DWORD>(std::min(byteSize.value - numBytesWritten, MAX_TRANSFER_BYTE_SIZE));
+
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFU);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32U);
+
+        DWORD chunkBytesWritten = 0;
+
+        if (!WriteFile(static_cast<HANDLE>(m_hFile), src.data() + numBytesWritten, toWrite, &chunkBytesWritten, &overlapped))
+        {
+            return Result::Fail("ConcurrentDiskFITSByteSource::WriteBytes: Call to WriteFile() failed");
+        }
+
+        numBytesWritten += chunkBytesWritten;
+    }
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::CopyBytesTo(ConcurrentDiskFITSByteSource& dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.m_access != Access::ReadWrite)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::CopyBytesTo: Destination was opened read-only");
+    }
+
+    return CopyBytesToBuffered(dst, byteOffset, byteSize);
+}
+
+Result ConcurrentDiskFITSByteSource::OpenFile(bool createIfNotExists)
+{
+    const bool readWrite = m_access == Access::ReadWrite;
+
+    const auto hFile = CreateFileW(
+        m_filePath.c_str(),
+        readWrite ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+        readWrite ? FILE_SHARE_READ : (FILE_SHARE_READ | FILE_SHARE_WRITE),
+        nullptr,
+        (readWrite && createIfNotExists) ? OPEN_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource: Failed to open the file");
+    }
+
+    m_hFile = hFile;
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::SyncToDisk()
+{
+    if (!FlushFileBuffers(static_cast<HANDLE>(m_hFile)))
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::SyncToDisk: Call to FlushFileBuffers() failed");
+    }
+
+    return Result::Success();
+}
+
+void ConcurrentDiskFITSByteSource::CloseFile()
+{
+    if (m_hFile != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(m_hFile));
+        m_hFile = nullptr;
+    }
+}
+
+#else
+
+std::expected<ByteSize, Error> ConcurrentDiskFITSByteSource::GetByteSize() const
+{
+    struct stat fileStat{};
+    if (fstat(m_fd, &fileStat) != 0)
+    {
+        return std::unexpected(Error::Msg("ConcurrentDiskFITSByteSource::GetByteSize: Call to fstat() failed"));
+    }
+
+    return ByteSize{static_cast<uintmax_t>(fileStat.st_size)};
+}
+
+Result ConcurrentDiskFITSByteSource::Resize(const ByteSize& byteSize)
+{
+    if (m_access != Access::ReadWrite)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::Resize: Source was opened read-only");
+    }
+
+    if (ftruncate(m_fd, static_cast<off_t>(byteSize.value)) != 0)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::Resize: Call to ftruncate() failed");
+    }
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    uintmax_t numBytesRead = 0;
+
+    // pread may return fewer bytes than requested; keep reading until the full range has been read
+    while (numBytesRead < byteSize.value)
+    {
+        const auto result = pread(
+            m_fd,
+            dst.data() + numBytesRead,
+            byteSize.value - numBytesRead,
+            static_cast<off_t>(byteOffset.value + numBytesRead)
+        );
+
+        if (result < 0)
+        {
+            if (errno == EINTR) { continue; }
+            return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytes: Call to pread() failed, errno: {}", errno);
+        }
+
+        if (result == 0)
+        {
+            return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+        }
+
+        numBytesRead += static_cast<uintmax_t>(result);
+    }
+
+    return Result::Success();
+}
+
+// Max number of iovecs passed to one preadv call; IOV_MAX on Linux and macOS
+static constexpr std::size_t MAX_IOVEC_COUNT = 1024U;
+
+/**
+ * preadv's the full byte range covered by the provided iovecs, continuing after short reads
+ */
+static Result PReadVFully(int fd, std::vector<iovec>& iovecs, uintmax_t byteOffset)
+{
+    std::size_t iovecIndex = 0;
+
+    while (iovecIndex < iovecs.size())
+    {
+        const auto result = preadv(
+            fd,
+            iovecs.data() + iovecIndex,
+            static_cast<int>(iovecs.size() - iovecIndex),
+            static_cast<off_t>(byteOffset)
+        );
+
+        if (result < 0)
+        {
+            if (errno == EINTR) { continue; }
+            return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytesV: Call to preadv() failed, errno: {}", errno);
+        }
+
+        if (result == 0)
+        {
+            return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytesV: Byte offset/size is out of bounds");
+        }
+
+        byteOffset += static_cast<uintmax_t>(result);
+
+        // Skip past the iovecs which were fully read, and trim the one which was partially read
+        auto numBytesRead = static_cast<std::size_t>(result);
+
+        while ((iovecIndex < iovecs.size()) && (numBytesRead >= iovecs[iovecIndex].iov_len))
+        {
+            numBytesRead -= iovecs[iovecIndex].iov_len;
+            iovecIndex++;
+        }
+
+        if (numBytesRead > 0)
+        {
+            auto& iov = iovecs[iovecIndex];
+            iov.iov_base = static_cast<std::byte*>(iov.iov_base) + numBytesRead;
+            iov.iov_len -= numBytesRead;
+        }
+    }
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::ReadBytesV(std::span<const ReadRequest> requests)
+{
+    if (!AreRequestDstsValid(requests))
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::ReadBytesV: dst size is too small for requested read");
+    }
+
+    const auto orderedIndices = GetOrderedRequestIndices(requests);
+
+    // preadv can't scatter the same bytes to multiple destinations; leave overlapping ranges to the
+    // default implementation
+    for (std::size_t x = 1; x < orderedIndices.size(); ++x)
+    {
+        const auto& previous = requests[orderedIndices[x - 1]];
+        if (requests[orderedIndices[x]].byteOffset.value < previous.byteOffset.value + previous.byteSize.value)
+        {
+            return IFITSByteSource::ReadBytesV(requests);
+        }
+    }
+
+    // Sink for the bytes of gaps between ranges, which are read through but discarded
+    std::vector<std::byte> gapBytes;
+
+    std::vector<iovec> iovecs;
+    iovecs.reserve(std::min(orderedIndices.size() * 2, MAX_IOVEC_COUNT));
+
+    std::size_t runStartIndex = 0;
+
+    while (runStartIndex < orderedIndices.size())
+    {
+        //
+        // Gather the run of ranges separated by gaps small enough to read through, scattering each range directly
+        // into its dst, and each gap into the gap sink
+        //
+        const auto runByteOffset = requests[orderedIndices[runStartIndex]].byteOffset.value;
+        auto runEndOffset = runByteOffset;
+
+        iovecs.clear();
+
+        std::size_t runEndIndex = runStartIndex;
+
+        while ((runEndIndex < orderedIndices.size()) && (iovecs.size() + 2 <= MAX_IOVEC_COUNT))
+        {
+            const auto& request = requests[orderedIndices[runEndIndex]];
+
+            const auto gapByteSize = request.byteOffset.value - runEndOffset;
+            if (gapByteSize > READV_COALESCE_GAP_BYTE_SIZE.value)
+            {
+                break;
+            }
+
+            if (gapByteSize > 0)
+            {
+                // Sized once, to the largest possible gap, as iovecs already point into it
+                if (gapBytes.empty()) { gapBytes.resize(static_cast<std::size_t>(READV_COALESCE_GAP_BYTE_SIZE.value)); }
+
+                iovecs.push_back(iovec{.iov_base = gapBytes.data(), .iov_len = static_cast<std::size_t>(gapByteSize)});
+            }
+
+            iovecs.push_back(iovec{.iov_base = request.dst.data(), .iov_len = static_cast<std::size_t>(request.byteSize.value)});
+
+            runEndOffset = request.byteOffset.value + request.byteSize.value;
+            runEndIndex++;
+        }
+
+        const auto result = PReadVFully(m_fd, iovecs, runByteOffset);
+        if (!result)
+        {
+            return result;
+        }
+
+        runStartIndex = runEndIndex;
+    }
+
+    return Result::Success();
+}
+
+std::future<Result> ConcurrentDiskFITSByteSource::ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    std::call_once(m_ioUringOnceFlag, [this](){
+        m_pIOUring = IOUring::Create(IO_URING_QUEUE_DEPTH);
+    });
+
+    if (m_pIOUring)
+    {
+        return m_pIOUring->SubmitRead(m_fd, dst, byteOffset, byteSize);
+    }
+
+    return IFITSByteSource::ReadBytesAsync(dst, byteOffset, byteSize);
+}
+
+Result ConcurrentDiskFITSByteSource::WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool)
+{
+    if (m_access != Access::ReadWrite)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::WriteBytes: Source was opened read-only");
+    }
+
+    if (src.size() < byteSize.value)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::WriteBytes: src size is too small for requested write");
+    }
+
+    uintmax_t numBytesWritten = 0;
+
+    while (numBytesWritten < byteSize.value)
+    {
+        const auto result = pwrite(
+            m_fd,
+            src.data() + numBytesWritten,
+            byteSize.value - numBytesWritten,
+            static_cast<off_t>(byteOffset.value + numBytesWritten)
+        );
+
+        if (result < 0)
+        {
+            if (errno == EINTR) { continue; }
+            return Result::Fail("ConcurrentDiskFITSByteSource::WriteBytes: Call to pwrite() failed, errno: {}", errno);
+        }
+
+        numBytesWritten += static_cast<uintmax_t>(result);
+    }
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::CopyBytesTo(ConcurrentDiskFITSByteSource& dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.m_access != Access::ReadWrite)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource::CopyBytesTo: Destination was opened read-only");
+    }
+
+    uintmax_t numBytesCopied = 0;
+
+#if defined(__linux__)
+    // Max number of bytes transferred by one copy call
+    static constexpr uintmax_t MAX_COPY_BYTE_SIZE = 1U << 30U;
+
+    //
+    // Copy within the kernel, which lets the filesystem share extents or offload the copy where it can
+    //
+    while (numBytesCopied < byteSize.value)
+    {
+        auto srcOffset = static_cast<off_t>(byteOffset.value + numBytesCopied);
+        auto dstOffset = srcOffset;
+
+        const auto result = copy_file_range(
+            m_fd, &srcOffset,
+            dst.m_fd, &dstOffset,
+            static_cast<std::size_t>(std::min(byteSize.value - numBytesCopied, MAX_COPY_BYTE_SIZE)),
+            0U
+        );
+
+        if (result < 0)
+        {
+            if (errno == EINTR) { continue; }
+
+            // Unsupported across these files (e.g. across filesystems, on older kernels); try the next method
+            break;
+        }
+        if (result == 0)
+        {
+            return Result::Fail("ConcurrentDiskFITSByteSource::CopyBytesTo: Byte offset/size is out of bounds");
+        }
+
+        numBytesCopied += static_cast<uintmax_t>(result);
+    }
+
+    //
+    // Otherwise, sendfile, which older kernels support between regular files, and which writes at the
+    // destination's file position
+    //
+    if ((numBytesCopied < byteSize.value) &&
+        (lseek(dst.m_fd, static_cast<off_t>(byteOffset.value + numBytesCopied), SEEK_SET) >= 0))
+    {
+        while (numBytesCopied < byteSize.value)
+        {
+            auto srcOffset = static_cast<off_t>(byteOffset.value + numBytesCopied);
+
+            const auto result = sendfile(
+                dst.m_fd,
+                m_fd,
+                &srcOffset,
+                static_cast<std::size_t>(std::min(byteSize.value - numBytesCopied, MAX_COPY_BYTE_SIZE))
+            );
+
+            if (result < 0)
+            {
+                if (errno == EINTR) { continue; }
+                break;
+            }
+            if (result == 0)
+            {
+                return Result::Fail("ConcurrentDiskFITSByteSource::CopyBytesTo: Byte offset/size is out of bounds");
+            }
+
+            numBytesCopied += static_cast<uintmax_t>(result);
+        }
+    }
+#endif
+
+    //
+    // Copy whatever remains through user space
+    //
+    return CopyBytesToBuffered(
+        dst,
+        ByteOffset(byteOffset.value + numBytesCopied),
+        ByteSize(byteSize.value - numBytesCopied)
+    );
+}
+
+Result ConcurrentDiskFITSByteSource::OpenFile(bool createIfNotExists)
+{
+    int flags = O_CLOEXEC;
+
+    if (m_access == Access::ReadWrite)
+    {
+        flags |= O_RDWR;
+        if (createIfNotExists) { flags |= O_CREAT; }
+    }
+    else
+    {
+        flags |= O_RDONLY;
+    }
+
+    m_fd = open(m_filePath.c_str(), flags, 0644);
+    if (m_fd < 0)
+    {
+        return Result::Fail("ConcurrentDiskFITSByteSource: Failed to open the file, errno: {}", errno);
+    }
+
+    return Result::Success();
+}
+
+Result ConcurrentDiskFITSByteSource::SyncToDisk()
+{
+    while (fsync(m_fd) != 0)
+    {
+        if (errno == EINTR) { continue; }
+        return Result::Fail("ConcurrentDiskFITSByteSource::SyncToDisk: Call to fsync() failed, errno: {}", errno);
+    }
+
+    return Result::Success();
+}
+
+void ConcurrentDiskFITSByteSource::CloseFile()
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+#endif
+
+}
@@ -20,12 +20,6 @@
 namespace NFITS
 {
 
-// Checks for byte offset overlap (half-open)
-inline bool Overlaps(uintmax_t a1, uintmax_t a2, uintmax_t b1, uintmax_t b2)
-{
-    return a1 < b2 && b1 < a2;
-}
-
 struct HDUBinTableMetadata
 {
     int64_t bitpix{0};
@@ -107,17 +101,30 @@ void RawDataToRawRows(std::vector<BinTableRowBytes>& out, const uintmax_t& rowBy
     }
 }
 
+/**
+ * @return The byte offset and byte size of a bintable's heap within the file's byte source
+ */
+std::pair<ByteOffset, ByteSize> GetHeapSourceRange(const HDU* pHDU, const HDUBinTableMetadata& metadata)
+{
+    const uintmax_t dataByteStartOffset = pHDU->GetDataBlockStartIndex() * BLOCK_BYTE_SIZE.value;
+
+    return std::make_pair(
+        ByteOffset(dataByteStartOffset + static_cast<uintmax_t>(metadata.theap)),
+        ByteSize(pHDU->GetDataByteSize() - static_cast<uintmax_t>(metadata.theap))
+    );
+}
+
 std::expected<std::pair<std::vector<BinTableRowBytes>, BinTableHeapBytes>, Error>
     ReadBinTableData(const FITSFile* pFile,
                      const HDU* pHDU,
                      const std::vector<BinField>& fields,
-                     const HDUBinTableMetadata& metadata)
+                     const HDUBinTableMetadata& metadata,
+                     bool loadHeap)
 {
     auto blockSource = FITSBlockSource(pFile->GetByteSource());
 
-    // Start & end HDU block indices containing all bintable data
+    // Start HDU block index of the bintable data
     const auto dataBlockStartIndex = pHDU->GetDataBlockStartIndex();
-    const auto dataBlockEndIndex = dataBlockStartIndex + pHDU->GetDataBlockCount();
 
     // Total byte size, table+supplemental, of the bintable
     const auto dataByteSize = pHDU->GetDataByteSize();
@@ -128,8 +135,11 @@ std::expected<std::pair<std::vector<BinTableRowBytes>, BinTableHeapBytes>, Error
     // Byte size of the table itself
     const auto tableByteSize = dataByteSize - supplementalByteSize;
 
-    // Byte size of the heap, within the supplemental area
-    const auto heapByteSize = dataByteSize - static_cast<uintmax_t>(metadata.theap);
+    // Location of the heap, within the supplemental area
+    const auto heapSourceRange = GetHeapSourceRange(pHDU, metadata);
+
+    // Byte size of the heap bytes to be read
+    const auto heapByteSize = loadHeap ? heapSourceRange.second.value : 0U;
 
     // Byte size of each row in the table
     const auto rowByteSizeExpect = GetRowByteSize(fields);
@@ -147,64 +157,71 @@ std::expected<std::pair<std::vector<BinTableRowBytes>, BinTableHeapBytes>, Error
     const auto numTableRows = tableByteSize / rowByteSize;
 
     //
-    // Read data blocks into memory and store their data in rowBytes & heapBytes structures
+    // Read the data into memory and store it in rowBytes & heapBytes structures
     //
     std::vector<BinTableRowBytes> rowBytes;
     rowBytes.reserve(numTableRows);
 
     std::vector<std::byte> heapBytes;
-    heapBytes.reserve(heapByteSize);
 
     // Byte offset to the start of the bintable data
     const uintmax_t dataByteStartOffset = dataBlockStartIndex * BLOCK_BYTE_SIZE.value;
 
-    // Byte offsets defining the table's bytes
+    // Byte offset to the start of the table's bytes
     const auto tableByteStartOffset = dataByteStartOffset;
-    const auto tableByteEndOffset = tableByteStartOffset + tableByteSize;
 
-    // Byte offsets defining the heap's bytes
-    const auto heapByteStartOffset = dataByteStartOffset + static_cast<uintmax_t>(metadata.theap);
-    const auto heapByteEndOffset = heapByteStartOffset + heapByteSize;
+    // Byte offset to the start of the heap's bytes
+    const auto heapByteStartOffset = heapSourceRange.first.value;
 
-    BlockBytes blockBytes{};
+    // Number of data blocks which are read; only those holding the table's rows, if the heap isn't read
+    const auto readBlockCount = loadHeap ? pHDU->GetDataBlockCount()
+                                         : (tableByteSize + BLOCK_BYTE_SIZE.value - 1) / BLOCK_BYTE_SIZE.value;
 
-    for (uintmax_t blockIndex = dataBlockStartIndex; blockIndex < dataBlockEndIndex; ++blockIndex)
+    //
+    // If the source holds the data in addressable memory, take the table and heap data directly from the source's memory
+    //
+    if (const auto dataView = blockSource.GetBlocksView(dataBlockStartIndex, pHDU->GetDataBlockCount()))
     {
-        if (!blockSource.ReadBlock(blockBytes, blockIndex))
-        {
-            return std::unexpected(Error::Msg("Failed to read next block of data from the file"));
-        }
+        blockSource.AdviseBlocks(dataBlockStartIndex, readBlockCount, ByteAccessHint::Sequential);
 
-        const uintmax_t blockByteStartOffset = blockIndex * BLOCK_BYTE_SIZE.value;
-        const uintmax_t blockByteEndOffset = blockByteStartOffset + BLOCK_BYTE_SIZE.value;
+        RawDataToRawRows(rowBytes, rowByteSize, dataView->subspan(0, tableByteSize));
 
-        // If this block contains table data, interpret and store it as table rows
-        if (Overlaps(blockByteStartOffset, blockByteEndOffset, tableByteStartOffset, tableByteEndOffset))
-        {
-            const auto overlapStartByteOffset = std::max(blockByteStartOffset, tableByteStartOffset);
-            const auto overlapEndByteOffset   = std::min(blockByteEndOffset, tableByteEndOffset);
+        const auto heapDataSpan = dataView->subspan(static_cast<uintmax_t>(metadata.theap), heapByteSize);
+        heapBytes.assign(heapDataSpan.begin(), heapDataSpan.end());
 
-            const auto blockTableDataSpan = std::span<const std::byte>(
-                blockBytes.data() + (overlapStartByteOffset - blockByteStartOffset),
-                overlapEndByteOffset - overlapStartByteOffset
-            );
+        return std::make_pair(std::move(rowBytes), std::move(heapBytes));
+    }
 
-            RawDataToRawRows(rowBytes, rowByteSize, blockTableDataSpan);
-        }
+    //
+    // Otherwise, start reading the heap directly into its final location, with one async read, so that it's read
+    // while the table's rows are read in large chunks of whole rows. Advise the source that the data blocks are
+    // read in order, so that it can prefetch the next chunk while the current one is processed.
+    //
+    blockSource.AdviseBlocks(dataBlockStartIndex, readBlockCount, ByteAccessHint::Sequential);
 
-        // If this block contains heap data, read it and store it as raw heap data
-        if (Overlaps(blockByteStartOffset, blockByteEndOffset, heapByteStartOffset, heapByteEndOffset))
-        {
-            const auto overlapStartByteOffset = std::max(blockByteStartOffset, heapByteStartOffset);
-            const auto overlapEndByteOffset   = std::min(blockByteEndOffset, heapByteEndOffset);
+    heapBytes.resize(heapByteSize);
+    auto heapReadFuture = blockSource.ReadSpanAsync(heapBytes, ByteOffset(heapByteStartOffset), ByteSize(heapByteSize));
+
+    const auto chunkRowCount = std::max(READ_CHUNK_BYTE_SIZE.value / rowByteSize, uintmax_t{1});
+    std::vector<std::byte> chunkBytes(static_cast<std::size_t>(std::min(chunkRowCount, numTableRows) * rowByteSize));
 
-            const auto blockHeapDataSpan = std::span<const std::byte>(
-                blockBytes.data() + (overlapStartByteOffset - blockByteStartOffset),
-                overlapEndByteOffset - overlapStartByteOffset
-            );
+    for (uintmax_t rowIndex = 0; rowIndex < numTableRows; rowIndex += chunkRowCount)
+    {
+        const auto chunkByteSize = std::min(numTableRows - rowIndex, chunkRowCount) * rowByteSize;
 
-            std::ranges::copy(blockHeapDataSpan, std::back_inserter(heapBytes));
+        if (!blockSource.ReadSpan(chunkBytes, ByteOffset(tableByteStartOffset + (rowIndex * rowByteSize)), ByteSize(chunkByteSize)))
+        {
+            // The heap read is writing into heapBytes; it must finish before heapBytes is destroyed
+            heapReadFuture.wait();
+            return std::unexpected(Error::Msg("Failed to read table data from the file"));
         }
+
+        RawDataToRawRows(rowBytes, rowByteSize, std::span<const std::byte>(chunkBytes.data(), chunkByteSize));
+    }
+
+    if (!heapReadFuture.get())
+    {
+        return std::unexpected(Error::Msg("Failed to read heap data from the file"));
     }
 
     assert(rowBytes.size() == numTableRows);
@@ -314,7 +331,9 @@ std::expected<std::vector<BinFieldForm>, Error> ParseFieldForms(const HDUBinTabl
     return fieldForms;
 }
 
-std::expected<std::unique_ptr<BinTableData>, Error> LoadBinTableDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU)
+std::expected<std::unique_ptr<BinTableData>, Error> LoadBinTableDataFromFileBlocking(const FITSFile* pFile,
+                                                                                      const HDU* pHDU,
+                                                                                      const BinTableLoadParams& params)
 {
     //
     // Parse HDU metadata as BinTable metadata
@@ -343,21 +362,33 @@ std::expected<std::unique_ptr<BinTableData>, Error> LoadBinTableDataFromFileBloc
     //
     // Read the BinTable data (table data + supplemental data) into memory
     //
-    auto data = ReadBinTableData(pFile, pHDU, fields, *metadata);
+    auto data = ReadBinTableData(pFile, pHDU, fields, *metadata, params.loadHeap);
     if (!data)
     {
         return std::unexpected(Error::Msg("Failed to read BinTable data"));
     }
 
-    return std::make_unique<BinTableData>(fields, std::move(data->first), std::move(data->second));
+    const auto heapSourceRange = GetHeapSourceRange(pHDU, *metadata);
+
+    return std::make_unique<BinTableData>(
+        fields,
+        std::move(data->first),
+        std::move(data->second),
+        heapSourceRange.first,
+        heapSourceRange.second
+    );
 }
 
 BinTableData::BinTableData(std::vector<BinField> fields,
                            std::vector<BinTableRowBytes> rowBytes,
-                           BinTableHeapBytes heapBytes)
+                           BinTableHeapBytes heapBytes,
+                           const ByteOffset& heapSourceByteOffset,
+                           const ByteSize& heapSourceByteSize)
     : m_fields(std::move(fields))
     , m_rowBytes(std::move(rowBytes))
     , m_heapBytes(std::move(heapBytes))
+    , m_heapSourceByteOffset(heapSourceByteOffset)
+    , m_heapSourceByteSize(heapSourceByteSize)
 {
 
 }
@@ -9,6 +9,8 @@
 #include <NFITS/Image/PhysicalStats.h>
 
 #include <NFITS/HDU.h>
+#include <NFITS/FITSFile.h>
+#include <NFITS/IFITSByteSource.h>
 #include <NFITS/KeywordCommon.h>
 
 #include "../Image/ImagePipeline.h"
@@ -237,7 +239,8 @@ std::pair<uint64_t, uint64_t> GetVariableArrayFieldValues(std::span<const std::b
     return std::make_pair(numElementsVal, heapByteOffsetVal);
 }
 
-std::expected<std::vector<double>, Error> ReadBinTableUncompressedImageData(const HDU* pHDU,
+std::expected<std::vector<double>, Error> ReadBinTableUncompressedImageData(const FITSFile* pFile,
+                                                                            const HDU* pHDU,
                                                                             const BinTableData* pBinTableData,
                                                                             const HDUBinTableImageMetadata& metadata)
 {
@@ -276,9 +279,12 @@ std::expected<std::vector<double>, Error> ReadBinTableUncompressedImageData(cons
     const auto arrayElementByteSize = pBinTableData->GetVarArrayElementByteSize(compressedDataField->second);
 
     //
-    // Read in each row of dynamic array data and decompress it
+    // Determine the location of each row's dynamic array data within the heap
     //
-    std::vector<double> output;
+    std::vector<std::pair<uint64_t, uint64_t>> rowHeapEntries; // Heap byte offset + byte size
+    rowHeapEntries.reserve(pBinTableData->GetNumRows());
+
+    uintmax_t compressedByteSize = 0;
 
     for (std::size_t x = 0; x < pBinTableData->GetNumRows(); ++x)
     {
@@ -302,14 +308,53 @@ std::expected<std::vector<double>, Error> ReadBinTableUncompressedImageData(cons
 
         const auto numElements = fieldValues.first;
         const auto heapByteOffset = fieldValues.second;
-
         const auto heapByteSize = numElements * arrayElementByteSize;
-        const auto heapSpan = std::span(pBinTableData->GetHeapBytes().data() + heapByteOffset, heapByteSize);
 
-        //
-        // Decompress the row's dynamic data
-        //
-        const auto decompressed = decompressFunc(pHDU, heapSpan, metadata);
+        if ((heapByteOffset > pBinTableData->GetHeapSourceByteSize().value) ||
+            (heapByteSize > pBinTableData->GetHeapSourceByteSize().value - heapByteOffset))
+        {
+            return std::unexpected(Error::Msg("COMPRESSED_DATA heap entry is out of bounds"));
+        }
+
+        rowHeapEntries.emplace_back(heapByteOffset, heapByteSize);
+        compressedByteSize += heapByteSize;
+    }
+
+    //
+    // Read only the rows' heap entries, rather than the whole heap, packed together, with one vectored read
+    //
+    std::vector<std::byte> compressedBytes(static_cast<std::size_t>(compressedByteSize));
+
+    std::vector<ReadRequest> readRequests;
+    readRequests.reserve(rowHeapEntries.size());
+
+    uintmax_t compressedByteOffset = 0;
+
+    for (const auto& heapEntry : rowHeapEntries)
+    {
+        readRequests.push_back(ReadRequest{
+            .dst = std::span(compressedBytes).subspan(compressedByteOffset, heapEntry.second),
+            .byteOffset = ByteOffset(pBinTableData->GetHeapSourceByteOffset().value + heapEntry.first),
+            .byteSize = ByteSize(heapEntry.second)
+        });
+
+        compressedByteOffset += heapEntry.second;
+    }
+
+    const auto readResult = pFile->GetByteSource()->ReadBytesV(readRequests);
+    if (!readResult)
+    {
+        return std::unexpected(Error::Msg("Failed to read COMPRESSED_DATA heap entries"));
+    }
+
+    //
+    // Decompress each row's dynamic array data
+    //
+    std::vector<double> output;
+
+    for (const auto& readRequest : readRequests)
+    {
+        const auto decompressed = decompressFunc(pHDU, readRequest.dst, metadata);
         if (!decompressed)
         {
             return std::unexpected(decompressed.error());
@@ -327,12 +372,15 @@ std::expected<std::vector<double>, Error> ReadBinTableUncompressedImageData(cons
     return output;
 }
 
-std::expected<std::unique_ptr<BinTableImageData>, Error> LoadBinTableImageDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU)
+std::expected<std::unique_ptr<BinTableImageData>, Error> LoadBinTableImageDataFromFileBlocking(const FITSFile* pFile,
+                                                                                           const HDU* pHDU,
+                                                                                           const ImageLoadParams& params)
 {
     //
     // Read the HDU's data as base BinTable data
     //
-    const auto binTableData = LoadBinTableDataFromFileBlocking(pFile, pHDU);
+    // The heap isn't loaded; only the heap entries holding the image's tiles are read from it
+    const auto binTableData = LoadBinTableDataFromFileBlocking(pFile, pHDU, BinTableLoadParams{.loadHeap = false});
     if (!binTableData)
     {
         return std::unexpected(binTableData.error());
@@ -356,7 +404,7 @@ std::expected<std::unique_ptr<BinTableImageData>, Error> LoadBinTableImageDataFr
     //
     // Read the image data from the bintable and uncompress it
     //
-    auto imageValues = ReadBinTableUncompressedImageData(pHDU, binTableData->get(), *metadata);
+    auto imageValues = ReadBinTableUncompressedImageData(pFile, pHDU, binTableData->get(), *metadata);
     if (!imageValues)
     {
         return std::unexpected(imageValues.error());
@@ -392,14 +440,35 @@ std::expected<std::unique_ptr<BinTableImageData>, Error> LoadBinTableImageDataFr
     //
     // Calculate slice statistics
     //
-    const auto slicePhysicalStats = CalculateSlicePhysicalStats(physicalValues, *sliceSpan);
-    const auto sliceCubePhysicalStats = CalculateSliceCubePhysicalStats(physicalValues, *sliceSpan);
+    // The transforms have already been applied, so the physical values are stored as-is, or narrowed to
+    // float32 physical values if requested
+    auto storedValues = RawImageValues(std::move(physicalValues));
+
+    if (params.float32PhysicalValues)
+    {
+        const auto doubleValues = std::move(storedValues);
+        const auto doubleValuesView = PhysicalValuesView(doubleValues, PhysicalValueTransform{});
+
+        std::vector<float> floatValues(doubleValuesView.size());
+
+        if (!ToFloat32PhysicalValues(doubleValuesView, floatValues))
+        {
+            return std::unexpected(Error::Msg("Failed to convert image values to float32 physical values"));
+        }
+
+        storedValues = std::move(floatValues);
+    }
+
+    const auto storedValuesView = PhysicalValuesView(storedValues, PhysicalValueTransform{});
+
+    auto physicalStats = CalculateImagePhysicalStats(storedValuesView, *sliceSpan);
 
     auto imageData = std::make_unique<ImageData>(
         *sliceSpan,
-        std::move(physicalValues),
-        slicePhysicalStats,
-        sliceCubePhysicalStats,
+        std::move(storedValues),
+        PhysicalValueTransform{},
+        std::move(physicalStats.slicePhysicalStats),
+        std::move(physicalStats.sliceCubePhysicalStats),
         metadata->bUnit,
         *wcsParams
     );
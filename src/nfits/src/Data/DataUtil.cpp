@@ -8,15 +8,21 @@
 #include <NFITS/Data/ImageData.h>
 #include <NFITS/Data/BinTableImageData.h>
 #include <NFITS/HDU.h>
+#include <NFITS/FITSFile.h>
+#include <NFITS/IFITSByteSource.h>
+
+#include "../Util/ThreadPool.h"
+
+#include <algorithm>
 
 namespace NFITS
 {
 
-std::expected<std::unique_ptr<Data>, Error> LoadHDUDataBlocking(const FITSFile* pFile, const HDU* pHDU)
+std::expected<std::unique_ptr<Data>, Error> LoadHDUDataBlocking(const FITSFile* pFile, const HDU* pHDU, const ImageLoadParams& imageParams)
 {
     if (pHDU->ContainsNormalImage())
     {
-        auto pData = LoadImageDataFromFileBlocking(pFile, pHDU);
+        auto pData = LoadImageDataFromFileBlocking(pFile, pHDU, imageParams);
         if (!pData)
         {
             return std::unexpected(pData.error());
@@ -25,7 +31,7 @@ std::expected<std::unique_ptr<Data>, Error> LoadHDUDataBlocking(const FITSFile*
     }
     else if (pHDU->ContainsBinTableImage())
     {
-        auto pData = LoadBinTableImageDataFromFileBlocking(pFile, pHDU);
+        auto pData = LoadBinTableImageDataFromFileBlocking(pFile, pHDU, imageParams);
         if (!pData)
         {
             return std::unexpected(pData.error());
@@ -36,4 +42,71 @@ std::expected<std::unique_ptr<Data>, Error> LoadHDUDataBlocking(const FITSFile*
     return std::unexpected(Error::Msg("LoadHDUDataBlocking: Unsupported HDU type"));
 }
 
+std::vector<std::expected<std::unique_ptr<Data>, Error>> LoadHDUsDataBlocking(const std::vector<HDUDataLoad>& loads,
+                                                                              const ImageLoadParams& imageParams,
+                                                                              std::size_t maxConcurrentLoads)
+{
+    // Loads which are never started, due to cancellation, are left failed
+    std::vector<std::expected<std::unique_ptr<Data>, Error>> results;
+    results.reserve(loads.size());
+
+    for (std::size_t x = 0; x < loads.size(); ++x)
+    {
+        results.emplace_back(std::unexpected(Error::Msg("LoadHDUsDataBlocking: Load was cancelled")));
+    }
+
+    const auto load = [&](std::size_t loadIndex){
+        results[loadIndex] = LoadHDUDataBlocking(loads[loadIndex].pFile, loads[loadIndex].pHDU, imageParams);
+    };
+
+    std::vector<std::size_t> concurrentLoadIndices;
+    std::vector<std::size_t> serialLoadIndices;
+
+    for (std::size_t x = 0; x < loads.size(); ++x)
+    {
+        if (loads[x].pFile->GetByteSource()->SupportsConcurrentReads())
+        {
+            concurrentLoadIndices.push_back(x);
+        }
+        else
+        {
+            serialLoadIndices.push_back(x);
+        }
+    }
+
+    //
+    // Loads from sources which support concurrent reads run on a pool of their own, alongside the calling
+    // thread. Note that it's not the process-wide IO or compute pool, as loads wait on tasks which they submit
+    // to those pools, and so mustn't occupy their threads.
+    //
+    const auto numConcurrentLoads = std::min(concurrentLoadIndices.size(), maxConcurrentLoads);
+
+    if (numConcurrentLoads > 1U)
+    {
+        ThreadPool loadThreadPool(numConcurrentLoads - 1U);
+
+        (void)ParallelForEachIndex(loadThreadPool, concurrentLoadIndices.size(), [&](std::size_t index, std::size_t){
+            load(concurrentLoadIndices[index]);
+            return Result::Success();
+        }, imageParams.isCancelled);
+    }
+    else
+    {
+        serialLoadIndices.insert(serialLoadIndices.end(), concurrentLoadIndices.cbegin(), concurrentLoadIndices.cend());
+        std::ranges::sort(serialLoadIndices);
+    }
+
+    for (const auto& loadIndex : serialLoadIndices)
+    {
+        if (imageParams.isCancelled && imageParams.isCancelled())
+        {
+            break;
+        }
+
+        load(loadIndex);
+    }
+
+    return results;
+}
+
 }
@@ -11,15 +11,24 @@
 #include <NFITS/KeywordCommon.h>
 
 #include "../Util/ImageUtilInternal.h"
+#include "../Image/ImageKernels.h"
 #include "../Image/ImagePipeline.h"
+#include "../Util/ThreadPool.h"
 #include "../WCS/WCSInternal.h"
 
+#include <cstdlib>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <numeric>
 
 namespace NFITS
 {
 
+// Max number of chunks of image data which are in flight at once when reading from a source which doesn't support
+// concurrent reads; one being read, the rest being processed
+static constexpr std::size_t PIPELINED_CHUNK_COUNT = 3;
+
 struct HDUImageMetadata
 {
     int64_t bitpix{0};
@@ -77,58 +86,237 @@ std::expected<HDUImageMetadata, Error> ParseImageMetadata(const HDU* pHDU)
     return metadata;
 }
 
-std::expected<std::vector<double>, Error> ReadDataAsPhysicalValues(const FITSFile* pFile,
-                                                                   const HDU* pHDU,
-                                                                   const HDUImageMetadata& metadata)
+/**
+ * @return Whether an image's values are converted to float32 physical values when loaded, rather than being
+ * stored as they are in the file. Narrower integer values are always stored as-is, as they're already smaller.
+ */
+bool LoadsAsFloat32PhysicalValues(const HDUImageMetadata& metadata, const ImageLoadParams& params)
+{
+    return params.float32PhysicalValues && (std::abs(metadata.bitpix) >= 32);
+}
+
+/**
+ * Reads chunks in order on the calling thread, and hands each chunk off to the compute thread pool to be processed
+ * while the following chunks are read. At most PIPELINED_CHUNK_COUNT chunks are in flight at once, each in its own
+ * READ_CHUNK_BYTE_SIZE buffer; reading a chunk waits for the buffer's previous chunk to have been processed.
+ *
+ * @return Success if every chunk was read and processed; otherwise the first failure, or a failure if cancelled
+ */
+Result ReadChunksPipelined(std::size_t numChunks,
+                           const std::function<Result(std::size_t chunkIndex, std::span<std::byte> chunkBytes)>& readChunk,
+                           const std::function<Result(std::size_t chunkIndex, std::span<const std::byte> chunkBytes)>& processChunk,
+                           const std::function<bool()>& isCancelled)
+{
+    std::vector<std::vector<std::byte>> chunkBuffers(std::min(numChunks, PIPELINED_CHUNK_COUNT));
+    std::vector<std::future<Result>> chunkProcessing(chunkBuffers.size());
+
+    // Waits for every chunk in flight to be processed, as they reference the chunk buffers
+    const auto waitForChunks = [&](){
+        auto result = Result::Success();
+
+        for (auto& processing : chunkProcessing)
+        {
+            if (!processing.valid()) { continue; }
+
+            auto processingResult = processing.get();
+            if (!processingResult && result()) { result = std::move(processingResult); }
+        }
+
+        return result;
+    };
+
+    for (std::size_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+    {
+        const auto bufferIndex = chunkIndex % chunkBuffers.size();
+
+        if (chunkProcessing[bufferIndex].valid())
+        {
+            auto result = chunkProcessing[bufferIndex].get();
+            if (!result) { (void)waitForChunks(); return result; }
+        }
+
+        if (isCancelled && isCancelled())
+        {
+            (void)waitForChunks();
+            return Result::Fail("ReadChunksPipelined: Cancelled");
+        }
+
+        auto& chunkBytes = chunkBuffers[bufferIndex];
+        chunkBytes.resize(static_cast<std::size_t>(READ_CHUNK_BYTE_SIZE.value));
+
+        auto result = readChunk(chunkIndex, chunkBytes);
+        if (!result) { (void)waitForChunks(); return result; }
+
+        chunkProcessing[bufferIndex] = GetComputeThreadPool().Submit([&, chunkIndex, bufferIndex](){
+            return processChunk(chunkIndex, chunkBuffers[bufferIndex]);
+        });
+    }
+
+    return waitForChunks();
+}
+
+/**
+ * An image's values, as loaded, along with the min/max of each of its slices, which is compiled from each chunk
+ * of the values as it's decoded, while it's still in cache
+ */
+struct LoadedImageValues
+{
+    RawImageValues rawValues;
+    std::vector<PhysicalMinMax> sliceMinMaxes;
+};
+
+std::expected<LoadedImageValues, Error> ReadImageValues(const FITSFile* pFile,
+                                                        const HDU* pHDU,
+                                                        const HDUImageMetadata& metadata,
+                                                        const PhysicalValueTransform& transform,
+                                                        const ImageSliceSpan& sliceSpan,
+                                                        const ImageLoadParams& params)
 {
     auto blockSource = FITSBlockSource(pFile->GetByteSource());
 
     const auto dataBlockStartIndex = pHDU->GetDataBlockStartIndex();
-    const auto dataBlockEndIndex = dataBlockStartIndex + pHDU->GetDataBlockCount();
+    const auto dataBlockCount = pHDU->GetDataBlockCount();
+    const auto dataBlockEndIndex = dataBlockStartIndex + dataBlockCount;
     const auto dataByteSize = pHDU->GetDataByteSize();
 
-    const auto numPhysicalValues = std::accumulate(metadata.naxisns.cbegin(), metadata.naxisns.cend(), int64_t{1}, std::multiplies<>());
+    const auto numValues = std::accumulate(metadata.naxisns.cbegin(), metadata.naxisns.cend(), int64_t{1}, std::multiplies<>());
+    const auto bytesPerValue = static_cast<uintmax_t>(std::abs(metadata.bitpix) / 8);
+    const auto toFloat32 = LoadsAsFloat32PhysicalValues(metadata, params);
+
+    //
+    // Allocate storage for the image's values; either in the data type they're stored as in the file, or as
+    // float32 physical values, which each chunk of data is decoded and transformed straight into
+    //
+    auto rawValues = toFloat32 ? RawImageValues(std::vector<float>(static_cast<std::size_t>(numValues)))
+                               : CreateRawImageValues(metadata.bitpix, static_cast<std::size_t>(numValues));
+    if (!rawValues)
+    {
+        return std::unexpected(rawValues.error());
+    }
 
-    std::vector<double> physicalValues;
-    physicalValues.reserve(static_cast<std::size_t>(numPhysicalValues));
+    const auto storedValues = PhysicalValuesView(*rawValues, toFloat32 ? PhysicalValueTransform{} : transform);
 
-    uintmax_t numBytesRead = 0;
-    BlockBytes blockBytes{};
+    //
+    // The data is loaded in chunks of READ_CHUNK_BLOCK_COUNT blocks. Every chunk's values land at a known offset
+    // within the values allocated above, so that chunks can be loaded in any order, and in parallel. Each chunk
+    // is decoded, and then the min/max of the slices it overlaps is compiled from its values while they're still
+    // in cache, rather than in a pass of its own over the whole image.
+    //
+    const auto numChunks = static_cast<std::size_t>((dataBlockCount + READ_CHUNK_BLOCK_COUNT - 1U) / READ_CHUNK_BLOCK_COUNT);
 
-    for (uintmax_t blockIndex = dataBlockStartIndex; blockIndex < dataBlockEndIndex; ++blockIndex)
-    {
-        const uintmax_t remainingDataBytes = dataByteSize - numBytesRead;
+    std::vector<std::vector<std::pair<uint64_t, PhysicalMinMax>>> chunkSliceMinMaxes(numChunks);
 
-        if (!blockSource.ReadBlock(blockBytes, blockIndex))
+    const auto getChunkBlockRange = [&](std::size_t chunkIndex){
+        const auto blockIndex = dataBlockStartIndex + (static_cast<uintmax_t>(chunkIndex) * READ_CHUNK_BLOCK_COUNT);
+        return std::make_pair(blockIndex, std::min(dataBlockEndIndex - blockIndex, uintmax_t{READ_CHUNK_BLOCK_COUNT}));
+    };
+
+    const auto getChunkByteRange = [&](std::size_t chunkIndex){
+        const auto chunkByteOffset = static_cast<uintmax_t>(chunkIndex) * READ_CHUNK_BYTE_SIZE.value;
+        return std::make_pair(chunkByteOffset, std::min(dataByteSize - chunkByteOffset, READ_CHUNK_BYTE_SIZE.value));
+    };
+
+    const auto processChunk = [&](std::size_t chunkIndex, std::span<const std::byte> chunkBytes){
+        const auto [chunkByteOffset, chunkDataBytes] = getChunkByteRange(chunkIndex);
+        const auto chunkData = chunkBytes.subspan(0, static_cast<std::size_t>(chunkDataBytes));
+
+        const auto valueOffset = static_cast<std::size_t>(chunkByteOffset / bytesPerValue);
+        const auto numChunkValues = static_cast<std::size_t>(chunkDataBytes / bytesPerValue);
+
+        if ((valueOffset > storedValues.size()) || (numChunkValues > (storedValues.size() - valueOffset)))
         {
-            return std::unexpected(Error::Msg("Failed to read data block"));
+            return Result::Fail("Data doesn't fit within the image's values");
         }
 
-        const uintmax_t blockDataBytes = std::min(remainingDataBytes, BLOCK_BYTE_SIZE.value);
-        const auto blockDataSpan = std::span<std::byte>(blockBytes.data(), blockDataBytes);
+        const auto result = toFloat32 ?
+            DecodeBigEndianToPhysicalValues(chunkData, metadata.bitpix, transform,
+                                            std::span<float>(std::get<std::vector<float>>(*rawValues)).subspan(valueOffset, numChunkValues)) :
+            DecodeRawImageData(chunkData, *rawValues, valueOffset);
+        if (!result)
+        {
+            return result;
+        }
+
+        chunkSliceMinMaxes[chunkIndex] = CalculateSliceMinMaxes(storedValues.subspan(valueOffset, numChunkValues), valueOffset, sliceSpan);
+
+        return Result::Success();
+    };
 
-        const auto blockPhysicalValues = RawImageDataToPhysicalValues(blockDataSpan,
-                                                                      metadata.bitpix,
-                                                                      metadata.bZero,
-                                                                      metadata.bScale,
-                                                                      metadata.blank);
-        if (!blockPhysicalValues)
+    blockSource.AdviseBlocks(dataBlockStartIndex, dataBlockCount, ByteAccessHint::Sequential);
+
+    const auto result = [&](){
+        //
+        // If the source holds the data in addressable memory, process all of it directly from the source's
+        // memory, one chunk per compute thread at a time
+        //
+        if (const auto dataView = blockSource.GetBlocksView(dataBlockStartIndex, dataBlockCount))
         {
-            return std::unexpected(Error::Msg("Failed to convert data to physical values"));
+            return ParallelForEachIndex(GetComputeThreadPool(), numChunks, [&](std::size_t chunkIndex, std::size_t){
+                return processChunk(chunkIndex, dataView->subspan(static_cast<std::size_t>(getChunkByteRange(chunkIndex).first)));
+            }, params.isCancelled);
         }
 
-        for (const auto& physicalValue : *blockPhysicalValues)
+        //
+        // Otherwise, if the source supports concurrent reads, each compute thread reads a chunk of blocks into
+        // its own buffer and then processes it, so that reads and processing of different chunks overlap
+        //
+        if (blockSource.GetByteSource()->SupportsConcurrentReads())
         {
-            physicalValues.push_back(physicalValue);
+            std::vector<std::vector<std::byte>> workerChunkBytes(GetComputeThreadPool().GetThreadCount() + 1U);
+
+            return ParallelForEachIndex(GetComputeThreadPool(), numChunks, [&](std::size_t chunkIndex, std::size_t workerIndex){
+                const auto [blockIndex, chunkBlockCount] = getChunkBlockRange(chunkIndex);
+
+                auto& chunkBytes = workerChunkBytes.at(workerIndex);
+                chunkBytes.resize(static_cast<std::size_t>(READ_CHUNK_BYTE_SIZE.value));
+
+                if (!blockSource.ReadBlocks(chunkBytes, blockIndex, chunkBlockCount))
+                {
+                    return Result::Fail("Failed to read data blocks");
+                }
+
+                return processChunk(chunkIndex, chunkBytes);
+            }, params.isCancelled);
         }
 
-        numBytesRead += blockDataBytes;
+        //
+        // Otherwise, pipeline the load: this thread reads the chunks in order, as the source requires, and hands
+        // each chunk off to the compute threads to be processed while it reads the following chunks. At most
+        // PIPELINED_CHUNK_COUNT chunks are in flight at once, each in its own buffer.
+        //
+        return ReadChunksPipelined(numChunks, [&](std::size_t chunkIndex, std::span<std::byte> chunkBytes){
+            const auto [blockIndex, chunkBlockCount] = getChunkBlockRange(chunkIndex);
+            return blockSource.ReadBlocks(chunkBytes, blockIndex, chunkBlockCount);
+        }, processChunk, params.isCancelled);
+    }();
+
+    if (!result)
+    {
+        return std::unexpected(Error::Msg("Failed to load image data: {}", result.error->msg));
+    }
+
+    //
+    // Merge the chunks' min/max of the slices they overlap
+    //
+    std::vector<PhysicalMinMax> sliceMinMaxes(static_cast<std::size_t>(GetNumSlicesInSpan(sliceSpan)));
+
+    for (const auto& sliceMinMaxesOfChunk : chunkSliceMinMaxes)
+    {
+        for (const auto& [sliceIndex, sliceMinMax] : sliceMinMaxesOfChunk)
+        {
+            sliceMinMaxes.at(static_cast<std::size_t>(sliceIndex)).Merge(sliceMinMax);
+        }
     }
 
-    return physicalValues;
+    return LoadedImageValues{
+        .rawValues = std::move(*rawValues),
+        .sliceMinMaxes = std::move(sliceMinMaxes)
+    };
 }
 
-std::expected<std::unique_ptr<ImageData>, Error> LoadImageDataFromFileBlocking(const FITSFile* pFile, const HDU* pHDU)
+std::expected<std::unique_ptr<ImageData>, Error> LoadImageDataFromFileBlocking(const FITSFile* pFile,
+                                                                   const HDU* pHDU,
+                                                                   const ImageLoadParams& params)
 {
     //
     // Sanity test that the HDU actually contains image data
@@ -154,47 +342,61 @@ std::expected<std::unique_ptr<ImageData>, Error> LoadImageDataFromFileBlocking(c
     }
 
     //
-    // Read the HDU data, transformed to physical values
+    // Create an ImageSliceSpan which defines the dimensionality of the image, built from naxisn metadata
     //
-    auto physicalValues = ReadDataAsPhysicalValues(pFile, pHDU, *metadata);
-    if (!physicalValues)
+    const auto sliceSpan = NaxisnsToSliceSpan(metadata->naxisns);
+    if (!sliceSpan)
     {
-        return std::unexpected(physicalValues.error());
+        return std::unexpected(sliceSpan.error());
     }
 
     //
-    // Create an ImageSliceSpan which defines the dimensionality of the image, built from naxisn metadata
+    // Read the HDU data, as stored in the file. Physical values are only derived from the stored values when
+    // they're accessed, so that integer images aren't held in memory at the size of doubles. If loading float32
+    // physical values, the transform is instead applied as the data is read.
     //
-    const auto sliceSpan = NaxisnsToSliceSpan(metadata->naxisns);
-    if (!sliceSpan)
+    const auto fileTransform = PhysicalValueTransform{
+        .zero = metadata->bZero,
+        .scale = metadata->bScale,
+        .blank = metadata->blank
+    };
+
+    auto imageValues = ReadImageValues(pFile, pHDU, *metadata, fileTransform, *sliceSpan, params);
+    if (!imageValues)
     {
-        return std::unexpected(sliceSpan.error());
+        return std::unexpected(imageValues.error());
     }
 
+    const auto transform = LoadsAsFloat32PhysicalValues(*metadata, params) ? PhysicalValueTransform{} : fileTransform;
+
     //
-    // Calculate slice statistics
+    // Calculate slice statistics, from the slices' min/max compiled as the image's values were loaded
     //
-    const auto slicePhysicalStats = CalculateSlicePhysicalStats(*physicalValues, *sliceSpan);
-    const auto sliceCubePhysicalStats = CalculateSliceCubePhysicalStats(*physicalValues, *sliceSpan);
+    auto physicalStats = CalculateImagePhysicalStats(PhysicalValuesView(imageValues->rawValues, transform),
+                                                     *sliceSpan,
+                                                     imageValues->sliceMinMaxes);
 
     return std::make_unique<ImageData>(
         *sliceSpan,
-        std::move(*physicalValues),
-        slicePhysicalStats,
-        sliceCubePhysicalStats,
+        std::move(imageValues->rawValues),
+        transform,
+        std::move(physicalStats.slicePhysicalStats),
+        std::move(physicalStats.sliceCubePhysicalStats),
         metadata->bUnit,
         *wcsParams
     );
 }
 
 ImageData::ImageData(ImageSliceSpan sliceSpan,
-                     std::vector<double> physicalValues,
+                     RawImageValues rawValues,
+                     PhysicalValueTransform transform,
                      std::vector<PhysicalStats> slicePhysicalStats,
                      std::vector<PhysicalStats> sliceCubePhysicalStats,
                      std::optional<std::string> physicalUnit,
                      std::optional<WCSParams> wcsParams)
     : m_sliceSpan(std::move(sliceSpan))
-    , m_physicalValues(std::move(physicalValues))
+    , m_rawValues(std::move(rawValues))
+    , m_transform(std::move(transform))
     , m_slicePhysicalStats(std::move(slicePhysicalStats))
     , m_sliceCubePhysicalStats(std::move(sliceCubePhysicalStats))
     , m_physicalUnit(std::move(physicalUnit))
@@ -203,6 +405,11 @@ ImageData::ImageData(ImageSliceSpan sliceSpan,
 
 }
 
+PhysicalValuesView ImageData::GetPhysicalValues() const
+{
+    return {m_rawValues, m_transform};
+}
+
 std::optional<uintmax_t> ImageData::GetSliceIndex(const ImageSliceKey& sliceKey) const
 {
     const auto sliceIndex = SliceKeyToLinearIndex(m_sliceSpan, sliceKey);
@@ -259,10 +466,7 @@ std::optional<ImageSlice> ImageData::GetImageSlice(const ImageSliceKey& sliceKey
         return std::nullopt;
     }
 
-    const auto slicePhysicalValues = std::span<const double>(
-        m_physicalValues.data() + (*sliceIndex * sliceDataSize),
-        sliceDataSize
-    );
+    const auto slicePhysicalValues = GetPhysicalValues().subspan(*sliceIndex * sliceDataSize, sliceDataSize);
 
     return ImageSlice{
         .width = static_cast<uint64_t>(sliceWidth),
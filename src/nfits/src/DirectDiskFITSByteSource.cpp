@@ -0,0 +1,410 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/DirectDiskFITSByteSource.h>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#include <NFITS/Def.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace NFITS
+{
+
+// Max number of bytes transferred by one read call; a multiple of the direct I/O alignment
+static constexpr std::size_t MAX_TRANSFER_BYTE_SIZE = 1U << 30U;
+
+static constexpr auto DIRECT_IO_ALIGNMENT = std::align_val_t{DIRECT_IO_ALIGNMENT_BYTE_SIZE.value};
+
+// Max size of the bounce buffer that unaligned reads go through; room for a chunk, widened out to aligned offsets
+// on either side, so that an unaligned read of up to a chunk is still one direct read
+static constexpr std::size_t BOUNCE_BUFFER_BYTE_SIZE = DIRECT_IO_CHUNK_BYTE_SIZE.value + (2U * DIRECT_IO_ALIGNMENT_BYTE_SIZE.value);
+
+namespace
+{
+    struct AlignedDelete
+    {
+        void operator()(std::byte* pBytes) const { ::operator delete[](pBytes, DIRECT_IO_ALIGNMENT); }
+    };
+
+    using AlignedBuffer = std::unique_ptr<std::byte[], AlignedDelete>;
+
+    AlignedBuffer CreateAlignedBuffer(std::size_t byteSize)
+    {
+        return AlignedBuffer(static_cast<std::byte*>(::operator new[](byteSize, DIRECT_IO_ALIGNMENT)));
+    }
+
+    bool IsAligned(uintmax_t value)
+    {
+        return (value % DIRECT_IO_ALIGNMENT_BYTE_SIZE.value) == 0;
+    }
+}
+
+//
+// Bounce buffers which reads borrow, rather than allocating one per read. A borrowed buffer too small for a read
+// replaces a free one, so the pool holds no more buffers than the most reads that have been in flight at once.
+//
+struct DirectDiskFITSByteSource::BounceBufferPool
+{
+    struct Buffer
+    {
+        AlignedBuffer pBytes;
+        std::size_t byteSize{0};
+    };
+
+    // Returns its buffer to the pool when destroyed
+    class Lease
+    {
+        public:
+
+            Lease(BounceBufferPool& pool, Buffer buffer) : m_pool(pool), m_buffer(std::move(buffer)) {}
+            ~Lease() { m_pool.Release(std::move(m_buffer)); }
+
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            [[nodiscard]] std::byte* GetBytes() const noexcept { return m_buffer.pBytes.get(); }
+
+        private:
+
+            BounceBufferPool& m_pool;
+            Buffer m_buffer;
+    };
+
+    [[nodiscard]] Lease Acquire(std::size_t byteSize)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            const auto it = std::ranges::find_if(freeBuffers, [&](const Buffer& buffer){ return buffer.byteSize >= byteSize; });
+            if (it != freeBuffers.cend())
+            {
+                auto buffer = std::move(*it);
+                freeBuffers.erase(it);
+                return {*this, std::move(buffer)};
+            }
+
+            // None are large enough; drop a free one, which this read's buffer takes the place of
+            if (!freeBuffers.empty())
+            {
+                freeBuffers.pop_back();
+            }
+        }
+
+        return {*this, Buffer{.pBytes = CreateAlignedBuffer(byteSize), .byteSize = byteSize}};
+    }
+
+    void Release(Buffer buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBuffers.push_back(std::move(buffer));
+    }
+
+    std::mutex mutex;
+    std::vector<Buffer> freeBuffers;
+};
+
+std::expected<std::unique_ptr<DirectDiskFITSByteSource>, Error> DirectDiskFITSByteSource::Open(const std::filesystem::path& filePath)
+{
+    auto source = std::make_unique<DirectDiskFITSByteSource>(Tag{}, filePath);
+
+    const auto result = source->OpenFile();
+    if (!result)
+    {
+        return std::unexpected(*result.error);
+    }
+
+    return source;
+}
+
+DirectDiskFITSByteSource::DirectDiskFITSByteSource(DirectDiskFITSByteSource::Tag, std::filesystem::path filePath)
+    : m_filePath(std::move(filePath))
+    , m_pBounceBufferPool(std::make_unique<BounceBufferPool>())
+{
+
+}
+
+DirectDiskFITSByteSource::~DirectDiskFITSByteSource()
+{
+    CloseFile();
+}
+
+Result DirectDiskFITSByteSource::Resize(const ByteSize&)
+{
+    return Result::Fail("DirectDiskFITSByteSource::Resize: Source is read-only");
+}
+
+Result DirectDiskFITSByteSource::WriteBytes(std::span<const std::byte>, const ByteOffset&, const ByteSize&, bool)
+{
+    return Result::Fail("DirectDiskFITSByteSource::WriteBytes: Source is read-only");
+}
+
+Result DirectDiskFITSByteSource::Flush()
+{
+    // no-op, nothing is ever written to the source
+
+    return Result::Success();
+}
+
+Result DirectDiskFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("DirectDiskFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    if (byteSize.value == 0)
+    {
+        return Result::Success();
+    }
+
+    if (!m_isDirect)
+    {
+        const auto result = ReadInto(dst, byteOffset, byteSize);
+
+    #if defined(__linux__)
+        // Not read directly, so drop the read's pages from the page cache instead
+        (void)posix_fadvise(m_fd, static_cast<off_t>(byteOffset.value), static_cast<off_t>(byteSize.value), POSIX_FADV_DONTNEED);
+    #endif
+
+        return result;
+    }
+
+    const bool isAligned = IsAligned(byteOffset.value) &&
+                           IsAligned(byteSize.value) &&
+                           IsAligned(reinterpret_cast<std::uintptr_t>(dst.data()));
+
+    if (isAligned)
+    {
+        return ReadInto(dst, byteOffset, byteSize);
+    }
+
+    return ReadViaBounceBuffer(dst, byteOffset, byteSize);
+}
+
+Result DirectDiskFITSByteSource::ReadInto(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const
+{
+    uintmax_t numBytesRead = 0;
+
+    // Reads may return fewer bytes than requested; keep reading until the full range has been read
+    while (numBytesRead < byteSize.value)
+    {
+        const auto toRead = static_cast<std::size_t>(std::min<uintmax_t>(byteSize.value - numBytesRead, MAX_TRANSFER_BYTE_SIZE));
+
+        const auto chunkBytesRead = ReadAt(dst.data() + numBytesRead, byteOffset.value + numBytesRead, toRead);
+        if (!chunkBytesRead)
+        {
+            return Result::Fail(chunkBytesRead.error());
+        }
+
+        if (*chunkBytesRead == 0)
+        {
+            return Result::Fail("DirectDiskFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+        }
+
+        numBytesRead += *chunkBytesRead;
+    }
+
+    return Result::Success();
+}
+
+Result DirectDiskFITSByteSource::ReadViaBounceBuffer(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const
+{
+    const auto alignment = DIRECT_IO_ALIGNMENT_BYTE_SIZE.value;
+
+    //
+    // Widen the requested range out to the nearest aligned offsets on either side
+    //
+    const auto endOffset = byteOffset.value + byteSize.value;
+    const auto alignedStartOffset = (byteOffset.value / alignment) * alignment;
+    const auto alignedEndOffset = ((endOffset + alignment - 1U) / alignment) * alignment;
+
+    const auto bounceByteSize = static_cast<std::size_t>(std::min<uintmax_t>(alignedEndOffset - alignedStartOffset, BOUNCE_BUFFER_BYTE_SIZE));
+
+    const auto bounceBuffer = m_pBounceBufferPool->Acquire(bounceByteSize);
+
+    for (auto chunkStartOffset = alignedStartOffset; chunkStartOffset < endOffset; chunkStartOffset += bounceByteSize)
+    {
+        const auto chunkByteSize = static_cast<std::size_t>(std::min<uintmax_t>(bounceByteSize, alignedEndOffset - chunkStartOffset));
+
+        // One read per chunk; a direct read only returns fewer bytes than requested at the end of the file, and
+        // any follow-up read would be unaligned
+        const auto chunkBytesRead = ReadAt(bounceBuffer.GetBytes(), chunkStartOffset, chunkByteSize);
+        if (!chunkBytesRead)
+        {
+            return Result::Fail(chunkBytesRead.error());
+        }
+
+        const auto copyStartOffset = std::max(chunkStartOffset, byteOffset.value);
+        const auto copyEndOffset = std::min(chunkStartOffset + chunkByteSize, endOffset);
+
+        if ((chunkStartOffset + *chunkBytesRead) < copyEndOffset)
+        {
+            return Result::Fail("DirectDiskFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+        }
+
+        std::memcpy(dst.data() + (copyStartOffset - byteOffset.value),
+                    bounceBuffer.GetBytes() + (copyStartOffset - chunkStartOffset),
+                    static_cast<std::size_t>(copyEndOffset - copyStartOffset));
+    }
+
+    return Result::Success();
+}
+
+#if defined(_WIN32)
+
+std::expected<ByteSize, Error> DirectDiskFITSByteSource::GetByteSize() const
+{
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(static_cast<HANDLE>(m_hFile), &fileSize))
+    {
+        return std::unexpected(Error::Msg("DirectDiskFITSByteSource::GetByteSize: Call to GetFileSizeEx() failed"));
+    }
+
+    return ByteSize{static_cast<uintmax_t>(fileSize.QuadPart)};
+}
+
+std::expected<std::size_t, Error> DirectDiskFITSByteSource::ReadAt(std::byte* pDst, uintmax_t byteOffset, std::size_t byteSize) const
+{
+    // An OVERLAPPED with an offset makes the read positional, independent of the handle's file pointer
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(byteOffset & 0xFFFFFFFFU);
+    overlapped.OffsetHigh = static_cast<DWORD>(byteOffset >> 32U);
+
+    DWORD bytesRead = 0;
+
+    if (!ReadFile(static_cast<HANDLE>(m_hFile), pDst, static_cast<DWORD>(byteSize), &bytesRead, &overlapped))
+    {
+        if (GetLastError() == ERROR_HANDLE_EOF)
+        {
+            return 0U;
+        }
+
+        return std::unexpected(Error::Msg("DirectDiskFITSByteSource::ReadBytes: Call to ReadFile() failed"));
+    }
+
+    return static_cast<std::size_t>(bytesRead);
+}
+
+Result DirectDiskFITSByteSource::OpenFile()
+{
+    const auto hFile = CreateFileW(
+        m_filePath.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return Result::Fail("DirectDiskFITSByteSource: Failed to open the file");
+    }
+
+    m_hFile = hFile;
+    m_isDirect = true;
+
+    return Result::Success();
+}
+
+void DirectDiskFITSByteSource::CloseFile()
+{
+    if (m_hFile != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(m_hFile));
+        m_hFile = nullptr;
+    }
+}
+
+#else
+
+std::expected<ByteSize, Error> DirectDiskFITSByteSource::GetByteSize() const
+{
+    struct stat fileStat{};
+    if (fstat(m_fd, &fileStat) != 0)
+    {
+        return std::unexpected(Error::Msg("DirectDiskFITSByteSource::GetByteSize: Call to fstat() failed"));
+    }
+
+    return ByteSize{static_cast<uintmax_t>(fileStat.st_size)};
+}
+
+std::expected<std::size_t, Error> DirectDiskFITSByteSource::ReadAt(std::byte* pDst, uintmax_t byteOffset, std::size_t byteSize) const
+{
+    while (true)
+    {
+        const auto result = pread(m_fd, pDst, byteSize, static_cast<off_t>(byteOffset));
+        if (result >= 0)
+        {
+            return static_cast<std::size_t>(result);
+        }
+
+        if (errno != EINTR)
+        {
+            return std::unexpected(Error::Msg("DirectDiskFITSByteSource::ReadBytes: Call to pread() failed, errno: {}", errno));
+        }
+    }
+}
+
+Result DirectDiskFITSByteSource::OpenFile()
+{
+#if defined(__linux__)
+    m_fd = open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    m_isDirect = m_fd >= 0;
+
+    // Some filesystems don't support O_DIRECT, and reject it with EINVAL; fall back to normal reads
+    if ((m_fd < 0) && (errno == EINVAL))
+    {
+        m_fd = open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+#else
+    m_fd = open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+
+    if (m_fd < 0)
+    {
+        return Result::Fail("DirectDiskFITSByteSource: Failed to open the file, errno: {}", errno);
+    }
+
+#if defined(__APPLE__)
+    m_isDirect = fcntl(m_fd, F_NOCACHE, 1) != -1;
+#endif
+
+    return Result::Success();
+}
+
+void DirectDiskFITSByteSource::CloseFile()
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+#endif
+
+}
@@ -50,4 +50,35 @@ Result FITSBlockSource::WriteBlock(BlockCSpan src, const uintmax_t& blockIndex,
     return m_pByteSource->WriteBytes(src, ByteOffset(BLOCK_BYTE_SIZE * blockIndex), BLOCK_BYTE_SIZE, flush);
 }
 
+Result FITSBlockSource::ReadBlocks(std::span<std::byte> dst, const uintmax_t& blockStartIndex, const uintmax_t& blockCount)
+{
+    return m_pByteSource->ReadBytes(dst, ByteOffset(BLOCK_BYTE_SIZE * blockStartIndex), BLOCK_BYTE_SIZE * blockCount);
+}
+
+Result FITSBlockSource::WriteBlocks(std::span<const std::byte> src, const uintmax_t& blockStartIndex, const uintmax_t& blockCount, bool flush)
+{
+    return m_pByteSource->WriteBytes(src, ByteOffset(BLOCK_BYTE_SIZE * blockStartIndex), BLOCK_BYTE_SIZE * blockCount, flush);
+}
+
+Result FITSBlockSource::ReadSpan(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    return m_pByteSource->ReadBytes(dst, byteOffset, byteSize);
+}
+
+std::future<Result> FITSBlockSource::ReadSpanAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    return m_pByteSource->ReadBytesAsync(dst, byteOffset, byteSize);
+}
+
+std::optional<std::span<const std::byte>> FITSBlockSource::GetBlocksView(const uintmax_t& blockStartIndex,
+                                                                         const uintmax_t& blockCount) const
+{
+    return m_pByteSource->GetBytesView(ByteOffset(BLOCK_BYTE_SIZE * blockStartIndex), BLOCK_BYTE_SIZE * blockCount);
+}
+
+void FITSBlockSource::AdviseBlocks(const uintmax_t& blockStartIndex, const uintmax_t& blockCount, ByteAccessHint hint)
+{
+    m_pByteSource->AdviseAccess(ByteOffset(BLOCK_BYTE_SIZE * blockStartIndex), BLOCK_BYTE_SIZE * blockCount, hint);
+}
+
 }
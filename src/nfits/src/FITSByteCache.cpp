@@ -0,0 +1,250 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/FITSByteCache.h>
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+
+namespace NFITS
+{
+
+struct PageKey
+{
+    bool operator==(const PageKey&) const = default;
+
+    uint64_t keyId{0};
+    uintmax_t pageIndex{0};
+};
+
+// splitmix64 finalizer; spreads keys evenly across both shards and hash buckets
+inline uint64_t MixPageKey(const PageKey& key)
+{
+    uint64_t x = key.keyId ^ (static_cast<uint64_t>(key.pageIndex) * 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31U);
+}
+
+struct PageKeyHash
+{
+    std::size_t operator()(const PageKey& key) const noexcept { return static_cast<std::size_t>(MixPageKey(key)); }
+};
+
+struct CachedPage
+{
+    PageKey key;
+    std::vector<std::byte> bytes;
+};
+
+struct FITSByteCache::Shard
+{
+    mutable std::mutex mutex;
+
+    // Cached pages, ordered from most recently used to least recently used
+    std::list<CachedPage> lru;
+
+    std::unordered_map<PageKey, std::list<CachedPage>::iterator, PageKeyHash> pages;
+
+    uintmax_t residentByteSize{0};
+};
+
+FITSByteCache::FITSByteCache(const FITSByteCacheParams& params)
+    : m_byteBudget(params.byteBudget)
+    , m_pageByteSize(BLOCK_BYTE_SIZE * std::max(params.pageBlockCount, uintmax_t{1}))
+    , m_shardByteBudget(params.byteBudget.value / std::max(params.shardCount, std::size_t{1}))
+{
+    for (std::size_t x = 0; x < std::max(params.shardCount, std::size_t{1}); ++x)
+    {
+        m_shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+FITSByteCache::~FITSByteCache() = default;
+
+FITSByteCacheStats FITSByteCache::GetStats() const
+{
+    FITSByteCacheStats stats{};
+    stats.hits = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.evictions = m_evictions.load();
+
+    for (const auto& pShard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(pShard->mutex);
+        stats.residentByteSize += pShard->residentByteSize;
+    }
+
+    return stats;
+}
+
+void FITSByteCache::Clear()
+{
+    for (const auto& pShard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(pShard->mutex);
+        pShard->pages.clear();
+        pShard->lru.clear();
+        pShard->residentByteSize = 0;
+    }
+}
+
+uint64_t FITSByteCache::GetKeyId(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(m_keysMutex);
+
+    const auto it = m_keyIds.find(key);
+    if (it != m_keyIds.cend())
+    {
+        return it->second;
+    }
+
+    const auto keyId = m_nextKeyId++;
+    m_keyIds.insert({key, keyId});
+
+    return keyId;
+}
+
+uint64_t FITSByteCache::GetUniqueKeyId()
+{
+    std::lock_guard<std::mutex> lock(m_keysMutex);
+
+    return m_nextKeyId++;
+}
+
+bool FITSByteCache::ReadPage(uint64_t keyId, uintmax_t pageIndex, uintmax_t pageByteOffset, std::span<std::byte> dst)
+{
+    const auto key = PageKey{.keyId = keyId, .pageIndex = pageIndex};
+    auto& shard = GetShard(keyId, pageIndex);
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const auto it = shard.pages.find(key);
+        if ((it != shard.pages.cend()) && (pageByteOffset + dst.size() <= it->second->bytes.size()))
+        {
+            // Mark the page as most recently used
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+
+            if (!dst.empty())
+            {
+                memcpy(dst.data(), it->second->bytes.data() + pageByteOffset, dst.size());
+            }
+
+            m_hits++;
+            return true;
+        }
+    }
+
+    m_misses++;
+    return false;
+}
+
+bool FITSByteCache::ContainsPage(uint64_t keyId, uintmax_t pageIndex)
+{
+    const auto& shard = GetShard(keyId, pageIndex);
+
+    bool containsPage = false;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        containsPage = shard.pages.contains(PageKey{.keyId = keyId, .pageIndex = pageIndex});
+    }
+
+    if (!containsPage)
+    {
+        m_misses++;
+    }
+
+    return containsPage;
+}
+
+void FITSByteCache::InsertPage(uint64_t keyId, uintmax_t pageIndex, std::span<const std::byte> pageBytes)
+{
+    const auto key = PageKey{.keyId = keyId, .pageIndex = pageIndex};
+    auto& shard = GetShard(keyId, pageIndex);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto it = shard.pages.find(key);
+    if (it != shard.pages.cend())
+    {
+        shard.residentByteSize -= it->second->bytes.size();
+        it->second->bytes.assign(pageBytes.begin(), pageBytes.end());
+        shard.residentByteSize += it->second->bytes.size();
+
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    }
+    else
+    {
+        shard.lru.push_front(CachedPage{.key = key, .bytes = std::vector<std::byte>(pageBytes.begin(), pageBytes.end())});
+        shard.pages.insert({key, shard.lru.begin()});
+        shard.residentByteSize += pageBytes.size();
+    }
+
+    // Evict least recently used pages until the shard is within budget. The page which was just inserted is
+    // always kept, even if it alone is over budget.
+    while ((shard.residentByteSize > m_shardByteBudget) && (shard.lru.size() > 1))
+    {
+        const auto& evictPage = shard.lru.back();
+
+        shard.residentByteSize -= evictPage.bytes.size();
+        shard.pages.erase(evictPage.key);
+        shard.lru.pop_back();
+
+        m_evictions++;
+    }
+}
+
+void FITSByteCache::InvalidatePage(uint64_t keyId, uintmax_t pageIndex)
+{
+    const auto key = PageKey{.keyId = keyId, .pageIndex = pageIndex};
+    auto& shard = GetShard(keyId, pageIndex);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto it = shard.pages.find(key);
+    if (it == shard.pages.cend())
+    {
+        return;
+    }
+
+    shard.residentByteSize -= it->second->bytes.size();
+    shard.lru.erase(it->second);
+    shard.pages.erase(it);
+}
+
+void FITSByteCache::InvalidateKey(uint64_t keyId)
+{
+    for (const auto& pShard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(pShard->mutex);
+
+        for (auto it = pShard->lru.begin(); it != pShard->lru.end();)
+        {
+            if (it->key.keyId == keyId)
+            {
+                pShard->residentByteSize -= it->bytes.size();
+                pShard->pages.erase(it->key);
+                it = pShard->lru.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+FITSByteCache::Shard& FITSByteCache::GetShard(uint64_t keyId, uintmax_t pageIndex) const
+{
+    // Use the high bits of the key's hash to select a shard, as the low bits select hash buckets within the shard
+    const auto hash = MixPageKey(PageKey{.keyId = keyId, .pageIndex = pageIndex});
+
+    return *m_shards[static_cast<std::size_t>((hash >> 32U) % m_shards.size())];
+}
+
+}
@@ -10,76 +10,218 @@
 #include <NFITS/KeywordRecord.h>
 #include <NFITS/KeywordCommon.h>
 
+#include "FITSFileInternal.h"
+#include "HDUIndex.h"
+#include "Parsing.h"
+
 #include <numeric>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <string_view>
 
 namespace NFITS
 {
 
-std::expected<Header, Error> ReadHeader(FITSBlockSource& blockSource, uintmax_t blockStartIndex)
+// Number of header blocks which are read from the byte source at a time. Most headers are only a few blocks
+// long, so reading a small batch of blocks at once usually reads an entire header with one read.
+static constexpr uintmax_t HEADER_READ_BLOCK_COUNT = 4U;
+
+HeaderBlockScan ParseHeaderBlock(std::span<const std::byte> blockData, HeaderBlock& headerBlock)
+{
+    // Interpret the block's bytes as keyword records which fill the HeaderBlock
+    for (unsigned int keywordRecordIndex = 0; keywordRecordIndex < KEYWORD_RECORDS_PER_HEADER_BLOCK; ++keywordRecordIndex)
+    {
+        const auto keywordRecordByteOffset = keywordRecordIndex * KEYWORD_RECORD_BYTE_SIZE;
+
+        const auto keywordRecordSpan = KeywordRecordCSpan{
+            reinterpret_cast<const char*>(blockData.data()) + keywordRecordByteOffset.value,
+            KEYWORD_RECORD_BYTE_SIZE.value
+        };
+
+        headerBlock.keywordRecords[keywordRecordIndex] = KeywordRecord::FromRaw(keywordRecordSpan);
+    }
+
+    // Note that a record's keyword name is validly END exactly when its keyword name field is END padded with
+    // spaces, so the records don't need to be parsed to find it
+    return ScanHeaderBlock(blockData.first<BLOCK_BYTE_SIZE.value>());
+}
+
+/**
+ * Reads the header blocks starting at blockStartIndex, up to and including the block which contains an END
+ * keyword, passing each block's bytes to onBlock. onBlock returns whether the block contains an END keyword.
+ */
+template <typename OnBlock>
+Result ReadHeaderBlocks(FITSBlockSource& blockSource, uintmax_t blockStartIndex, OnBlock&& onBlock)
 {
     auto blockCount = blockSource.GetNumBlocks();
     if (!blockCount)
     {
-        return std::unexpected(Error::Msg("ReadHeader: Unable to determine number of blocks in the source"));
+        return Result::Fail("ReadHeader: Unable to determine number of blocks in the source");
     }
 
     if (blockStartIndex >= *blockCount)
     {
-        return std::unexpected(Error::Msg("ReadHeader: Block index is out of bounds"));
+        return Result::Fail("ReadHeader: Block index is out of bounds");
     }
 
     //
-    // Iterate over blocks starting at blockStartIndex, reading the block data as a HeaderBlock, until we find an END keyword
+    // Iterate over batches of blocks starting at blockStartIndex, passing each block's data to onBlock,
+    // until we find an END keyword
     //
-    Header header{};
-    BlockBytes blockBytes{};
+    std::array<std::byte, HEADER_READ_BLOCK_COUNT * BLOCK_BYTE_SIZE.value> batchBytes{};
     bool foundEndKeyword = false;
 
-    for (uintmax_t blockIndex = blockStartIndex; blockIndex < *blockCount; ++blockIndex)
+    for (uintmax_t batchStartIndex = blockStartIndex; (batchStartIndex < *blockCount) && !foundEndKeyword; batchStartIndex += HEADER_READ_BLOCK_COUNT)
     {
-        // Read the block's bytes from the source into memory
-        if (!blockSource.ReadBlock(blockBytes, blockIndex))
+        const auto batchBlockCount = std::min(HEADER_READ_BLOCK_COUNT, *blockCount - batchStartIndex);
+
+        // Let the source know the batch's blocks are about to be needed
+        blockSource.AdviseBlocks(batchStartIndex, batchBlockCount, ByteAccessHint::WillNeed);
+
+        // Access the batch's bytes directly if the source can provide a view of them, otherwise read
+        // the batch's bytes from the source into memory
+        std::span<const std::byte> batchData;
+
+        if (const auto batchView = blockSource.GetBlocksView(batchStartIndex, batchBlockCount))
         {
-            return std::unexpected(Error::Msg("ReadHeader: Failed to read block {} from the block source", blockIndex));
+            batchData = *batchView;
         }
+        else
+        {
+            if (!blockSource.ReadBlocks(batchBytes, batchStartIndex, batchBlockCount))
+            {
+                return Result::Fail("ReadHeader: Failed to read blocks {}+{} from the block source", batchStartIndex, batchBlockCount);
+            }
 
-        // Interpret the block's bytes as keyword records which fill a HeaderBlock
-        HeaderBlock headerBlock{};
+            batchData = std::span<const std::byte>(batchBytes).subspan(0, batchBlockCount * BLOCK_BYTE_SIZE.value);
+        }
 
-        for (unsigned int keywordRecordIndex = 0; keywordRecordIndex < KEYWORD_RECORDS_PER_HEADER_BLOCK; ++keywordRecordIndex)
+        // Note that reading stops after the block containing an END keyword
+        for (uintmax_t batchBlockIndex = 0; (batchBlockIndex < batchBlockCount) && !foundEndKeyword; ++batchBlockIndex)
         {
-            const auto keywordRecordByteOffset = keywordRecordIndex * KEYWORD_RECORD_BYTE_SIZE;
+            foundEndKeyword = onBlock(batchData.subspan(batchBlockIndex * BLOCK_BYTE_SIZE.value, BLOCK_BYTE_SIZE.value));
+        }
+    }
 
-            const auto keywordRecordSpan = KeywordRecordSpan{
-                reinterpret_cast<char*>(blockBytes.data()) + keywordRecordByteOffset.value,
-                KEYWORD_RECORD_BYTE_SIZE.value
-            };
+    if (!foundEndKeyword)
+    {
+        return Result::Fail("ReadHeader: Reached end of blocks but no END keyword found");
+    }
 
-            const auto keywordRecord = KeywordRecord::FromRaw(keywordRecordSpan);
+    return Result::Success();
+}
+
+std::expected<Header, Error> ReadHeader(FITSBlockSource& blockSource, uintmax_t blockStartIndex)
+{
+    std::vector<std::byte> rawBytes;
 
-            headerBlock.keywordRecords[keywordRecordIndex] = keywordRecord;
+    const auto result = ReadHeaderBlocks(blockSource, blockStartIndex, [&](std::span<const std::byte> blockData){
+        rawBytes.insert(rawBytes.end(), blockData.begin(), blockData.end());
 
-            if (!keywordRecord.GetValidationError() && (*keywordRecord.GetKeywordName() == KEYWORD_NAME_END))
+        return ScanHeaderBlock(blockData.first<BLOCK_BYTE_SIZE.value>()).endRecords != 0U;
+    });
+
+    if (!result)
+    {
+        return std::unexpected(*result.error);
+    }
+
+    // Parse the header now, from its raw bytes, so that its index can make use of the blocks' scans
+    auto header = Header::FromRawBytes(std::make_shared<const std::vector<std::byte>>(std::move(rawBytes)));
+    (void)header.GetHeaderBlocks();
+
+    return header;
+}
+
+/**
+ * @return Whether a keyword record's keyword name is one of those which describe an HDU's structure; its type,
+ * and the size of its data
+ */
+bool IsStructuralKeywordRecord(KeywordRecordCSpan keywordRecordSpan)
+{
+    // Keyword names are left justified within the record's first 8 bytes, padded with spaces
+    auto keywordName = std::string_view(keywordRecordSpan.data(), 8);
+    keywordName = keywordName.substr(0, keywordName.find_last_not_of(' ') + 1);
+
+    return keywordName.starts_with(KEYWORD_NAME_NAXIS) ||
+           (keywordName == KEYWORD_NAME_SIMPLE) ||
+           (keywordName == KEYWORD_NAME_XTENSION) ||
+           (keywordName == KEYWORD_NAME_BITPIX) ||
+           (keywordName == KEYWORD_NAME_PCOUNT) ||
+           (keywordName == KEYWORD_NAME_GCOUNT);
+}
+
+/**
+ * Reads an HDU without parsing its header. Only the header's END keyword is located, and only the keyword
+ * records needed to determine the HDU's type and data size are parsed. The HDU's header holds the raw bytes of
+ * its blocks, which are parsed the first time any of its keyword records are accessed.
+ */
+std::expected<HDU, Error> ReadHDULazy(FITSBlockSource& blockSource, uintmax_t blockStartIndex, bool isPrimary)
+{
+    std::vector<std::byte> rawBytes;
+    std::vector<KeywordRecord> structuralRecords;
+
+    const auto result = ReadHeaderBlocks(blockSource, blockStartIndex, [&](std::span<const std::byte> blockData){
+        const bool isFirstBlock = rawBytes.empty();
+
+        rawBytes.insert(rawBytes.end(), blockData.begin(), blockData.end());
+
+        const auto scan = ScanHeaderBlock(blockData.first<BLOCK_BYTE_SIZE.value>());
+
+        // Blank records can't be structural, so only the block's other records need to be looked at
+        auto candidateRecords = ~scan.blankRecords & ((uint64_t{1} << KEYWORD_RECORDS_PER_HEADER_BLOCK) - 1U);
+
+        // The header's first keyword record is always kept, as it determines the HDU's type
+        if (isFirstBlock)
+        {
+            candidateRecords |= 1U;
+        }
+
+        while (candidateRecords != 0U)
+        {
+            const auto keywordRecordIndex = static_cast<unsigned int>(std::countr_zero(candidateRecords));
+            candidateRecords &= candidateRecords - 1U;
+
+            const auto keywordRecordSpan = KeywordRecordCSpan{
+                reinterpret_cast<const char*>(blockData.data()) + (keywordRecordIndex * KEYWORD_RECORD_BYTE_SIZE.value),
+                KEYWORD_RECORD_BYTE_SIZE.value
+            };
+
+            if ((isFirstBlock && (keywordRecordIndex == 0)) || IsStructuralKeywordRecord(keywordRecordSpan))
             {
-                foundEndKeyword = true;
+                structuralRecords.push_back(KeywordRecord::FromRaw(keywordRecordSpan));
             }
         }
 
-        header.headerBlocks.push_back(headerBlock);
+        return scan.endRecords != 0U;
+    });
 
-        // If we reached an END keyword, stop reading further blocks
-        if (foundEndKeyword)
-        {
-            break;
-        }
+    if (!result)
+    {
+        return std::unexpected(*result.error);
     }
 
-    if (!foundEndKeyword)
+    //
+    // Determine the HDU's type and data size from a header holding only its structural keyword records, then
+    // give the HDU its full, unparsed, header
+    //
+    std::vector<HeaderBlock> structuralBlocks((structuralRecords.size() + KEYWORD_RECORDS_PER_HEADER_BLOCK - 1U) / KEYWORD_RECORDS_PER_HEADER_BLOCK);
+
+    for (std::size_t x = 0; x < structuralRecords.size(); ++x)
     {
-        return std::unexpected(Error::Msg("ReadHeader: Reached end of blocks but no END keyword found"));
+        structuralBlocks[x / KEYWORD_RECORDS_PER_HEADER_BLOCK].keywordRecords[x % KEYWORD_RECORDS_PER_HEADER_BLOCK] = structuralRecords[x];
     }
 
-    return header;
+    auto hdu = CreateHDU(Header(std::move(structuralBlocks)), blockStartIndex, isPrimary);
+    if (!hdu)
+    {
+        return std::unexpected(hdu.error());
+    }
+
+    hdu->header = Header::FromRawBytes(std::make_shared<const std::vector<std::byte>>(std::move(rawBytes)));
+
+    return hdu;
 }
 
 std::expected<uintmax_t, Error> GetHDUDataByteSize_Primary(const Header& header)
@@ -179,12 +321,12 @@ std::expected<uintmax_t, Error> GetHDUDataByteSize(const Header& header, bool is
 
 std::expected<HDU::Type, Error> GetHDUType(const Header& header)
 {
-    if (header.headerBlocks.empty())
+    if (header.GetNumHeaderBlocks() == 0)
     {
         return std::unexpected(Error::Msg("GetHDUType: Header has no associated header blocks"));
     }
 
-    const auto& firstKeywordRecord = header.headerBlocks.at(0).keywordRecords.at(0);
+    const auto& firstKeywordRecord = header.GetHeaderBlocks().at(0).keywordRecords.at(0);
     if (firstKeywordRecord.GetValidationError())
     {
         return std::unexpected(Error::Msg("GetHDUType: First keyword record has a validation error"));
@@ -226,21 +368,15 @@ std::expected<HDU::Type, Error> GetHDUType(const Header& header)
     return std::unexpected(Error::Msg("GetHDUType: Unable to determine HDU type"));
 }
 
-std::expected<HDU, Error> ReadHDU(FITSBlockSource& blockSource, uintmax_t blockStartIndex, bool isPrimary)
+std::expected<HDU, Error> CreateHDU(const Header& header, uintmax_t blockStartIndex, bool isPrimary)
 {
-    const auto header = ReadHeader(blockSource, blockStartIndex);
-    if (!header)
-    {
-        return std::unexpected(header.error());
-    }
-
-    const auto hduType = GetHDUType(*header);
+    const auto hduType = GetHDUType(header);
     if (!hduType)
     {
         return std::unexpected(hduType.error());
     }
 
-    const auto dataByteSize = GetHDUDataByteSize(*header, isPrimary);
+    const auto dataByteSize = GetHDUDataByteSize(header, isPrimary);
     if (!dataByteSize)
     {
         return std::unexpected(dataByteSize.error());
@@ -256,13 +392,24 @@ std::expected<HDU, Error> ReadHDU(FITSBlockSource& blockSource, uintmax_t blockS
         .isPrimary = isPrimary,
         .type = *hduType,
         .blockStartIndex = blockStartIndex,
-        .header = *header,
+        .header = header,
         .numDataBlocks = numDataBlocks,
         .dataByteSize = *dataByteSize
     };
 }
 
-std::expected<std::vector<HDU>, Error> ReadHDUS(FITSBlockSource& blockSource)
+std::expected<HDU, Error> ReadHDU(FITSBlockSource& blockSource, uintmax_t blockStartIndex, bool isPrimary)
+{
+    const auto header = ReadHeader(blockSource, blockStartIndex);
+    if (!header)
+    {
+        return std::unexpected(header.error());
+    }
+
+    return CreateHDU(*header, blockStartIndex, isPrimary);
+}
+
+std::expected<std::vector<HDU>, Error> ReadHDUS(FITSBlockSource& blockSource, const FITSFileOpenParams& params)
 {
     std::vector<HDU> hdus;
 
@@ -274,11 +421,17 @@ std::expected<std::vector<HDU>, Error> ReadHDUS(FITSBlockSource& blockSource)
 
     uintmax_t blockIndex = 0;
 
-    while (blockIndex < *blockCount)
+    while ((blockIndex < *blockCount) && (!params.maxNumHDUs || (hdus.size() < *params.maxNumHDUs)))
     {
+        if (params.isCancelled && params.isCancelled())
+        {
+            return std::unexpected(Error::Msg("ReadHDUS: Open was cancelled"));
+        }
+
         const bool isPrimary = blockIndex == 0U;
 
-        auto hdu = ReadHDU(blockSource, blockIndex, isPrimary);
+        auto hdu = params.lazyHeaders ? ReadHDULazy(blockSource, blockIndex, isPrimary)
+                                      : ReadHDU(blockSource, blockIndex, isPrimary);
         if (!hdu)
         {
             return std::unexpected(hdu.error());
@@ -286,6 +439,11 @@ std::expected<std::vector<HDU>, Error> ReadHDUS(FITSBlockSource& blockSource)
 
         hdus.push_back(*hdu);
 
+        if (params.onHDU)
+        {
+            params.onHDU(hdus.back(), hdus.size() - 1U);
+        }
+
         blockIndex += hdu->GetTotalBlockCount();
     }
 
@@ -294,15 +452,72 @@ std::expected<std::vector<HDU>, Error> ReadHDUS(FITSBlockSource& blockSource)
 
 std::expected<std::unique_ptr<FITSFile>, Error> FITSFile::OpenBlocking(std::unique_ptr<IFITSByteSource> pSource)
 {
+    return OpenBlocking(std::move(pSource), FITSFileOpenParams{});
+}
+
+std::expected<std::unique_ptr<FITSFile>, Error> FITSFile::OpenBlocking(std::unique_ptr<IFITSByteSource> pSource, const FITSFileOpenParams& params)
+{
+    const auto byteSize = pSource->GetByteSize();
+
+    //
+    // If there's a valid HDU index for the source, use its HDUs rather than reading them from the source
+    //
+    if (params.hduIndexFilePath && byteSize)
+    {
+        if (auto indexHDUs = LoadHDUIndex(*params.hduIndexFilePath, params.hduIndexKey, byteSize->value))
+        {
+            if (params.maxNumHDUs && (indexHDUs->size() > *params.maxNumHDUs))
+            {
+                indexHDUs->resize(*params.maxNumHDUs);
+            }
+
+            for (std::size_t x = 0; x < indexHDUs->size(); ++x)
+            {
+                if (params.isCancelled && params.isCancelled())
+                {
+                    return std::unexpected(Error::Msg("FITSFile::OpenBlocking: Open was cancelled"));
+                }
+
+                if (!params.lazyHeaders)
+                {
+                    (void)(*indexHDUs)[x].header.GetHeaderBlocks();
+                }
+
+                if (params.onHDU)
+                {
+                    params.onHDU((*indexHDUs)[x], x);
+                }
+            }
+
+            return std::make_unique<FITSFile>(Tag{}, std::move(pSource), std::move(*indexHDUs));
+        }
+    }
+
     auto blockSource = FITSBlockSource(pSource.get());
 
-    const auto result = ReadHDUS(blockSource);
+    // Reading HDUs hops from header to header, skipping over data blocks, so the source as a whole is
+    // accessed randomly rather than sequentially
+    if (byteSize)
+    {
+        pSource->AdviseAccess(ByteOffset(0), *byteSize, ByteAccessHint::Random);
+    }
+
+    auto result = ReadHDUS(blockSource, params);
     if (!result)
     {
         return std::unexpected(result.error());
     }
 
-    return std::make_unique<FITSFile>(Tag{}, std::move(pSource), *result);
+    // Failing to write the index doesn't prevent the file from being opened; it'll just be read again next time.
+    // Note that an index is only written for a fully read file.
+    const bool readAllHDUs = !params.maxNumHDUs || (result->size() < *params.maxNumHDUs);
+
+    if (params.hduIndexFilePath && byteSize && readAllHDUs)
+    {
+        (void)SaveHDUIndex(*params.hduIndexFilePath, params.hduIndexKey, byteSize->value, *result);
+    }
+
+    return std::make_unique<FITSFile>(Tag{}, std::move(pSource), std::move(*result));
 }
 
 FITSFile::FITSFile(Tag, std::unique_ptr<IFITSByteSource> pSource, std::vector<HDU> hdus)
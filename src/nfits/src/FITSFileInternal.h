@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_FITSFILEINTERNAL_H
+#define NFITS_SRC_FITSFILEINTERNAL_H
+
+#include <NFITS/Error.h>
+#include <NFITS/HDU.h>
+#include <NFITS/Header.h>
+#include <NFITS/HeaderBlock.h>
+
+#include "Parsing.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+
+namespace NFITS
+{
+    // Helper funcs for interpreting a FITS file's HDU structure, shared by FITSFile and the stream reader
+
+    /**
+     * Interprets one block's worth of bytes as the keyword records of a header block
+     *
+     * @param blockData The block's bytes. Must be at least BLOCK_BYTE_SIZE bytes.
+     * @param headerBlock Receives the block's keyword records
+     *
+     * @return The block's scanned keyword records; the block contains an END keyword if any of its records are
+     * END records
+     */
+    [[nodiscard]] HeaderBlockScan ParseHeaderBlock(std::span<const std::byte> blockData, HeaderBlock& headerBlock);
+
+    /**
+     * Creates an HDU from its fully read header, determining its type and the size of its data
+     *
+     * @param header The HDU's header
+     * @param blockStartIndex The block index, within the FITS file, of the HDU's first header block
+     * @param isPrimary Whether the HDU is the file's primary HDU
+     *
+     * @return The HDU, or an Error if its header doesn't describe a valid HDU
+     */
+    [[nodiscard]] std::expected<HDU, Error> CreateHDU(const Header& header, uintmax_t blockStartIndex, bool isPrimary);
+}
+
+#endif //NFITS_SRC_FITSFILEINTERNAL_H
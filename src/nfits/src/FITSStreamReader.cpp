@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/FITSStreamReader.h>
+
+#include "FITSFileInternal.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace NFITS
+{
+
+namespace
+{
+    /**
+     * Appends byteSize bytes from the stream to bytes, unless the stream ends first
+     *
+     * @return The number of bytes appended, which is less than byteSize only if the stream ended
+     */
+    std::expected<uintmax_t, Error> AppendFromStream(const StreamReadFunc& readFunc, std::vector<std::byte>& bytes, uintmax_t byteSize)
+    {
+        const auto startByteSize = bytes.size();
+        bytes.resize(startByteSize + static_cast<std::size_t>(byteSize));
+
+        uintmax_t numBytesRead = 0;
+
+        while (numBytesRead < byteSize)
+        {
+            const auto result = readFunc(std::span(bytes).subspan(startByteSize + static_cast<std::size_t>(numBytesRead)));
+            if (!result)
+            {
+                return std::unexpected(result.error());
+            }
+
+            if (*result == 0)
+            {
+                break;
+            }
+
+            numBytesRead += *result;
+        }
+
+        bytes.resize(startByteSize + static_cast<std::size_t>(numBytesRead));
+
+        return numBytesRead;
+    }
+}
+
+Result ReadFITSStreamBlocking(const StreamReadFunc& readFunc, const FITSStreamParams& params)
+{
+    // Data chunks are read as whole blocks, so that each chunk's padding is read along with it
+    const auto dataChunkBlockCount = std::max<uintmax_t>((params.dataChunkByteSize.value + BLOCK_BYTE_SIZE.value - 1U) / BLOCK_BYTE_SIZE.value, 1U);
+
+    // Holds the header block, or chunk of data blocks, most recently read from the stream
+    std::vector<std::byte> chunkBytes;
+
+    uintmax_t hduIndex = 0;
+    uintmax_t streamBlockIndex = 0;
+
+    while (true)
+    {
+        const bool isPrimary = hduIndex == 0;
+
+        //
+        // Read header blocks, one at a time, until one with an END keyword arrives
+        //
+        std::vector<HeaderBlock> headerBlocks;
+        bool foundEndKeyword = false;
+
+        while (!foundEndKeyword)
+        {
+            if (headerBlocks.size() == params.maxHeaderBlockCount)
+            {
+                return Result::Fail("ReadFITSStreamBlocking: HDU {}'s header has no END keyword within {} blocks", hduIndex, params.maxHeaderBlockCount);
+            }
+
+            chunkBytes.clear();
+
+            const auto numBytesRead = AppendFromStream(readFunc, chunkBytes, BLOCK_BYTE_SIZE.value);
+            if (!numBytesRead)
+            {
+                return Result::Fail(numBytesRead.error());
+            }
+
+            // The stream ending cleanly between HDUs is the end of the file
+            if ((*numBytesRead == 0) && headerBlocks.empty() && !isPrimary)
+            {
+                return Result::Success();
+            }
+
+            if (*numBytesRead != BLOCK_BYTE_SIZE.value)
+            {
+                return Result::Fail("ReadFITSStreamBlocking: Stream ended partway through HDU {}'s header", hduIndex);
+            }
+
+            HeaderBlock headerBlock{};
+            foundEndKeyword = ParseHeaderBlock(chunkBytes, headerBlock).endRecords != 0U;
+
+            headerBlocks.push_back(headerBlock);
+        }
+
+        // Note that the HDU is positioned at the start of its own, single HDU, file
+        const auto hdu = CreateHDU(Header(std::move(headerBlocks)), 0, isPrimary);
+        if (!hdu)
+        {
+            return Result::Fail(hdu.error());
+        }
+
+        // The data's size comes from the header, so it's checked before anything is sized from it
+        if (hdu->GetDataBlockCount() > (std::numeric_limits<uintmax_t>::max() / BLOCK_BYTE_SIZE.value))
+        {
+            return Result::Fail("ReadFITSStreamBlocking: HDU {}'s declared data size is too large", hduIndex);
+        }
+
+        const auto streamedHDU = StreamedHDU{
+            .hduIndex = hduIndex,
+            .streamBlockStartIndex = streamBlockIndex,
+            .pHDU = &*hdu
+        };
+
+        if (params.onHDU && !params.onHDU(streamedHDU))
+        {
+            return Result::Success();
+        }
+
+        //
+        // Read the HDU's data blocks, a chunk at a time, handing each chunk's data bytes to the callback
+        //
+        uintmax_t dataBlockIndex = 0;
+
+        while (dataBlockIndex < hdu->GetDataBlockCount())
+        {
+            const auto chunkBlockCount = std::min(dataChunkBlockCount, hdu->GetDataBlockCount() - dataBlockIndex);
+            const auto chunkByteSize = chunkBlockCount * BLOCK_BYTE_SIZE.value;
+
+            chunkBytes.clear();
+
+            const auto numBytesRead = AppendFromStream(readFunc, chunkBytes, chunkByteSize);
+            if (!numBytesRead)
+            {
+                return Result::Fail(numBytesRead.error());
+            }
+
+            if (*numBytesRead != chunkByteSize)
+            {
+                return Result::Fail("ReadFITSStreamBlocking: Stream ended partway through HDU {}'s data", hduIndex);
+            }
+
+            // Exclude the padding which follows the data in its final block
+            const auto dataByteOffset = dataBlockIndex * BLOCK_BYTE_SIZE.value;
+            const auto chunkDataByteSize = std::min(chunkByteSize, hdu->dataByteSize - std::min(dataByteOffset, hdu->dataByteSize));
+
+            if (params.onHDUData && (chunkDataByteSize > 0U) &&
+                !params.onHDUData(streamedHDU, dataByteOffset, std::span<const std::byte>(chunkBytes).first(static_cast<std::size_t>(chunkDataByteSize))))
+            {
+                return Result::Success();
+            }
+
+            dataBlockIndex += chunkBlockCount;
+        }
+
+        hduIndex++;
+        streamBlockIndex += hdu->GetTotalBlockCount();
+    }
+}
+
+Result ReadFITSStreamBlocking(std::istream& stream, const FITSStreamParams& params)
+{
+    const auto readFunc = [&](std::span<std::byte> dst) -> std::expected<std::size_t, Error> {
+        stream.read(reinterpret_cast<char*>(dst.data()), static_cast<std::streamsize>(dst.size()));
+
+        if (stream.bad())
+        {
+            return std::unexpected(Error::Msg("ReadFITSStreamBlocking: Failed to read from stream"));
+        }
+
+        return static_cast<std::size_t>(stream.gcount());
+    };
+
+    return ReadFITSStreamBlocking(readFunc, params);
+}
+
+}
@@ -0,0 +1,664 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/GzipFITSByteSource.h>
+
+#include "Util/BinaryFile.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+
+namespace NFITS
+{
+
+// Size of the window deflate back-references can reach into
+static constexpr std::size_t WINDOW_BYTE_SIZE = 32U * 1024U;
+
+// Number of compressed bytes read from the wrapped source at a time
+static constexpr std::size_t COMPRESSED_CHUNK_BYTE_SIZE = 1024U * 1024U;
+
+// Window bits which have inflate auto-detect, and parse, a gzip or zlib header
+static constexpr int WINDOW_BITS_GZIP = 15 + 32;
+
+// Window bits which have inflate process raw deflate data, with no header
+static constexpr int WINDOW_BITS_RAW = -15;
+
+// Byte size of the trailer (CRC32 and ISIZE) which follows each gzip member's deflate data
+static constexpr uintmax_t MEMBER_TRAILER_BYTE_SIZE = 8U;
+
+static constexpr std::array<char, 8> INDEX_FILE_MAGIC = {'N', 'F', 'I', 'T', 'S', 'G', 'Z', 'I'};
+static constexpr uint32_t INDEX_FILE_VERSION = 1U;
+
+namespace
+{
+    /**
+     * Owns an inflate stream for the duration of a scope
+     */
+    struct InflateStream
+    {
+        InflateStream() = default;
+        ~InflateStream() { if (initialized) { (void)inflateEnd(&stream); } }
+
+        InflateStream(const InflateStream&) = delete;
+        InflateStream& operator=(const InflateStream&) = delete;
+
+        [[nodiscard]] bool Init(int windowBits)
+        {
+            initialized = inflateInit2(&stream, windowBits) == Z_OK;
+            return initialized;
+        }
+
+        z_stream stream{};
+        bool initialized{false};
+    };
+
+    /**
+     * Reads compressed bytes from a source, in chunks, tracking the offset of the next byte inflate consumes
+     */
+    class CompressedReader
+    {
+        public:
+
+            using ReadFunc = std::function<Result(std::span<std::byte>, const ByteOffset&, const ByteSize&)>;
+
+            CompressedReader(ReadFunc readFunc, uintmax_t compressedByteSize, uintmax_t startOffset)
+                : m_readFunc(std::move(readFunc))
+                , m_compressedByteSize(compressedByteSize)
+                , m_nextReadOffset(startOffset)
+                , m_chunk(COMPRESSED_CHUNK_BYTE_SIZE)
+            { }
+
+            /**
+             * @return Offset of the next compressed byte not yet consumed by the stream
+             */
+            [[nodiscard]] uintmax_t GetConsumedOffset(const z_stream& stream) const { return m_nextReadOffset - stream.avail_in; }
+
+            [[nodiscard]] bool AtEnd(const z_stream& stream) const { return GetConsumedOffset(stream) >= m_compressedByteSize; }
+
+            /**
+             * Skips over compressed bytes which the stream hasn't consumed yet
+             */
+            void Skip(z_stream& stream, uintmax_t byteSize)
+            {
+                const auto consumedOffset = GetConsumedOffset(stream);
+
+                stream.next_in = nullptr;
+                stream.avail_in = 0;
+                m_nextReadOffset = std::min(consumedOffset + byteSize, m_compressedByteSize);
+            }
+
+            /**
+             * Provides the stream with more compressed bytes, if it has consumed all of the bytes it was given
+             */
+            [[nodiscard]] Result Refill(z_stream& stream)
+            {
+                if (stream.avail_in != 0)
+                {
+                    return Result::Success();
+                }
+
+                const auto byteSize = std::min<uintmax_t>(m_compressedByteSize - m_nextReadOffset, m_chunk.size());
+                if (byteSize == 0)
+                {
+                    return Result::Fail("GzipFITSByteSource: Compressed data ended unexpectedly");
+                }
+
+                const auto result = m_readFunc(m_chunk, ByteOffset(m_nextReadOffset), ByteSize(byteSize));
+                if (!result)
+                {
+                    return result;
+                }
+
+                m_nextReadOffset += byteSize;
+
+                stream.next_in = reinterpret_cast<Bytef*>(m_chunk.data());
+                stream.avail_in = static_cast<uInt>(byteSize);
+
+                return Result::Success();
+            }
+
+            /**
+             * @return Whether a new gzip member begins at the stream's next unconsumed byte
+             */
+            [[nodiscard]] std::expected<bool, Error> AtMemberStart(z_stream& stream)
+            {
+                if (AtEnd(stream))
+                {
+                    return false;
+                }
+
+                std::array<std::byte, 2> magic{};
+
+                const auto offset = GetConsumedOffset(stream);
+                if (offset + magic.size() > m_compressedByteSize)
+                {
+                    return false;
+                }
+
+                const auto result = m_readFunc(magic, ByteOffset(offset), ByteSize(magic.size()));
+                if (!result)
+                {
+                    return std::unexpected(*result.error);
+                }
+
+                return GzipFITSByteSource::IsGzipData(magic);
+            }
+
+        private:
+
+            ReadFunc m_readFunc;
+            uintmax_t m_compressedByteSize;
+            uintmax_t m_nextReadOffset;
+            std::vector<std::byte> m_chunk;
+    };
+
+    std::expected<GzipFITSByteSource::SeekIndex, Error> BuildSeekIndex(const CompressedReader::ReadFunc& readFunc,
+                                                                       uintmax_t compressedByteSize,
+                                                                       uintmax_t checkpointSpacing)
+    {
+        GzipFITSByteSource::SeekIndex seekIndex{};
+        seekIndex.compressedByteSize = compressedByteSize;
+
+        CompressedReader reader(readFunc, compressedByteSize, 0U);
+
+        InflateStream inflateStream;
+        if (!inflateStream.Init(WINDOW_BITS_GZIP))
+        {
+            return std::unexpected(Error::Msg("GzipFITSByteSource: Failed to initialize inflate"));
+        }
+        auto& stream = inflateStream.stream;
+
+        // Inflated bytes are written circularly into the window, so that it always holds the most recent bytes
+        std::vector<std::byte> window(WINDOW_BYTE_SIZE);
+
+        uintmax_t totalOut = 0;
+        uintmax_t lastCheckpointOut = 0;
+
+        while (true)
+        {
+            auto result = reader.Refill(stream);
+            if (!result) { return std::unexpected(*result.error); }
+
+            if (stream.avail_out == 0)
+            {
+                stream.next_out = reinterpret_cast<Bytef*>(window.data());
+                stream.avail_out = static_cast<uInt>(window.size());
+            }
+
+            // Inflate up to the end of the next deflate block, at most, so that block boundaries are seen
+            const auto availOutBefore = stream.avail_out;
+            const auto ret = inflate(&stream, Z_BLOCK);
+            totalOut += availOutBefore - stream.avail_out;
+
+            if ((ret == Z_NEED_DICT) || (ret == Z_DATA_ERROR) || (ret == Z_MEM_ERROR))
+            {
+                return std::unexpected(Error::Msg("GzipFITSByteSource: Invalid compressed data, inflate error: {}", ret));
+            }
+
+            if (ret == Z_STREAM_END)
+            {
+                // Continue into the next member, if another follows
+                const auto atMemberStart = reader.AtMemberStart(stream);
+                if (!atMemberStart) { return std::unexpected(atMemberStart.error()); }
+                if (!*atMemberStart) { break; }
+
+                if (inflateReset(&stream) != Z_OK)
+                {
+                    return std::unexpected(Error::Msg("GzipFITSByteSource: Failed to reset inflate"));
+                }
+
+                continue;
+            }
+
+            //
+            // At the end of a deflate block which isn't the last in its member, record a checkpoint if enough
+            // bytes have been inflated since the last one
+            //
+            const bool atBlockEnd = (stream.data_type & 128) != 0;
+            const bool atLastBlock = (stream.data_type & 64) != 0;
+
+            if (atBlockEnd && !atLastBlock &&
+                (seekIndex.checkpoints.empty() || ((totalOut - lastCheckpointOut) >= checkpointSpacing)))
+            {
+                GzipFITSByteSource::Checkpoint checkpoint{};
+                checkpoint.uncompressedOffset = totalOut;
+                checkpoint.compressedOffset = reader.GetConsumedOffset(stream);
+                checkpoint.bits = static_cast<uint8_t>(stream.data_type & 7);
+
+                // Unroll the circular window, oldest bytes first
+                const auto windowPos = window.size() - stream.avail_out;
+                const auto windowByteSize = static_cast<std::size_t>(std::min<uintmax_t>(totalOut, window.size()));
+
+                checkpoint.window.reserve(windowByteSize);
+                checkpoint.window.insert(checkpoint.window.end(), window.begin() + static_cast<std::ptrdiff_t>(windowPos), window.end());
+                checkpoint.window.insert(checkpoint.window.end(), window.begin(), window.begin() + static_cast<std::ptrdiff_t>(windowPos));
+                checkpoint.window.erase(checkpoint.window.begin(), checkpoint.window.end() - static_cast<std::ptrdiff_t>(windowByteSize));
+
+                seekIndex.checkpoints.push_back(std::move(checkpoint));
+                lastCheckpointOut = totalOut;
+            }
+        }
+
+        if (seekIndex.checkpoints.empty())
+        {
+            return std::unexpected(Error::Msg("GzipFITSByteSource: Compressed data contains no deflate blocks"));
+        }
+
+        seekIndex.uncompressedByteSize = totalOut;
+
+        return seekIndex;
+    }
+
+    std::optional<GzipFITSByteSource::SeekIndex> LoadSeekIndex(const std::filesystem::path& indexFilePath,
+                                                               uintmax_t compressedByteSize,
+                                                               const std::array<std::byte, 8>& compressedTrailer)
+    {
+        std::ifstream stream(indexFilePath, std::ios::binary);
+        if (!stream.is_open())
+        {
+            return std::nullopt;
+        }
+
+        std::array<char, 8> magic{};
+        uint32_t version{0};
+        uint64_t checkpointCount{0};
+
+        GzipFITSByteSource::SeekIndex seekIndex{};
+
+        if (!ReadValue(stream, magic) || (magic != INDEX_FILE_MAGIC)) { return std::nullopt; }
+        if (!ReadValue(stream, version) || (version != INDEX_FILE_VERSION)) { return std::nullopt; }
+        if (!ReadValue(stream, seekIndex.compressedByteSize)) { return std::nullopt; }
+        if (!ReadValue(stream, seekIndex.uncompressedByteSize)) { return std::nullopt; }
+        if (!ReadValue(stream, seekIndex.compressedTrailer)) { return std::nullopt; }
+        if (!ReadValue(stream, checkpointCount)) { return std::nullopt; }
+
+        // The index must describe the same compressed bytes
+        if ((seekIndex.compressedByteSize != compressedByteSize) || (seekIndex.compressedTrailer != compressedTrailer))
+        {
+            return std::nullopt;
+        }
+
+        for (uint64_t x = 0; x < checkpointCount; ++x)
+        {
+            GzipFITSByteSource::Checkpoint checkpoint{};
+            uint32_t windowByteSize{0};
+
+            if (!ReadValue(stream, checkpoint.uncompressedOffset)) { return std::nullopt; }
+            if (!ReadValue(stream, checkpoint.compressedOffset)) { return std::nullopt; }
+            if (!ReadValue(stream, checkpoint.bits)) { return std::nullopt; }
+            if (!ReadValue(stream, windowByteSize) || (windowByteSize > WINDOW_BYTE_SIZE)) { return std::nullopt; }
+
+            checkpoint.window.resize(windowByteSize);
+            stream.read(reinterpret_cast<char*>(checkpoint.window.data()), static_cast<std::streamsize>(windowByteSize));
+            if (!stream.good()) { return std::nullopt; }
+
+            // Checkpoints must be in order, and within the data they index
+            if ((checkpoint.compressedOffset > compressedByteSize) ||
+                (checkpoint.uncompressedOffset > seekIndex.uncompressedByteSize) ||
+                (checkpoint.bits > 7U) ||
+                (!seekIndex.checkpoints.empty() && (checkpoint.uncompressedOffset <= seekIndex.checkpoints.back().uncompressedOffset)))
+            {
+                return std::nullopt;
+            }
+
+            seekIndex.checkpoints.push_back(std::move(checkpoint));
+        }
+
+        if (seekIndex.checkpoints.empty())
+        {
+            return std::nullopt;
+        }
+
+        return seekIndex;
+    }
+}
+
+bool GzipFITSByteSource::IsGzipData(std::span<const std::byte> bytes)
+{
+    return (bytes.size() >= 2) && (bytes[0] == std::byte{0x1F}) && (bytes[1] == std::byte{0x8B});
+}
+
+std::expected<std::unique_ptr<GzipFITSByteSource>, Error> GzipFITSByteSource::Create(std::unique_ptr<IFITSByteSource> pCompressedSource,
+                                                                                     const GzipParams& params)
+{
+    const auto compressedByteSize = pCompressedSource->GetByteSize();
+    if (!compressedByteSize)
+    {
+        return std::unexpected(compressedByteSize.error());
+    }
+
+    std::array<std::byte, 8> compressedTrailer{};
+
+    if (compressedByteSize->value < compressedTrailer.size())
+    {
+        return std::unexpected(Error::Msg("GzipFITSByteSource::Create: Source is too small to hold gzip data"));
+    }
+
+    std::array<std::byte, 2> magic{};
+
+    if (!pCompressedSource->ReadBytes(magic, ByteOffset(0), ByteSize(magic.size())) || !IsGzipData(magic))
+    {
+        return std::unexpected(Error::Msg("GzipFITSByteSource::Create: Source doesn't hold gzip data"));
+    }
+
+    const auto trailerOffset = ByteOffset(compressedByteSize->value - compressedTrailer.size());
+    if (!pCompressedSource->ReadBytes(compressedTrailer, trailerOffset, ByteSize(compressedTrailer.size())))
+    {
+        return std::unexpected(Error::Msg("GzipFITSByteSource::Create: Failed to read the gzip trailer"));
+    }
+
+    //
+    // Load the seek index from its file, if there's a valid one, otherwise build it
+    //
+    std::optional<SeekIndex> seekIndex;
+
+    if (params.indexFilePath)
+    {
+        seekIndex = LoadSeekIndex(*params.indexFilePath, compressedByteSize->value, compressedTrailer);
+    }
+
+    const bool builtSeekIndex = !seekIndex;
+
+    if (!seekIndex)
+    {
+        const auto readFunc = [&](std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize){
+            return pCompressedSource->ReadBytes(dst, byteOffset, byteSize);
+        };
+
+        auto builtIndex = BuildSeekIndex(readFunc, compressedByteSize->value, std::max<uintmax_t>(params.checkpointSpacing.value, 1U));
+        if (!builtIndex)
+        {
+            return std::unexpected(builtIndex.error());
+        }
+
+        builtIndex->compressedTrailer = compressedTrailer;
+        seekIndex = std::move(*builtIndex);
+    }
+
+    auto source = std::make_unique<GzipFITSByteSource>(Tag{}, std::move(pCompressedSource), params, std::move(*seekIndex));
+
+    // Persist a newly built index. Failing to do so only means the next open rebuilds it.
+    if (builtSeekIndex && params.indexFilePath)
+    {
+        (void)source->SaveIndex(*params.indexFilePath);
+    }
+
+    return source;
+}
+
+GzipFITSByteSource::GzipFITSByteSource(GzipFITSByteSource::Tag,
+                                       std::unique_ptr<IFITSByteSource> pCompressedSource,
+                                       const GzipParams& params,
+                                       SeekIndex seekIndex)
+    : m_pSource(std::move(pCompressedSource))
+    , m_params(params)
+    , m_seekIndex(std::move(seekIndex))
+{
+
+}
+
+GzipFITSByteSource::~GzipFITSByteSource() = default;
+
+Result GzipFITSByteSource::SaveIndex(const std::filesystem::path& indexFilePath) const
+{
+    std::ofstream stream(indexFilePath, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+        return Result::Fail("GzipFITSByteSource::SaveIndex: Failed to open index file for writing");
+    }
+
+    WriteValue(stream, INDEX_FILE_MAGIC);
+    WriteValue(stream, INDEX_FILE_VERSION);
+    WriteValue(stream, m_seekIndex.compressedByteSize);
+    WriteValue(stream, m_seekIndex.uncompressedByteSize);
+    WriteValue(stream, m_seekIndex.compressedTrailer);
+    WriteValue(stream, static_cast<uint64_t>(m_seekIndex.checkpoints.size()));
+
+    for (const auto& checkpoint : m_seekIndex.checkpoints)
+    {
+        WriteValue(stream, checkpoint.uncompressedOffset);
+        WriteValue(stream, checkpoint.compressedOffset);
+        WriteValue(stream, checkpoint.bits);
+        WriteValue(stream, static_cast<uint32_t>(checkpoint.window.size()));
+        stream.write(reinterpret_cast<const char*>(checkpoint.window.data()), static_cast<std::streamsize>(checkpoint.window.size()));
+    }
+
+    if (!stream.good())
+    {
+        return Result::Fail("GzipFITSByteSource::SaveIndex: Failed to write index file");
+    }
+
+    return Result::Success();
+}
+
+std::expected<ByteSize, Error> GzipFITSByteSource::GetByteSize() const
+{
+    return ByteSize(m_seekIndex.uncompressedByteSize);
+}
+
+Result GzipFITSByteSource::Resize(const ByteSize&)
+{
+    return Result::Fail("GzipFITSByteSource::Resize: Source is read-only");
+}
+
+Result GzipFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("GzipFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    if ((byteOffset.value > m_seekIndex.uncompressedByteSize) || (byteSize.value > (m_seekIndex.uncompressedByteSize - byteOffset.value)))
+    {
+        return Result::Fail("GzipFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+    }
+
+    const auto& checkpoints = m_seekIndex.checkpoints;
+
+    // Index of the last checkpoint at or before the read's first byte. The first checkpoint is always
+    // preceded by only the gzip header, so bytes before it are handled by the first span.
+    const auto it = std::ranges::upper_bound(checkpoints, byteOffset.value, {}, &Checkpoint::uncompressedOffset);
+    auto checkpointIndex = static_cast<std::size_t>(std::max<std::ptrdiff_t>(std::distance(checkpoints.begin(), it) - 1, 0));
+
+    //
+    // Copy the read's bytes out of each span they fall within
+    //
+    uintmax_t numBytesRead = 0;
+
+    while (numBytesRead < byteSize.value)
+    {
+        const auto span = GetSpan(checkpointIndex);
+        if (!span)
+        {
+            return Result::Fail(span.error());
+        }
+
+        const auto spanStartOffset = (checkpointIndex == 0) ? 0U : checkpoints[checkpointIndex].uncompressedOffset;
+        const auto readOffset = byteOffset.value + numBytesRead;
+        const auto offsetInSpan = readOffset - spanStartOffset;
+        const auto toCopy = std::min<uintmax_t>(byteSize.value - numBytesRead, (*span)->size() - offsetInSpan);
+
+        memcpy(dst.data() + numBytesRead, (*span)->data() + offsetInSpan, static_cast<std::size_t>(toCopy));
+
+        numBytesRead += toCopy;
+        checkpointIndex++;
+    }
+
+    return Result::Success();
+}
+
+Result GzipFITSByteSource::WriteBytes(std::span<const std::byte>, const ByteOffset&, const ByteSize&, bool)
+{
+    return Result::Fail("GzipFITSByteSource::WriteBytes: Source is read-only");
+}
+
+Result GzipFITSByteSource::Flush()
+{
+    // no-op, nothing is ever written to the source
+
+    return Result::Success();
+}
+
+std::expected<GzipFITSByteSource::Span, Error> GzipFITSByteSource::GetSpan(std::size_t checkpointIndex)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_spansMutex);
+
+        const auto it = std::ranges::find(m_spans, checkpointIndex, &std::pair<std::size_t, Span>::first);
+        if (it != m_spans.cend())
+        {
+            // Mark as most recently used
+            std::rotate(it, it + 1, m_spans.end());
+            return m_spans.back().second;
+        }
+    }
+
+    // Note that concurrent readers of the same span may both inflate it; the spare copy is simply dropped
+    auto span = InflateSpan(checkpointIndex);
+    if (!span)
+    {
+        return span;
+    }
+
+    if (m_params.cachedSpanCount > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_spansMutex);
+
+        if (std::ranges::find(m_spans, checkpointIndex, &std::pair<std::size_t, Span>::first) == m_spans.cend())
+        {
+            if (m_spans.size() >= m_params.cachedSpanCount)
+            {
+                m_spans.erase(m_spans.begin());
+            }
+
+            m_spans.emplace_back(checkpointIndex, *span);
+        }
+    }
+
+    return span;
+}
+
+std::expected<GzipFITSByteSource::Span, Error> GzipFITSByteSource::InflateSpan(std::size_t checkpointIndex) const
+{
+    const auto& checkpoints = m_seekIndex.checkpoints;
+    const auto& checkpoint = checkpoints[checkpointIndex];
+
+    //
+    // The first span is inflated from the very start of the gzip data, which also covers the bytes before the
+    // first checkpoint. Other spans are inflated from their checkpoint as raw deflate data.
+    //
+    const bool fromStart = checkpointIndex == 0;
+
+    const auto spanStartOffset = fromStart ? 0U : checkpoint.uncompressedOffset;
+    const auto spanEndOffset = (checkpointIndex + 1 < checkpoints.size()) ? checkpoints[checkpointIndex + 1].uncompressedOffset
+                                                                           : m_seekIndex.uncompressedByteSize;
+
+    if ((spanEndOffset - spanStartOffset) > std::numeric_limits<uInt>::max())
+    {
+        return std::unexpected(Error::Msg("GzipFITSByteSource: Span between checkpoints is too large"));
+    }
+
+    auto spanBytes = std::make_shared<std::vector<std::byte>>(static_cast<std::size_t>(spanEndOffset - spanStartOffset));
+
+    const auto readFunc = [this](std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize){
+        return ReadFromSource(dst, byteOffset, byteSize);
+    };
+
+    CompressedReader reader(readFunc, m_seekIndex.compressedByteSize, fromStart ? 0U : checkpoint.compressedOffset);
+
+    InflateStream inflateStream;
+    if (!inflateStream.Init(fromStart ? WINDOW_BITS_GZIP : WINDOW_BITS_RAW))
+    {
+        return std::unexpected(Error::Msg("GzipFITSByteSource: Failed to initialize inflate"));
+    }
+    auto& stream = inflateStream.stream;
+
+    bool rawMode = !fromStart;
+
+    if (!fromStart)
+    {
+        // Provide inflate with the bits of the partially consumed byte which precedes the checkpoint
+        if (checkpoint.bits != 0)
+        {
+            std::array<std::byte, 1> prevByte{};
+
+            const auto result = ReadFromSource(prevByte, ByteOffset(checkpoint.compressedOffset - 1U), ByteSize(1));
+            if (!result) { return std::unexpected(*result.error); }
+
+            const auto bitsValue = std::to_integer<int>(prevByte[0]) >> (8 - checkpoint.bits);
+
+            if (inflatePrime(&stream, checkpoint.bits, bitsValue) != Z_OK)
+            {
+                return std::unexpected(Error::Msg("GzipFITSByteSource: Failed to prime inflate"));
+            }
+        }
+
+        if (!checkpoint.window.empty() &&
+            (inflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(checkpoint.window.data()), static_cast<uInt>(checkpoint.window.size())) != Z_OK))
+        {
+            return std::unexpected(Error::Msg("GzipFITSByteSource: Failed to set inflate dictionary"));
+        }
+    }
+
+    stream.next_out = reinterpret_cast<Bytef*>(spanBytes->data());
+    stream.avail_out = static_cast<uInt>(spanBytes->size());
+
+    while (stream.avail_out != 0)
+    {
+        auto result = reader.Refill(stream);
+        if (!result) { return std::unexpected(*result.error); }
+
+        const auto ret = inflate(&stream, Z_NO_FLUSH);
+
+        if ((ret == Z_NEED_DICT) || (ret == Z_DATA_ERROR) || (ret == Z_MEM_ERROR))
+        {
+            return std::unexpected(Error::Msg("GzipFITSByteSource: Invalid compressed data, inflate error: {}", ret));
+        }
+
+        if ((ret == Z_STREAM_END) && (stream.avail_out != 0))
+        {
+            //
+            // The span continues into the next member. A raw inflate stops before the member's trailer, which
+            // has to be skipped; from then on, inflate parses each member's header and trailer itself.
+            //
+            if (rawMode)
+            {
+                reader.Skip(stream, MEMBER_TRAILER_BYTE_SIZE);
+
+                if (inflateReset2(&stream, WINDOW_BITS_GZIP) != Z_OK)
+                {
+                    return std::unexpected(Error::Msg("GzipFITSByteSource: Failed to reset inflate"));
+                }
+
+                rawMode = false;
+            }
+            else if (inflateReset(&stream) != Z_OK)
+            {
+                return std::unexpected(Error::Msg("GzipFITSByteSource: Failed to reset inflate"));
+            }
+        }
+    }
+
+    return spanBytes;
+}
+
+Result GzipFITSByteSource::ReadFromSource(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const
+{
+    if (m_pSource->SupportsConcurrentReads())
+    {
+        return m_pSource->ReadBytes(dst, byteOffset, byteSize);
+    }
+
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    return m_pSource->ReadBytes(dst, byteOffset, byteSize);
+}
+
+}
@@ -23,12 +23,12 @@ uintmax_t HDU::GetHeaderBlockStartIndex() const
 
 uintmax_t HDU::GetHeaderBlockCount() const
 {
-    return header.headerBlocks.size();
+    return header.GetNumHeaderBlocks();
 }
 
 uintmax_t HDU::GetDataBlockStartIndex() const
 {
-    return GetHeaderBlockStartIndex() + header.headerBlocks.size();
+    return GetHeaderBlockStartIndex() + header.GetNumHeaderBlocks();
 }
 
 uintmax_t HDU::GetDataBlockCount() const
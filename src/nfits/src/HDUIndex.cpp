@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "HDUIndex.h"
+
+#include "Util/BinaryFile.h"
+
+#include <NFITS/Def.h>
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <system_error>
+
+namespace NFITS
+{
+
+static constexpr std::array<char, 8> INDEX_FILE_MAGIC = {'N', 'F', 'I', 'T', 'S', 'H', 'D', 'U'};
+static constexpr uint32_t INDEX_FILE_VERSION = 1U;
+
+std::optional<std::vector<HDU>> LoadHDUIndex(const std::filesystem::path& indexFilePath,
+                                             const std::string& indexKey,
+                                             uintmax_t sourceByteSize)
+{
+    std::ifstream stream(indexFilePath, std::ios::binary);
+    if (!stream.is_open())
+    {
+        return std::nullopt;
+    }
+
+    std::array<char, 8> magic{};
+    uint32_t version{0};
+    uint64_t keyByteSize{0};
+    uint64_t indexSourceByteSize{0};
+    uint64_t hduCount{0};
+
+    if (!ReadValue(stream, magic) || (magic != INDEX_FILE_MAGIC)) { return std::nullopt; }
+    if (!ReadValue(stream, version) || (version != INDEX_FILE_VERSION)) { return std::nullopt; }
+    if (!ReadValue(stream, keyByteSize) || (keyByteSize != indexKey.size())) { return std::nullopt; }
+
+    std::string key(keyByteSize, '\0');
+    stream.read(key.data(), static_cast<std::streamsize>(key.size()));
+
+    if (!stream.good() || (key != indexKey)) { return std::nullopt; }
+    if (!ReadValue(stream, indexSourceByteSize) || (indexSourceByteSize != sourceByteSize)) { return std::nullopt; }
+    if (!ReadValue(stream, hduCount)) { return std::nullopt; }
+
+    const auto sourceBlockCount = (sourceByteSize + BLOCK_BYTE_SIZE.value - 1U) / BLOCK_BYTE_SIZE.value;
+
+    std::vector<HDU> hdus;
+    uintmax_t blockIndex = 0;
+
+    for (uint64_t x = 0; x < hduCount; ++x)
+    {
+        uint8_t type{0};
+        uint64_t headerBlockCount{0};
+
+        HDU hdu{};
+        hdu.isPrimary = x == 0U;
+        hdu.blockStartIndex = blockIndex;
+
+        if (!ReadValue(stream, type) || (type > static_cast<uint8_t>(HDU::Type::BinTable))) { return std::nullopt; }
+        if (!ReadValue(stream, headerBlockCount)) { return std::nullopt; }
+        if (!ReadValue(stream, hdu.numDataBlocks)) { return std::nullopt; }
+        if (!ReadValue(stream, hdu.dataByteSize)) { return std::nullopt; }
+
+        hdu.type = static_cast<HDU::Type>(type);
+
+        // As when reading HDUs from the source, each HDU must start within the source, and have at least one
+        // header block
+        if ((blockIndex >= sourceBlockCount) ||
+            (headerBlockCount == 0U) ||
+            (headerBlockCount > (sourceBlockCount - blockIndex)) ||
+            (hdu.dataByteSize > (hdu.numDataBlocks * BLOCK_BYTE_SIZE.value)))
+        {
+            return std::nullopt;
+        }
+
+        auto rawBytes = std::vector<std::byte>(headerBlockCount * BLOCK_BYTE_SIZE.value);
+        stream.read(reinterpret_cast<char*>(rawBytes.data()), static_cast<std::streamsize>(rawBytes.size()));
+
+        if (!stream.good()) { return std::nullopt; }
+
+        hdu.header = Header::FromRawBytes(std::make_shared<const std::vector<std::byte>>(std::move(rawBytes)));
+
+        blockIndex += hdu.GetTotalBlockCount();
+
+        hdus.push_back(std::move(hdu));
+    }
+
+    // The index's HDUs must cover all of the source's blocks
+    if (blockIndex < sourceBlockCount)
+    {
+        return std::nullopt;
+    }
+
+    return hdus;
+}
+
+static Result WriteHDUIndex(const std::filesystem::path& filePath,
+                            const std::string& indexKey,
+                            uintmax_t sourceByteSize,
+                            const std::vector<HDU>& hdus)
+{
+    std::ofstream stream(filePath, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+        return Result::Fail("SaveHDUIndex: Failed to open index file for writing");
+    }
+
+    WriteValue(stream, INDEX_FILE_MAGIC);
+    WriteValue(stream, INDEX_FILE_VERSION);
+    WriteValue(stream, static_cast<uint64_t>(indexKey.size()));
+    stream.write(indexKey.data(), static_cast<std::streamsize>(indexKey.size()));
+    WriteValue(stream, static_cast<uint64_t>(sourceByteSize));
+    WriteValue(stream, static_cast<uint64_t>(hdus.size()));
+
+    // Note that each HDU's position isn't written; it's implied by the HDUs which precede it
+    for (const auto& hdu : hdus)
+    {
+        // Note that lazily created headers give their raw bytes as-is, without being parsed
+        const auto rawBytes = hdu.header.GetRawBytes();
+
+        WriteValue(stream, static_cast<uint8_t>(hdu.type));
+        WriteValue(stream, static_cast<uint64_t>(hdu.header.GetNumHeaderBlocks()));
+        WriteValue(stream, static_cast<uint64_t>(hdu.numDataBlocks));
+        WriteValue(stream, static_cast<uint64_t>(hdu.dataByteSize));
+        stream.write(reinterpret_cast<const char*>(rawBytes.data()), static_cast<std::streamsize>(rawBytes.size()));
+    }
+
+    stream.close();
+
+    if (!stream.good())
+    {
+        return Result::Fail("SaveHDUIndex: Failed to write index file");
+    }
+
+    return Result::Success();
+}
+
+Result SaveHDUIndex(const std::filesystem::path& indexFilePath,
+                    const std::string& indexKey,
+                    uintmax_t sourceByteSize,
+                    const std::vector<HDU>& hdus)
+{
+    //
+    // Write the index to a temporary file, then rename it over the index file, so that the index file is
+    // never seen partially written; whether by a concurrent open, or after a failed write
+    //
+    auto tempFilePath = indexFilePath;
+    tempFilePath += ".tmp";
+
+    const auto result = WriteHDUIndex(tempFilePath, indexKey, sourceByteSize, hdus);
+    if (!result)
+    {
+        std::error_code ec;
+        std::filesystem::remove(tempFilePath, ec);
+        return result;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempFilePath, indexFilePath, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tempFilePath, ec);
+        return Result::Fail("SaveHDUIndex: Failed to replace index file: {}", ec.message());
+    }
+
+    return Result::Success();
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_HDUINDEX_H
+#define NFITS_SRC_HDUINDEX_H
+
+#include <NFITS/HDU.h>
+#include <NFITS/Result.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace NFITS
+{
+    // Helper funcs for persisting a FITS file's HDUs to a sidecar index file, so that reopening the file doesn't
+    // need to read and parse its headers again. See FITSFileOpenParams::hduIndexFilePath.
+
+    /**
+     * Loads a FITS file's HDUs from an HDU index file
+     *
+     * @param indexFilePath The index file to load
+     * @param indexKey Key which the index must have been saved with
+     * @param sourceByteSize Byte size of the FITS file the index must describe
+     *
+     * @return The HDUs, whose headers are lazily parsed, or std::nullopt if the file doesn't hold a valid index
+     * for the FITS file
+     */
+    [[nodiscard]] std::optional<std::vector<HDU>> LoadHDUIndex(const std::filesystem::path& indexFilePath,
+                                                               const std::string& indexKey,
+                                                               uintmax_t sourceByteSize);
+
+    /**
+     * Writes a FITS file's HDUs to an HDU index file
+     *
+     * @param indexFilePath The index file to write
+     * @param indexKey Key which identifies the version of the FITS file's bytes the index describes
+     * @param sourceByteSize Byte size of the FITS file
+     * @param hdus The FITS file's HDUs
+     *
+     * @return Whether the index was written successfully
+     */
+    [[nodiscard]] Result SaveHDUIndex(const std::filesystem::path& indexFilePath,
+                                      const std::string& indexKey,
+                                      uintmax_t sourceByteSize,
+                                      const std::vector<HDU>& hdus);
+}
+
+#endif //NFITS_SRC_HDUINDEX_H
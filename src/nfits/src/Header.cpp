@@ -6,87 +6,454 @@
  
 #include <NFITS/Header.h>
 
+#include "FITSFileInternal.h"
+#include "Parsing.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
 namespace NFITS
 {
 
-std::optional<KeywordRecord> Header::GetFirstKeywordRecord(const std::string& keywordName) const
+namespace
 {
-    for (const auto& headerBlock : headerBlocks)
+    // A keyword name, as the 8 space padded characters of its keyword name field
+    using KeywordNameKey = std::array<char, 8>;
+
+    uint64_t ToHashKey(const KeywordNameKey& keywordNameKey)
     {
-        for (const auto& keywordRecord : headerBlock.keywordRecords)
+        uint64_t hashKey{0};
+        std::memcpy(&hashKey, keywordNameKey.data(), sizeof(hashKey));
+        return hashKey;
+    }
+
+    /**
+     * @return The key of a keyword name, or std::nullopt if the name doesn't fit in a keyword name field
+     */
+    std::optional<KeywordNameKey> ToKeywordNameKey(std::string_view keywordName)
+    {
+        KeywordNameKey keywordNameKey{};
+
+        if (keywordName.size() > keywordNameKey.size())
         {
-            const auto blockKeywordName = keywordRecord.GetKeywordName();
-            if (blockKeywordName && (*blockKeywordName == keywordName))
-            {
-                return keywordRecord;
-            }
+            return std::nullopt;
         }
+
+        std::ranges::fill(keywordNameKey, ' ');
+        std::ranges::copy(keywordName, keywordNameKey.begin());
+
+        return keywordNameKey;
     }
 
-    return std::nullopt;
+    struct KeywordHashKeyHash
+    {
+        std::size_t operator()(uint64_t hashKey) const noexcept
+        {
+            // Keyword names share most of their characters (NAXIS1, NAXIS2, ...); mix all of the key's bits
+            // so that names which differ in any one character spread across buckets
+            hashKey ^= hashKey >> 33U;
+            hashKey *= 0xFF51AFD7ED558CCDULL;
+            hashKey ^= hashKey >> 33U;
+            return static_cast<std::size_t>(hashKey);
+        }
+    };
 }
 
-std::vector<KeywordRecord> Header::GetKeywordsStartingWith(const std::string& keywordNamePrefix) const
+struct Header::State
 {
-    std::vector<KeywordRecord> records;
+    // Raw bytes of the header's blocks, until they've been parsed. Atomic, as the raw bytes may be read without
+    // parsing (GetRawBytes) while another thread parses, and releases, them.
+    std::atomic<std::shared_ptr<const std::vector<std::byte>>> pRawBytes;
+    std::size_t numHeaderBlocks{0};
+
+    std::once_flag parseFlag;
+    std::atomic<bool> parsed{false};
+    std::vector<HeaderBlock> headerBlocks;
+
+    // Byte pattern scans of the header's blocks, when they were parsed from raw bytes; empty otherwise
+    std::vector<HeaderBlockScan> blockScans;
+
+    //
+    // Index of the header's keyword records with valid, non-empty, keyword names; built when the header's
+    // blocks are parsed. Records are identified by their position across all of the header's blocks, rather
+    // than holding copies of their names.
+    //
 
-    for (const auto& headerBlock : headerBlocks)
+    struct FirstRecord
     {
-        for (const auto& keywordRecord: headerBlock.keywordRecords)
+        // Position of the first record with the name
+        uint32_t position{0};
+
+        // Index of the record's parsed value within firstRecordValues
+        uint32_t valueIndex{0};
+    };
+
+    // Keyword name -> the first record with that name
+    std::unordered_map<uint64_t, FirstRecord, KeywordHashKeyHash> firstRecords;
+
+    // Parsed values of the first records with each name. Values are parsed the first time any of the header's
+    // values are requested, rather than when the header is parsed, as most headers' values are never requested.
+    std::once_flag valuesParseFlag;
+    std::vector<KeywordValue> firstRecordValues;
+
+    // Position of every record, sorted by name and then position, so that the records whose names share a
+    // prefix are adjacent
+    std::vector<uint32_t> sortedRecordPositions;
+
+    [[nodiscard]] const KeywordRecord& GetRecord(std::size_t position) const
+    {
+        return headerBlocks[position / KEYWORD_RECORDS_PER_HEADER_BLOCK].keywordRecords[position % KEYWORD_RECORDS_PER_HEADER_BLOCK];
+    }
+
+    [[nodiscard]] std::string_view GetRecordName(std::size_t position) const
+    {
+        const auto keywordNameRaw = GetRecord(position).GetKeywordNameRaw();
+        return {keywordNameRaw.data(), keywordNameRaw.size()};
+    }
+
+    /**
+     * @return Whether the record at a position has the given bit set in its block's scan mask, or std::nullopt
+     * if the header's blocks weren't scanned
+     */
+    [[nodiscard]] std::optional<bool> GetScanBit(std::size_t position, uint64_t HeaderBlockScan::* pMask) const
+    {
+        if (blockScans.empty()) { return std::nullopt; }
+
+        const auto& blockScan = blockScans[position / KEYWORD_RECORDS_PER_HEADER_BLOCK];
+        return ((blockScan.*pMask >> (position % KEYWORD_RECORDS_PER_HEADER_BLOCK)) & 1U) != 0U;
+    }
+
+    void Parse()
+    {
+        if (const auto pBytes = pRawBytes.load())
         {
-            const auto blockKeywordName = keywordRecord.GetKeywordName();
-            if (blockKeywordName && *blockKeywordName && ((*blockKeywordName)->starts_with(keywordNamePrefix)))
+            const std::span<const std::byte> rawBytes(*pBytes);
+
+            headerBlocks.resize(numHeaderBlocks);
+            blockScans.reserve(numHeaderBlocks);
+
+            for (std::size_t x = 0; x < numHeaderBlocks; ++x)
             {
-                records.push_back(keywordRecord);
+                blockScans.push_back(ParseHeaderBlock(rawBytes.subspan(x * BLOCK_BYTE_SIZE.value, BLOCK_BYTE_SIZE.value), headerBlocks[x]));
             }
+
+            // Only the parsed header blocks are needed from now on
+            pRawBytes.store(nullptr);
+        }
+
+        BuildIndex();
+
+        parsed = true;
+    }
+
+    void BuildIndex()
+    {
+        const auto numRecords = headerBlocks.size() * KEYWORD_RECORDS_PER_HEADER_BLOCK;
+
+        firstRecords.reserve(numRecords);
+        sortedRecordPositions.reserve(numRecords);
+
+        for (std::size_t position = 0; position < numRecords; ++position)
+        {
+            // Blank records, which commonly pad out a header's last block, have no keyword name
+            if (GetScanBit(position, &HeaderBlockScan::blankRecords).value_or(false))
+            {
+                continue;
+            }
+
+            const auto keywordNameRaw = GetRecord(position).GetKeywordNameRaw();
+
+            // Records with invalid, or no, keyword names can never be looked up by name
+            const auto keywordName = ParseKeywordName(keywordNameRaw);
+            if (!keywordName || !*keywordName)
+            {
+                continue;
+            }
+
+            KeywordNameKey keywordNameKey{};
+            std::ranges::copy(keywordNameRaw, keywordNameKey.begin());
+
+            // Note that emplace doesn't replace an existing entry, so the first record with the name is kept
+            firstRecords.emplace(ToHashKey(keywordNameKey), FirstRecord{
+                .position = static_cast<uint32_t>(position),
+                .valueIndex = static_cast<uint32_t>(firstRecords.size())
+            });
+            sortedRecordPositions.push_back(static_cast<uint32_t>(position));
+        }
+
+        // Note that the sort is stable, so records with the same name stay in position order
+        std::ranges::stable_sort(sortedRecordPositions, {}, [this](uint32_t position){ return GetRecordName(position); });
+    }
+
+    /**
+     * @return A keyword record's value; the first of integer, real, logical, or string that the value parses
+     * as, or std::monostate if it parses as none of them
+     */
+    static KeywordValue ParseKeywordValue(const KeywordRecord& keywordRecord)
+    {
+        if (const auto integerValue = keywordRecord.GetKeywordValue_AsInteger()) { return *integerValue; }
+        if (const auto realValue = keywordRecord.GetKeywordValue_AsReal()) { return *realValue; }
+        if (const auto logicalValue = keywordRecord.GetKeywordValue_AsLogical()) { return *logicalValue; }
+        if (auto stringValue = keywordRecord.GetKeywordValue_AsString()) { return std::move(*stringValue); }
+
+        return std::monostate{};
+    }
+
+    void ParseValues()
+    {
+        firstRecordValues.resize(firstRecords.size());
+
+        for (const auto& it : firstRecords)
+        {
+            // Records without a value indicator (COMMENT, HISTORY, ...) have no value to parse. Note that the typed
+            // getters still parse such a record themselves, so this only skips work, it doesn't change any results.
+            if (!GetScanBit(it.second.position, &HeaderBlockScan::valueIndicatorRecords).value_or(true))
+            {
+                continue;
+            }
+
+            firstRecordValues[it.second.valueIndex] = ParseKeywordValue(GetRecord(it.second.position));
+        }
+    }
+};
+
+Header::Header(std::vector<HeaderBlock> headerBlocks)
+    : m_pState(std::make_shared<State>())
+{
+    m_pState->numHeaderBlocks = headerBlocks.size();
+    m_pState->headerBlocks = std::move(headerBlocks);
+
+    // The header blocks are already parsed; index them now
+    (void)GetParsedState();
+}
+
+Header Header::FromRawBytes(std::shared_ptr<const std::vector<std::byte>> pRawBytes)
+{
+    Header header{};
+    header.m_pState = std::make_shared<State>();
+    header.m_pState->numHeaderBlocks = pRawBytes->size() / BLOCK_BYTE_SIZE.value;
+    header.m_pState->pRawBytes = std::move(pRawBytes);
+
+    return header;
+}
+
+const Header::State* Header::GetParsedState() const
+{
+    if (!m_pState)
+    {
+        return nullptr;
+    }
+
+    std::call_once(m_pState->parseFlag, [this](){ m_pState->Parse(); });
+
+    return m_pState.get();
+}
+
+const std::vector<HeaderBlock>& Header::GetHeaderBlocks() const
+{
+    static const std::vector<HeaderBlock> EMPTY_HEADER_BLOCKS;
+
+    const auto pState = GetParsedState();
+
+    return pState ? pState->headerBlocks : EMPTY_HEADER_BLOCKS;
+}
+
+std::size_t Header::GetNumHeaderBlocks() const noexcept
+{
+    return m_pState ? m_pState->numHeaderBlocks : 0U;
+}
+
+bool Header::IsParsed() const noexcept
+{
+    return !m_pState || m_pState->parsed;
+}
+
+std::vector<std::byte> Header::GetRawBytes() const
+{
+    if (!m_pState)
+    {
+        return {};
+    }
+
+    // If the header hasn't been parsed yet, its raw bytes are still available as-is
+    if (const auto pRawBytes = m_pState->pRawBytes.load())
+    {
+        return *pRawBytes;
+    }
+
+    std::vector<std::byte> rawBytes;
+    rawBytes.reserve(GetNumHeaderBlocks() * BLOCK_BYTE_SIZE.value);
+
+    for (const auto& headerBlock : GetHeaderBlocks())
+    {
+        for (const auto& keywordRecord : headerBlock.keywordRecords)
+        {
+            const auto keywordRecordRaw = keywordRecord.GetKeywordRecordRaw();
+            std::ranges::transform(keywordRecordRaw, std::back_inserter(rawBytes), [](char c){ return static_cast<std::byte>(c); });
         }
     }
 
+    return rawBytes;
+}
+
+std::optional<KeywordRecord> Header::GetFirstKeywordRecord(const std::string& keywordName) const
+{
+    const auto pState = GetParsedState();
+    if (!pState)
+    {
+        return std::nullopt;
+    }
+
+    const auto keywordNameKey = ToKeywordNameKey(keywordName);
+    if (!keywordNameKey)
+    {
+        return std::nullopt;
+    }
+
+    const auto it = pState->firstRecords.find(ToHashKey(*keywordNameKey));
+    if (it == pState->firstRecords.cend())
+    {
+        return std::nullopt;
+    }
+
+    return pState->GetRecord(it->second.position);
+}
+
+std::vector<KeywordRecord> Header::GetKeywordsStartingWith(const std::string& keywordNamePrefix) const
+{
+    const auto pState = GetParsedState();
+    if (!pState || (keywordNamePrefix.size() > std::tuple_size_v<KeywordNameKey>))
+    {
+        return {};
+    }
+
+    //
+    // Find the range of sorted names which start with the prefix
+    //
+    const auto prefixOf = [&](uint32_t position){
+        return pState->GetRecordName(position).substr(0, keywordNamePrefix.size());
+    };
+
+    const auto [first, last] = std::ranges::equal_range(pState->sortedRecordPositions, std::string_view(keywordNamePrefix), {}, prefixOf);
+
+    // Return the matching records in header order
+    std::vector<uint32_t> positions(first, last);
+    std::ranges::sort(positions);
+
+    std::vector<KeywordRecord> records;
+    records.reserve(positions.size());
+
+    std::ranges::transform(positions, std::back_inserter(records), [&](const auto& position){ return pState->GetRecord(position); });
+
     return records;
 }
 
+const Header::KeywordValue* Header::GetFirstKeywordValue(const std::string& keywordName) const
+{
+    if (GetParsedState() == nullptr)
+    {
+        return nullptr;
+    }
+
+    const auto keywordNameKey = ToKeywordNameKey(keywordName);
+    if (!keywordNameKey)
+    {
+        return nullptr;
+    }
+
+    std::call_once(m_pState->valuesParseFlag, [this](){ m_pState->ParseValues(); });
+
+    const auto it = m_pState->firstRecords.find(ToHashKey(*keywordNameKey));
+    if (it == m_pState->firstRecords.cend())
+    {
+        return nullptr;
+    }
+
+    return &m_pState->firstRecordValues[it->second.valueIndex];
+}
+
+//
+// The typed getters return a record's parsed value when it's of the requested type. Otherwise, the record
+// is parsed as the requested type, which fails, so that the error is the same as from the record itself.
+// The one exception is integer values, which are also valid real values.
+//
+
 std::expected<int64_t, Error> Header::GetFirstKeywordRecord_AsInteger(const std::string& keywordName) const
 {
-    const auto keywordRecord = GetFirstKeywordRecord(keywordName);
-    if (!keywordRecord)
+    const auto pValue = GetFirstKeywordValue(keywordName);
+    if (!pValue)
     {
         return std::unexpected(Error::Msg("No such keyword record exists: {}", keywordName));
     }
 
-    return keywordRecord->GetKeywordValue_AsInteger();
+    if (const auto pIntegerValue = std::get_if<int64_t>(pValue))
+    {
+        return *pIntegerValue;
+    }
+
+    return GetFirstKeywordRecord(keywordName)->GetKeywordValue_AsInteger();
 }
 
 std::expected<double, Error> Header::GetFirstKeywordRecord_AsReal(const std::string& keywordName) const
 {
-    const auto keywordRecord = GetFirstKeywordRecord(keywordName);
-    if (!keywordRecord)
+    const auto pValue = GetFirstKeywordValue(keywordName);
+    if (!pValue)
     {
         return std::unexpected(Error::Msg("No such keyword record exists: {}", keywordName));
     }
 
-    return keywordRecord->GetKeywordValue_AsReal();
+    if (const auto pRealValue = std::get_if<double>(pValue))
+    {
+        return *pRealValue;
+    }
+
+    if (const auto pIntegerValue = std::get_if<int64_t>(pValue))
+    {
+        return static_cast<double>(*pIntegerValue);
+    }
+
+    return GetFirstKeywordRecord(keywordName)->GetKeywordValue_AsReal();
 }
 
 std::expected<bool, Error> Header::GetFirstKeywordRecord_AsLogical(const std::string& keywordName) const
 {
-    const auto keywordRecord = GetFirstKeywordRecord(keywordName);
-    if (!keywordRecord)
+    const auto pValue = GetFirstKeywordValue(keywordName);
+    if (!pValue)
     {
         return std::unexpected(Error::Msg("No such keyword record exists: {}", keywordName));
     }
 
-    return keywordRecord->GetKeywordValue_AsLogical();
+    if (const auto pLogicalValue = std::get_if<bool>(pValue))
+    {
+        return *pLogicalValue;
+    }
+
+    return GetFirstKeywordRecord(keywordName)->GetKeywordValue_AsLogical();
 }
 
 std::expected<std::string, Error> Header::GetFirstKeywordRecord_AsString(const std::string& keywordName) const
 {
-    const auto keywordRecord = GetFirstKeywordRecord(keywordName);
-    if (!keywordRecord)
+    const auto pValue = GetFirstKeywordValue(keywordName);
+    if (!pValue)
     {
         return std::unexpected(Error::Msg("No such keyword record exists: {}", keywordName));
     }
 
-    return keywordRecord->GetKeywordValue_AsString();
+    if (const auto pStringValue = std::get_if<std::string>(pValue))
+    {
+        return *pStringValue;
+    }
+
+    return GetFirstKeywordRecord(keywordName)->GetKeywordValue_AsString();
 }
 
 }
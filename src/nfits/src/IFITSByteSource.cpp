@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/IFITSByteSource.h>
+
+#include "Util/ThreadPool.h"
+#include "Util/ReadRequestUtil.h"
+
+#include <NFITS/Def.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace NFITS
+{
+
+Result IFITSByteSource::ReadBytesV(std::span<const ReadRequest> requests)
+{
+    if (!AreRequestDstsValid(requests))
+    {
+        return Result::Fail("IFITSByteSource::ReadBytesV: dst size is too small for requested read");
+    }
+
+    const auto orderedIndices = GetOrderedRequestIndices(requests);
+
+    std::vector<std::byte> runBytes;
+
+    std::size_t runStartIndex = 0;
+
+    while (runStartIndex < orderedIndices.size())
+    {
+        //
+        // Gather the run of requests, starting from the run's first request, which are separated by gaps small
+        // enough to read through, without the run growing beyond the size of one bulk read
+        //
+        const auto runByteOffset = requests[orderedIndices[runStartIndex]].byteOffset.value;
+        auto runEndOffset = runByteOffset + requests[orderedIndices[runStartIndex]].byteSize.value;
+
+        std::size_t runEndIndex = runStartIndex + 1;
+
+        while (runEndIndex < orderedIndices.size())
+        {
+            const auto& request = requests[orderedIndices[runEndIndex]];
+            const auto requestEndOffset = std::max(runEndOffset, request.byteOffset.value + request.byteSize.value);
+
+            if ((request.byteOffset.value > runEndOffset + READV_COALESCE_GAP_BYTE_SIZE.value) ||
+                (requestEndOffset - runByteOffset > READ_CHUNK_BYTE_SIZE.value))
+            {
+                break;
+            }
+
+            runEndOffset = requestEndOffset;
+            runEndIndex++;
+        }
+
+        const auto runByteSize = ByteSize(runEndOffset - runByteOffset);
+
+        //
+        // Read the run's bytes, and copy each request's portion of them to its dst. A run of one request,
+        // which needs no copying, is read directly into its dst.
+        //
+        std::span<const std::byte> runSpan;
+
+        if (const auto runView = GetBytesView(ByteOffset(runByteOffset), runByteSize))
+        {
+            runSpan = *runView;
+        }
+        else if (runEndIndex - runStartIndex == 1)
+        {
+            const auto& request = requests[orderedIndices[runStartIndex]];
+
+            const auto result = ReadBytes(request.dst, request.byteOffset, request.byteSize);
+            if (!result)
+            {
+                return result;
+            }
+
+            runStartIndex = runEndIndex;
+            continue;
+        }
+        else
+        {
+            runBytes.resize(static_cast<std::size_t>(runByteSize.value));
+
+            const auto result = ReadBytes(runBytes, ByteOffset(runByteOffset), runByteSize);
+            if (!result)
+            {
+                return result;
+            }
+
+            runSpan = runBytes;
+        }
+
+        for (auto x = runStartIndex; x < runEndIndex; ++x)
+        {
+            const auto& request = requests[orderedIndices[x]];
+
+            std::ranges::copy(runSpan.subspan(request.byteOffset.value - runByteOffset, request.byteSize.value), request.dst.begin());
+        }
+
+        runStartIndex = runEndIndex;
+    }
+
+    return Result::Success();
+}
+
+std::future<Result> IFITSByteSource::ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    // Sources which don't support concurrent reads can't be read from another thread while the caller
+    // potentially continues to use them, so read synchronously
+    if (!SupportsConcurrentReads())
+    {
+        std::promise<Result> promise;
+        promise.set_value(ReadBytes(dst, byteOffset, byteSize));
+        return promise.get_future();
+    }
+
+    return GetIOThreadPool().Submit([this, dst, byteOffset, byteSize](){
+        return ReadBytes(dst, byteOffset, byteSize);
+    });
+}
+
+std::optional<std::span<const std::byte>> IFITSByteSource::GetBytesView(const ByteOffset&, const ByteSize&) const
+{
+    // By default, sources don't hold their bytes in addressable memory
+    return std::nullopt;
+}
+
+void IFITSByteSource::AdviseAccess(const ByteOffset&, const ByteSize&, ByteAccessHint)
+{
+    // By default, access hints are ignored
+}
+
+}
@@ -25,7 +25,7 @@ FlattenedImageSliceSource::Create(std::vector<std::unique_ptr<ImageSliceSource>>
     std::optional<int64_t> height;
     uintmax_t globalNumSlices = 0;
 
-    std::vector<std::span<const double>> globalSliceSpans;
+    std::vector<PhysicalValuesView> globalSliceSpans;
 
     for (const auto& source : sources)
     {
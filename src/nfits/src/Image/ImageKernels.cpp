@@ -0,0 +1,313 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "ImageKernels.h"
+
+// AVX2 kernels are compiled for their own target, and only run if the CPU supports them
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define NFITS_KERNELS_AVX2
+    #include <immintrin.h>
+#endif
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+namespace NFITS
+{
+
+namespace
+{
+    template <std::size_t Size> struct UIntOfSize;
+    template <> struct UIntOfSize<1> { using Type = uint8_t; };
+    template <> struct UIntOfSize<2> { using Type = uint16_t; };
+    template <> struct UIntOfSize<4> { using Type = uint32_t; };
+    template <> struct UIntOfSize<8> { using Type = uint64_t; };
+
+    template <typename T>
+    inline T LoadBigEndian(const std::byte* pSrc) noexcept
+    {
+        using UInt = typename UIntOfSize<sizeof(T)>::Type;
+
+        UInt value{};
+        std::memcpy(&value, pSrc, sizeof(T));
+
+        if constexpr ((std::endian::native != std::endian::big) && (sizeof(T) > 1))
+        {
+            value = std::byteswap(value);
+        }
+
+        return std::bit_cast<T>(value);
+    }
+
+    /**
+     * @return The transform's blank value, if it's set and can match a value of type T, as an int32
+     */
+    template <typename T>
+    std::optional<int32_t> GetMatchableBlank(const PhysicalValueTransform& transform)
+    {
+        if constexpr (std::integral<T>)
+        {
+            if (transform.blank &&
+                (*transform.blank >= std::numeric_limits<int32_t>::lowest()) &&
+                (*transform.blank <= std::numeric_limits<int32_t>::max()))
+            {
+                return static_cast<int32_t>(*transform.blank);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    //
+    // Scalar kernels
+    //
+
+    template <typename T>
+    void DecodeBigEndianScalar(const std::byte* pSrc, T* pDst, std::size_t numValues)
+    {
+        for (std::size_t x = 0; x < numValues; ++x)
+        {
+            pDst[x] = LoadBigEndian<T>(pSrc + (x * sizeof(T)));
+        }
+    }
+
+    template <typename T, typename Out>
+    void DecodeToPhysicalScalar(const std::byte* pSrc, Out* pDst, std::size_t numValues, const PhysicalValueTransform& transform)
+    {
+        for (std::size_t x = 0; x < numValues; ++x)
+        {
+            pDst[x] = static_cast<Out>(transform.Apply(LoadBigEndian<T>(pSrc + (x * sizeof(T)))));
+        }
+    }
+
+#if defined(NFITS_KERNELS_AVX2)
+
+    bool CPUSupportsAVX2()
+    {
+        static const bool supportsAVX2 = __builtin_cpu_supports("avx2");
+        return supportsAVX2;
+    }
+
+    /**
+     * @return A byte shuffle mask which reverses the bytes of each Size byte value within 16 bytes
+     */
+    template <std::size_t Size>
+    constexpr std::array<int8_t, 16> ByteSwapMask()
+    {
+        std::array<int8_t, 16> mask{};
+        for (std::size_t x = 0; x < mask.size(); ++x)
+        {
+            mask[x] = static_cast<int8_t>(((x / Size) * Size) + (Size - 1U - (x % Size)));
+        }
+        return mask;
+    }
+
+    template <std::size_t Size>
+    __attribute__((target("avx2"))) __m128i LoadByteSwapMask128()
+    {
+        static constexpr auto mask = ByteSwapMask<Size>();
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data()));
+    }
+
+    template <std::size_t Size>
+    __attribute__((target("avx2"))) __m256i LoadByteSwapMask256()
+    {
+        return _mm256_broadcastsi128_si256(LoadByteSwapMask128<Size>());
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) void DecodeBigEndianAVX2(const std::byte* pSrc, T* pDst, std::size_t numValues)
+    {
+        static constexpr std::size_t VALUES_PER_VECTOR = 32U / sizeof(T);
+
+        const auto mask = LoadByteSwapMask256<sizeof(T)>();
+
+        std::size_t x = 0;
+
+        for (; (x + VALUES_PER_VECTOR) <= numValues; x += VALUES_PER_VECTOR)
+        {
+            const auto values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + (x * sizeof(T))));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + x), _mm256_shuffle_epi8(values, mask));
+        }
+
+        DecodeBigEndianScalar(pSrc + (x * sizeof(T)), pDst + x, numValues - x);
+    }
+
+    /**
+     * Loads four big endian values of type T, as native doubles, and, for integral types, sets the lanes of
+     * blankMask for values which match the blank value
+     */
+    template <typename T>
+    __attribute__((target("avx2"))) __m256d LoadFourAsDoubles(const std::byte* pSrc, __m128i blankValue, bool checkBlank, __m256d& blankMask)
+    {
+        __m128i intValues{};
+
+        if constexpr (std::same_as<T, uint8_t>)
+        {
+            int32_t packed{0};
+            std::memcpy(&packed, pSrc, sizeof(packed));
+            intValues = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+        }
+        else if constexpr (std::same_as<T, int16_t>)
+        {
+            const auto values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc));
+            intValues = _mm_cvtepi16_epi32(_mm_shuffle_epi8(values, LoadByteSwapMask128<2>()));
+        }
+        else if constexpr (std::same_as<T, int32_t>)
+        {
+            const auto values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+            intValues = _mm_shuffle_epi8(values, LoadByteSwapMask128<4>());
+        }
+        else if constexpr (std::same_as<T, float>)
+        {
+            const auto values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+            return _mm256_cvtps_pd(_mm_castsi128_ps(_mm_shuffle_epi8(values, LoadByteSwapMask128<4>())));
+        }
+        else
+        {
+            static_assert(std::same_as<T, double>);
+            const auto values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc));
+            return _mm256_castsi256_pd(_mm256_shuffle_epi8(values, LoadByteSwapMask256<8>()));
+        }
+
+        if (checkBlank)
+        {
+            blankMask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(intValues, blankValue)));
+        }
+
+        return _mm256_cvtepi32_pd(intValues);
+    }
+
+    template <typename T, typename Out>
+    __attribute__((target("avx2"))) void DecodeToPhysicalAVX2(const std::byte* pSrc, Out* pDst, std::size_t numValues, const PhysicalValueTransform& transform)
+    {
+        const auto blank = GetMatchableBlank<T>(transform);
+        const auto blankValue = _mm_set1_epi32(blank.value_or(0));
+        const auto nan = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+        const auto zero = _mm256_set1_pd(transform.zero);
+        const auto scale = _mm256_set1_pd(transform.scale);
+
+        std::size_t x = 0;
+
+        for (; (x + 4U) <= numValues; x += 4U)
+        {
+            __m256d blankMask = _mm256_setzero_pd();
+
+            const auto values = LoadFourAsDoubles<T>(pSrc + (x * sizeof(T)), blankValue, blank.has_value(), blankMask);
+
+            // Note: a separate multiply and add, rather than a fused multiply-add, so that results are identical
+            // to the scalar transform
+            auto physicalValues = _mm256_add_pd(zero, _mm256_mul_pd(scale, values));
+
+            if (blank)
+            {
+                physicalValues = _mm256_blendv_pd(physicalValues, nan, blankMask);
+            }
+
+            if constexpr (std::same_as<Out, double>)
+            {
+                _mm256_storeu_pd(pDst + x, physicalValues);
+            }
+            else
+            {
+                _mm_storeu_ps(pDst + x, _mm256_cvtpd_ps(physicalValues));
+            }
+        }
+
+        DecodeToPhysicalScalar<T>(pSrc + (x * sizeof(T)), pDst + x, numValues - x, transform);
+    }
+
+#endif
+
+    template <typename T>
+    void DecodeBigEndian(std::span<const std::byte> src, std::span<T> dst)
+    {
+        if constexpr (sizeof(T) == 1)
+        {
+            std::memcpy(dst.data(), src.data(), dst.size());
+        }
+        else
+        {
+        #if defined(NFITS_KERNELS_AVX2)
+            if (CPUSupportsAVX2())
+            {
+                DecodeBigEndianAVX2(src.data(), dst.data(), dst.size());
+                return;
+            }
+        #endif
+
+            DecodeBigEndianScalar(src.data(), dst.data(), dst.size());
+        }
+    }
+
+    template <typename T, typename Out>
+    void DecodeToPhysical(std::span<const std::byte> src, const PhysicalValueTransform& transform, std::span<Out> dst)
+    {
+    #if defined(NFITS_KERNELS_AVX2)
+        if (CPUSupportsAVX2())
+        {
+            DecodeToPhysicalAVX2<T>(src.data(), dst.data(), dst.size(), transform);
+            return;
+        }
+    #endif
+
+        DecodeToPhysicalScalar<T>(src.data(), dst.data(), dst.size(), transform);
+    }
+
+    template <typename Out>
+    Result DecodeToPhysical(std::span<const std::byte> src, int64_t bitpix, const PhysicalValueTransform& transform, std::span<Out> dst)
+    {
+        const auto bytesPerValue = static_cast<std::size_t>(bitpix < 0 ? -bitpix : bitpix) / 8U;
+
+        if ((bytesPerValue != 0) && ((src.size() / bytesPerValue) < dst.size()))
+        {
+            return Result::Fail("DecodeBigEndianToPhysicalValues: src holds too few values");
+        }
+
+        switch (bitpix)
+        {
+            case 8:     DecodeToPhysical<uint8_t>(src, transform, dst); break;
+            case 16:    DecodeToPhysical<int16_t>(src, transform, dst); break;
+            case 32:    DecodeToPhysical<int32_t>(src, transform, dst); break;
+            case -32:   DecodeToPhysical<float>(src, transform, dst); break;
+            case -64:   DecodeToPhysical<double>(src, transform, dst); break;
+            default:
+            {
+                return Result::Fail("DecodeBigEndianToPhysicalValues: Unsupported bitpix value: {}", bitpix);
+            }
+        }
+
+        return Result::Success();
+    }
+}
+
+void DecodeBigEndianValues(std::span<const std::byte> src, std::span<uint8_t> dst) { DecodeBigEndian(src, dst); }
+void DecodeBigEndianValues(std::span<const std::byte> src, std::span<int16_t> dst) { DecodeBigEndian(src, dst); }
+void DecodeBigEndianValues(std::span<const std::byte> src, std::span<int32_t> dst) { DecodeBigEndian(src, dst); }
+void DecodeBigEndianValues(std::span<const std::byte> src, std::span<float> dst) { DecodeBigEndian(src, dst); }
+void DecodeBigEndianValues(std::span<const std::byte> src, std::span<double> dst) { DecodeBigEndian(src, dst); }
+
+Result DecodeBigEndianToPhysicalValues(std::span<const std::byte> src,
+                                       int64_t bitpix,
+                                       const PhysicalValueTransform& transform,
+                                       std::span<float> dst)
+{
+    return DecodeToPhysical(src, bitpix, transform, dst);
+}
+
+Result DecodeBigEndianToPhysicalValues(std::span<const std::byte> src,
+                                       int64_t bitpix,
+                                       const PhysicalValueTransform& transform,
+                                       std::span<double> dst)
+{
+    return DecodeToPhysical(src, bitpix, transform, dst);
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_IMAGE_IMAGEKERNELS_H
+#define NFITS_SRC_IMAGE_IMAGEKERNELS_H
+
+#include <NFITS/Result.h>
+#include <NFITS/SharedLib.h>
+#include <NFITS/Image/PhysicalValues.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace NFITS
+{
+    //
+    // Kernels which decode raw, big endian, FITS image values. On x86 they're vectorized with AVX2 when the
+    // CPU supports it, as detected at runtime, and otherwise fall back to scalar loops.
+    //
+
+    /**
+     * Decodes big endian values into native endianness values.
+     *
+     * @param src The big endian values; must hold at least dst.size() values
+     * @param dst The output values
+     */
+    NFITS_PUBLIC void DecodeBigEndianValues(std::span<const std::byte> src, std::span<uint8_t> dst);
+    NFITS_PUBLIC void DecodeBigEndianValues(std::span<const std::byte> src, std::span<int16_t> dst);
+    NFITS_PUBLIC void DecodeBigEndianValues(std::span<const std::byte> src, std::span<int32_t> dst);
+    NFITS_PUBLIC void DecodeBigEndianValues(std::span<const std::byte> src, std::span<float> dst);
+    NFITS_PUBLIC void DecodeBigEndianValues(std::span<const std::byte> src, std::span<double> dst);
+
+    /**
+     * Decodes big endian values, of the data type determined by bitpix, straight into physical values. In one
+     * pass, each value is byte swapped, mapped to NaN if it matches the transform's blank value, and scaled and
+     * offset by the transform. The results are identical to PhysicalValueTransform::Apply.
+     *
+     * @param src The big endian values; must hold at least dst.size() values
+     * @param bitpix The bitpix of the values
+     * @param transform The transform from the values to physical values
+     * @param dst The output physical values
+     *
+     * @return Whether the values were decoded; fails for an unsupported bitpix, or too few src bytes
+     */
+    [[nodiscard]] NFITS_PUBLIC Result DecodeBigEndianToPhysicalValues(std::span<const std::byte> src,
+                                                                      int64_t bitpix,
+                                                                      const PhysicalValueTransform& transform,
+                                                                      std::span<float> dst);
+
+    [[nodiscard]] NFITS_PUBLIC Result DecodeBigEndianToPhysicalValues(std::span<const std::byte> src,
+                                                                      int64_t bitpix,
+                                                                      const PhysicalValueTransform& transform,
+                                                                      std::span<double> dst);
+}
+
+#endif //NFITS_SRC_IMAGE_IMAGEKERNELS_H
@@ -6,10 +6,15 @@
  
 #include "ImagePipeline.h"
 
-#include "../Util/Endianness.h"
+#include "ImageKernels.h"
 
+#include "../Util/ThreadPool.h"
+
+#include <algorithm>
 #include <ranges>
 #include <numeric>
+#include <optional>
+#include <type_traits>
 
 namespace NFITS
 {
@@ -28,84 +33,61 @@ void ApplyPhysicalValueTransform(std::vector<double>& values, double zero, doubl
 
 ////
 
-template<std::integral DataType>
-std::vector<double> RawValuesToDoubles(std::span<const std::byte> data, const std::optional<int64_t>& blank)
+std::expected<RawImageValues, Error> CreateRawImageValues(int64_t bitpix, std::size_t numValues)
 {
-    // Interpret the data as its underlying data type
-    const auto typedData = std::span<const DataType>(
-        reinterpret_cast<const DataType*>(data.data()),
-        data.size() / sizeof(DataType)
-    );
-
-    std::vector<double> values;
-    values.reserve(typedData.size());
-
-    std::ranges::transform(typedData, std::back_inserter(values), [&](auto val){
-        // Convert raw value to the endianness for this machine as needed
-        FixEndiannessPacked(val);
-
-        // Integral values have an optional "blank" value. If matched, return nan
-        if (blank && (val == *blank))
+    switch (bitpix)
+    {
+        case 8:     return RawImageValues(std::vector<uint8_t>(numValues));
+        case 16:    return RawImageValues(std::vector<int16_t>(numValues));
+        case 32:    return RawImageValues(std::vector<int32_t>(numValues));
+        case -32:   return RawImageValues(std::vector<float>(numValues));
+        case -64:   return RawImageValues(std::vector<double>(numValues));
+        default:
         {
-            return std::numeric_limits<double>::quiet_NaN();
+            return std::unexpected(Error::Msg("Unsupported bitpix value: {}", bitpix));
         }
-
-        // Interpret the raw value as a double
-        return static_cast<double>(val);
-    });
-
-    return values;
+    }
 }
 
-template<std::floating_point DataType>
-std::vector<double> RawValuesToDoubles(std::span<const std::byte> data)
+Result DecodeRawImageData(std::span<const std::byte> data, RawImageValues& rawValues, std::size_t valueOffset)
 {
-    // Interpret the data as its underlying data type
-    const auto typedData = std::span<const DataType>(
-        reinterpret_cast<const DataType*>(data.data()),
-        data.size() / sizeof(DataType)
-    );
+    return std::visit([&](auto& values){
+        using DataType = typename std::remove_reference_t<decltype(values)>::value_type;
 
-    std::vector<double> values;
-    values.reserve(typedData.size());
+        if ((data.size() % sizeof(DataType)) != 0)
+        {
+            return Result::Fail("DecodeRawImageData: Data isn't a whole number of values");
+        }
 
-    std::ranges::transform(typedData, std::back_inserter(values), [&](auto val){
-        // Convert raw value to the endianness for this machine as needed
-        FixEndiannessPacked(val);
+        const auto numValues = data.size() / sizeof(DataType);
 
-        // Interpret the raw value as a double
-        return static_cast<double>(val);
-    });
+        if ((valueOffset > values.size()) || (numValues > (values.size() - valueOffset)))
+        {
+            return Result::Fail("DecodeRawImageData: Data doesn't fit within the storage");
+        }
+
+        DecodeBigEndianValues(data, std::span<DataType>(values).subspan(valueOffset, numValues));
 
-    return values;
+        return Result::Success();
+    }, rawValues);
 }
 
-std::expected<std::vector<double>, Error> RawImageDataToPhysicalValues(std::span<const std::byte> data,
-                                                                       int64_t bitpix,
-                                                                       double bZero,
-                                                                       double bScale,
-                                                                       const std::optional<int64_t>& blank)
+Result ToFloat32PhysicalValues(const PhysicalValuesView& values, std::span<float> dst)
 {
-    // Convert the raw data to doubles
-    std::vector<double> values;
-
-    switch (bitpix)
+    if (dst.size() < values.size())
     {
-        case 8:     values = RawValuesToDoubles<uint8_t>(data, blank); break;
-        case 16:    values = RawValuesToDoubles<int16_t>(data, blank); break;
-        case 32:    values = RawValuesToDoubles<int32_t>(data, blank); break;
-        case -32:   values = RawValuesToDoubles<float>(data); break;
-        case -64:   values = RawValuesToDoubles<double>(data); break;
-        default:
-        {
-            return std::unexpected(Error::Msg("Unsupported bitpix value: {}", bitpix));
-        }
+        return Result::Fail("ToFloat32PhysicalValues: dst is too small for the values");
     }
 
-    // Apply transform to convert from raw values to physical values
-    ApplyPhysicalValueTransform(values, bZero, bScale);
+    const auto& transform = values.GetTransform();
 
-    return values;
+    values.Visit([&](const auto& rawValues){
+        std::ranges::transform(rawValues, dst.begin(), [&](const auto& rawValue){
+            return static_cast<float>(transform.Apply(rawValue));
+        });
+    });
+
+    return Result::Success();
 }
 
 ////
@@ -119,15 +101,6 @@ inline uintmax_t GetSliceDataSize(const ImageSliceSpan& sliceSpan)
         static_cast<uintmax_t>(sliceSpan.axes.at(1));
 }
 
-inline std::span<const double> GetSliceDataSpan(const ImageSliceSpan& sliceSpan,
-                                                const uintmax_t& sliceIndex,
-                                                std::span<const double> data)
-{
-    const auto sliceDataSize = GetSliceDataSize(sliceSpan);
-
-    return data.subspan(sliceIndex * sliceDataSize, sliceDataSize);
-}
-
 inline uint64_t GetNumSliceCubes(const ImageSliceSpan& sliceSpan)
 {
     if (sliceSpan.axes.empty())      { return 0U; }
@@ -150,41 +123,122 @@ inline uintmax_t GetSliceCubeDataSize(const ImageSliceSpan& sliceSpan)
     return static_cast<uintmax_t>(slicesPerCube) * sliceDataSize;
 }
 
-inline std::span<const double> GetSliceCubeDataSpan(const ImageSliceSpan& sliceSpan,
-                                                    const uintmax_t& sliceCubeIndex,
-                                                    std::span<const double> data)
+std::vector<std::pair<uint64_t, PhysicalMinMax>> CalculateSliceMinMaxes(const PhysicalValuesView& values,
+                                                                        std::size_t valueOffset,
+                                                                        const ImageSliceSpan& sliceSpan)
 {
-    const auto sliceCubeDataSize = GetSliceCubeDataSize(sliceSpan);
+    std::vector<std::pair<uint64_t, PhysicalMinMax>> sliceMinMaxes;
 
-    return data.subspan(sliceCubeIndex * sliceCubeDataSize, sliceCubeDataSize);
+    const auto sliceDataSize = GetSliceDataSize(sliceSpan);
+    if (sliceDataSize == 0)
+    {
+        return sliceMinMaxes;
+    }
+
+    const auto numSlices = GetNumSlicesInSpan(sliceSpan);
+    const auto valuesEnd = static_cast<uintmax_t>(valueOffset) + values.size();
+
+    for (uintmax_t valueIndex = valueOffset; valueIndex < valuesEnd;)
+    {
+        const auto sliceIndex = valueIndex / sliceDataSize;
+        if (sliceIndex >= numSlices)
+        {
+            break;
+        }
+
+        const auto sliceValuesEnd = std::min((sliceIndex + 1U) * sliceDataSize, valuesEnd);
+        const auto sliceValues = values.subspan(static_cast<std::size_t>(valueIndex - valueOffset),
+                                                static_cast<std::size_t>(sliceValuesEnd - valueIndex));
+
+        sliceMinMaxes.emplace_back(sliceIndex, CalculatePhysicalMinMax(sliceValues));
+
+        valueIndex = sliceValuesEnd;
+    }
+
+    return sliceMinMaxes;
 }
 
-std::vector<PhysicalStats> CalculateSlicePhysicalStats(const std::vector<double>& physicalValues,
-                                                       const ImageSliceSpan& sliceSpan)
+ImagePhysicalStats CalculateImagePhysicalStats(const PhysicalValuesView& physicalValues,
+                                               const ImageSliceSpan& sliceSpan,
+                                               const std::vector<PhysicalMinMax>& sliceMinMaxes)
 {
-    std::vector<PhysicalStats> slicePhysicalStats;
+    const auto numSlices = static_cast<std::size_t>(GetNumSlicesInSpan(sliceSpan));
+    const auto numSliceCubes = static_cast<std::size_t>(GetNumSliceCubes(sliceSpan));
+    const auto sliceDataSize = GetSliceDataSize(sliceSpan);
+    const auto slicesPerCube = (sliceDataSize == 0) ? 1U : static_cast<std::size_t>(GetSliceCubeDataSize(sliceSpan) / sliceDataSize);
+
+    //
+    // A slice cube's min/max is the union of its slices' min/max
+    //
+    std::vector<PhysicalMinMax> sliceCubeMinMaxes(numSliceCubes);
 
-    for (uint64_t sliceIndex = 0; sliceIndex < GetNumSlicesInSpan(sliceSpan); ++sliceIndex)
+    for (std::size_t sliceIndex = 0; sliceIndex < std::min(numSlices, sliceMinMaxes.size()); ++sliceIndex)
     {
-        const auto sliceData = GetSliceDataSpan(sliceSpan, sliceIndex, physicalValues);
-        slicePhysicalStats.push_back(CompilePhysicalStats({sliceData}));
+        sliceCubeMinMaxes.at(sliceIndex / slicesPerCube).Merge(sliceMinMaxes[sliceIndex]);
+    }
+
+    //
+    // Compile each slice's histogram, along with its slice cube's histogram of the slice's values, from one pass
+    // over the slice's values
+    //
+    ImagePhysicalStats imagePhysicalStats{};
+    imagePhysicalStats.slicePhysicalStats.resize(numSlices);
+
+    std::vector<std::optional<PhysicalHistogram>> sliceCubeHistograms(numSlices);
+
+    (void)ParallelForEachIndex(GetComputeThreadPool(), numSlices, [&](std::size_t sliceIndex, std::size_t){
+        const auto& sliceMinMax = sliceMinMaxes.at(sliceIndex);
+        const auto& sliceCubeMinMax = sliceCubeMinMaxes.at(sliceIndex / slicesPerCube);
+
+        PhysicalHistogram sliceHistogram(sliceMinMax);
+        PhysicalHistogram sliceCubeHistogram(sliceCubeMinMax);
+
+        const auto sliceValues = physicalValues.subspan(static_cast<std::size_t>(sliceIndex * sliceDataSize),
+                                                        static_cast<std::size_t>(sliceDataSize));
+
+        ForEachFinitePhysicalValue(sliceValues, [&](double value){
+            sliceHistogram.Add(value);
+            sliceCubeHistogram.Add(value);
+        });
+
+        imagePhysicalStats.slicePhysicalStats[sliceIndex] = ToPhysicalStats(sliceMinMax, std::move(sliceHistogram));
+        sliceCubeHistograms[sliceIndex] = std::move(sliceCubeHistogram);
+
+        return Result::Success();
+    });
+
+    //
+    // Combine each slice cube's histograms of its slices' values
+    //
+    for (std::size_t sliceCubeIndex = 0; sliceCubeIndex < numSliceCubes; ++sliceCubeIndex)
+    {
+        const auto& sliceCubeMinMax = sliceCubeMinMaxes[sliceCubeIndex];
+
+        PhysicalHistogram sliceCubeHistogram(sliceCubeMinMax);
+
+        for (std::size_t sliceIndex = sliceCubeIndex * slicesPerCube;
+             sliceIndex < std::min((sliceCubeIndex + 1U) * slicesPerCube, numSlices);
+             ++sliceIndex)
+        {
+            sliceCubeHistogram.Merge(*sliceCubeHistograms[sliceIndex]);
+        }
+
+        imagePhysicalStats.sliceCubePhysicalStats.push_back(ToPhysicalStats(sliceCubeMinMax, std::move(sliceCubeHistogram)));
     }
 
-    return slicePhysicalStats;
+    return imagePhysicalStats;
 }
 
-std::vector<PhysicalStats> CalculateSliceCubePhysicalStats(const std::vector<double>& physicalValues,
-                                                           const ImageSliceSpan& sliceSpan)
+ImagePhysicalStats CalculateImagePhysicalStats(const PhysicalValuesView& physicalValues, const ImageSliceSpan& sliceSpan)
 {
-    std::vector<PhysicalStats> sliceCubePhysicalStats;
+    std::vector<PhysicalMinMax> sliceMinMaxes(static_cast<std::size_t>(GetNumSlicesInSpan(sliceSpan)));
 
-    for (uint64_t sliceCubeIndex = 0; sliceCubeIndex < GetNumSliceCubes(sliceSpan); ++sliceCubeIndex)
+    for (const auto& [sliceIndex, sliceMinMax] : CalculateSliceMinMaxes(physicalValues, 0, sliceSpan))
     {
-        const auto sliceCubeData = GetSliceCubeDataSpan(sliceSpan, sliceCubeIndex, physicalValues);
-        sliceCubePhysicalStats.push_back(CompilePhysicalStats({sliceCubeData}));
+        sliceMinMaxes.at(static_cast<std::size_t>(sliceIndex)) = sliceMinMax;
     }
 
-    return sliceCubePhysicalStats;
+    return CalculateImagePhysicalStats(physicalValues, sliceSpan, sliceMinMaxes);
 }
 
 }
\ No newline at end of file
@@ -8,11 +8,17 @@
 #define NFITS_SRC_IMAGE_IMAGEPIPELINE_H
 
 #include <NFITS/Error.h>
+#include <NFITS/Result.h>
+#include <NFITS/SharedLib.h>
 #include <NFITS/Data/ImageData.h>
+#include <NFITS/Image/PhysicalValues.h>
+
+#include "PhysicalStatsInternal.h"
 
 #include <vector>
 #include <expected>
 #include <memory>
+#include <utility>
 
 namespace NFITS
 {
@@ -22,33 +28,76 @@ namespace NFITS
     void ApplyPhysicalValueTransform(std::vector<double>& values, double zero, double scale);
 
     /**
-     * Transforms raw from file, uncompressed, image values into physical values.
+     * Allocates storage for numValues of an image's raw values, of the data type determined by bitpix.
+     *
+     * @return The (zero-initialized) storage, or Error if bitpix isn't supported
+     */
+    [[nodiscard]] std::expected<RawImageValues, Error> CreateRawImageValues(int64_t bitpix, std::size_t numValues);
+
+    /**
+     * Decodes raw from file, uncompressed, image data into an image's raw values storage.
+     *
+     * Interprets the bytes as a sequence of values of the storage's data type, fixes the endianness of those
+     * values as needed, and writes them into the storage starting at valueOffset. Physical values are derived
+     * from the stored values when they're accessed; see PhysicalValuesView.
+     *
+     * @param data The input image data; a whole number of values
+     * @param rawValues The storage to write the decoded values into
+     * @param valueOffset The index of the storage's value to write the first decoded value to
+     *
+     * @return Whether the data was decoded successfully
+     */
+    [[nodiscard]] Result DecodeRawImageData(std::span<const std::byte> data, RawImageValues& rawValues, std::size_t valueOffset);
+
+    /**
+     * Derives physical values from an image's values, and writes them, narrowed to float32, into dst.
      *
-     * Interprets the bytes as a sequence of values of data type determined by bitpix,
-     * fixes the endianness of those values as needed, and applies the physical value
-     * transform, returning the result as a collection of doubles.
+     * @return Whether the values were converted successfully; fails if dst is smaller than the values
+     */
+    [[nodiscard]] Result ToFloat32PhysicalValues(const PhysicalValuesView& values, std::span<float> dst);
+
+    /**
+     * Physical stats compiled for each slice, and each slice cube, of an image
+     */
+    struct ImagePhysicalStats
+    {
+        std::vector<PhysicalStats> slicePhysicalStats;
+        std::vector<PhysicalStats> sliceCubePhysicalStats;
+    };
+
+    /**
+     * Calculates the min/max of the finite physical values within each slice of an image that a range of the
+     * image's values overlaps. Lets the min/max be compiled from each chunk of an image's values as it's loaded,
+     * while the chunk is still in cache.
      *
-     * @param data The input image values
-     * @param bitpix The bitpix of the raw data
-     * @param bZero bZero to apply for the physical value transform
-     * @param bScale bScale to apply for the physical value transform
-     * @param blank Optional value for undefined values, only relevant for integral bitpix values
+     * @param values The range of the image's values
+     * @param valueOffset The index, within the image's values, of the range's first value
+     * @param sliceSpan The image's slice span
      *
-     * @return The resulting physical values, or Error on error
+     * @return A (slice index, min/max) pair for each slice the range overlaps, in slice order
      */
-    [[nodiscard]] std::expected<std::vector<double>, Error> RawImageDataToPhysicalValues(
-        std::span<const std::byte> data,
-        int64_t bitpix,
-        double bZero,
-        double bScale,
-        const std::optional<int64_t>& blank
-    );
+    [[nodiscard]] std::vector<std::pair<uint64_t, PhysicalMinMax>> CalculateSliceMinMaxes(const PhysicalValuesView& values,
+                                                                                           std::size_t valueOffset,
+                                                                                           const ImageSliceSpan& sliceSpan);
 
-    [[nodiscard]] std::vector<PhysicalStats> CalculateSlicePhysicalStats(const std::vector<double>& physicalValues,
-                                                                         const ImageSliceSpan& sliceSpan);
+    /**
+     * Compiles the physical stats of every slice, and every slice cube, of an image, given the min/max of each of
+     * its slices. Makes a single pass over the image's values, in which each slice's histogram is compiled along
+     * with its contribution to its slice cube's histogram, with slices spread across the compute thread pool.
+     *
+     * @param physicalValues All of the image's values
+     * @param sliceSpan The image's slice span
+     * @param sliceMinMaxes The min/max of each of the image's slices
+     */
+    [[nodiscard]] NFITS_PUBLIC ImagePhysicalStats CalculateImagePhysicalStats(const PhysicalValuesView& physicalValues,
+                                                                              const ImageSliceSpan& sliceSpan,
+                                                                              const std::vector<PhysicalMinMax>& sliceMinMaxes);
 
-    [[nodiscard]] std::vector<PhysicalStats> CalculateSliceCubePhysicalStats(const std::vector<double>& physicalValues,
-                                                                             const ImageSliceSpan& sliceSpan);
+    /**
+     * As above, but first calculates the min/max of each of the image's slices, in a pass of its own
+     */
+    [[nodiscard]] NFITS_PUBLIC ImagePhysicalStats CalculateImagePhysicalStats(const PhysicalValuesView& physicalValues,
+                                                                              const ImageSliceSpan& sliceSpan);
 }
 
 #endif //NFITS_SRC_IMAGE_IMAGEPIPELINE_H
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <algorithm>
 #include <cassert>
+#include <vector>
 
 namespace NFITS
 {
@@ -80,17 +81,22 @@ std::expected<ImageRender, bool> PhysicalValuesToImage(const ImageSlice& imageSl
     //
     auto imageRender = ImageRender(ImageRender::Format::RGB888, imageSlice.width, imageSlice.height);
 
+    // The physical values of the scanline being rendered, derived from the slice's stored values in bulk
+    std::vector<double> scanlinePhysicalValues(static_cast<std::size_t>(imageSlice.width));
+
     for (uint64_t y = 0; y < imageSlice.height; ++y)
     {
         // Note that unofficial FITS standard is for images to be stored bottom to top, so y=0
         // corresponds to the bottom scanline, visually, of the image
         unsigned char* pScanline = imageRender.GetScanLineBytesStart(y);
 
+        imageSlice.physicalValues
+            .subspan(static_cast<std::size_t>(y * imageSlice.width), static_cast<std::size_t>(imageSlice.width))
+            .CopyTo(scanlinePhysicalValues);
+
         for (uint64_t x = 0; x < imageSlice.width; ++x)
         {
-            const auto physicalValueIndex = x + (y * imageSlice.width);
-
-            auto physicalValue = imageSlice.physicalValues[physicalValueIndex];
+            auto physicalValue = scanlinePhysicalValues[static_cast<std::size_t>(x)];
 
             // If the physical value is nan, signifying a blank value, then output the
             // blank color for the pixel and immediately continue to the next pixel
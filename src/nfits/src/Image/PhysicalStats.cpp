@@ -6,76 +6,55 @@
  
 #include <NFITS/Image/PhysicalStats.h>
 
+#include "PhysicalStatsInternal.h"
+
 #include <numeric>
-#include <cmath>
 
 namespace NFITS
 {
 
-static constexpr std::size_t HISTOGRAM_NUM_BINS = 100;
-
-void CalculateMinMax(PhysicalStats& physicalStats, const std::vector<std::span<const double>>& values)
+PhysicalMinMax CalculatePhysicalMinMax(const PhysicalValuesView& values)
 {
-    physicalStats.minMax = {
-        std::numeric_limits<double>::max(),
-        std::numeric_limits<double>::lowest()
-    };
+    PhysicalMinMax minMax{};
 
-    for (const auto& span : values)
-    {
-        for (const auto& value : span)
-        {
-            // Skip over nan/infinity values
-            if (!std::isfinite(value)) { continue; }
+    ForEachFinitePhysicalValue(values, [&](double value){
+        minMax.Add(value);
+    });
 
-            physicalStats.minMax.first = std::min(physicalStats.minMax.first, value);
-            physicalStats.minMax.second = std::max(physicalStats.minMax.second, value);
-        }
-    }
+    return minMax;
 }
 
-void CalculateHistogram(PhysicalStats& physicalStats, const std::vector<std::span<const double>>& values)
+PhysicalStats ToPhysicalStats(const PhysicalMinMax& minMax, PhysicalHistogram histogram)
 {
-    const auto rangeMin = physicalStats.minMax.first;
-    const auto rangeMax = physicalStats.minMax.second;
-    const auto rangeSpan = rangeMax - rangeMin;
-
-    physicalStats.histogram = std::vector<std::size_t>(HISTOGRAM_NUM_BINS, 0);
-
-    for (const auto& span : values)
-    {
-        for (const auto& value : span)
-        {
-            // Skip over nan/infinity values
-            if (!std::isfinite(value)) { continue; }
+    PhysicalStats physicalStats{};
+    physicalStats.minMax = minMax.minMax;
+    physicalStats.histogram = histogram.TakeBins();
 
-            const auto binIndex = static_cast<std::size_t>(((value - rangeMin) / rangeSpan) * (double) (HISTOGRAM_NUM_BINS - 1));
+    physicalStats.histogramCumulative = std::vector<std::size_t>(HISTOGRAM_NUM_BINS, 0);
+    std::partial_sum(physicalStats.histogram.cbegin(), physicalStats.histogram.cend(), physicalStats.histogramCumulative.begin());
 
-            physicalStats.histogram[binIndex]++;
-        }
-    }
+    return physicalStats;
 }
 
-void CalculateHistogramCumulative(PhysicalStats& physicalStats)
+PhysicalStats CompilePhysicalStats(const std::vector<PhysicalValuesView>& values)
 {
-    physicalStats.histogramCumulative = std::vector<std::size_t>(HISTOGRAM_NUM_BINS, 0);
-    physicalStats.histogramCumulative.at(0) = physicalStats.histogram.at(0);
+    PhysicalMinMax minMax{};
 
-    for (std::size_t binIndex = 1; binIndex < HISTOGRAM_NUM_BINS; ++binIndex)
+    for (const auto& view : values)
     {
-        physicalStats.histogramCumulative.at(binIndex) = physicalStats.histogramCumulative.at(binIndex - 1) + physicalStats.histogram.at(binIndex);
+        minMax.Merge(CalculatePhysicalMinMax(view));
     }
-}
 
-PhysicalStats CompilePhysicalStats(const std::vector<std::span<const double>>& values)
-{
-    PhysicalStats physicalStats{};
+    PhysicalHistogram histogram(minMax);
 
-    CalculateMinMax(physicalStats, values);
-    CalculateHistogram(physicalStats, values);
-    CalculateHistogramCumulative(physicalStats);
+    for (const auto& view : values)
+    {
+        ForEachFinitePhysicalValue(view, [&](double value){
+            histogram.Add(value);
+        });
+    }
 
-    return physicalStats;
+    return ToPhysicalStats(minMax, std::move(histogram));
 }
 
 }
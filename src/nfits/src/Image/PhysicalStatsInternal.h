@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_IMAGE_PHYSICALSTATSINTERNAL_H
+#define NFITS_SRC_IMAGE_PHYSICALSTATSINTERNAL_H
+
+#include <NFITS/Image/PhysicalStats.h>
+#include <NFITS/Image/PhysicalValues.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace NFITS
+{
+    inline constexpr std::size_t HISTOGRAM_NUM_BINS = 100;
+
+    /**
+     * Invokes func with each finite physical value of the view. Dispatches on the view's raw value type once,
+     * rather than once per value.
+     */
+    template <typename Func>
+    void ForEachFinitePhysicalValue(const PhysicalValuesView& view, const Func& func)
+    {
+        const auto& transform = view.GetTransform();
+
+        view.Visit([&](const auto& rawValues){
+            for (const auto& rawValue : rawValues)
+            {
+                const auto value = transform.Apply(rawValue);
+
+                // Skip over nan/infinity values
+                if (!std::isfinite(value)) { continue; }
+
+                func(value);
+            }
+        });
+    }
+
+    /**
+     * Min/max of a set of physical values. Starts out inverted, as (max, lowest), which is also the min/max
+     * of a set which holds no finite values.
+     */
+    struct PhysicalMinMax
+    {
+        std::pair<double, double> minMax{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+
+        void Add(double value) noexcept
+        {
+            minMax.first = std::min(minMax.first, value);
+            minMax.second = std::max(minMax.second, value);
+        }
+
+        void Merge(const PhysicalMinMax& other) noexcept
+        {
+            minMax.first = std::min(minMax.first, other.minMax.first);
+            minMax.second = std::max(minMax.second, other.minMax.second);
+        }
+    };
+
+    /**
+     * @return The min/max of the view's finite physical values
+     */
+    [[nodiscard]] PhysicalMinMax CalculatePhysicalMinMax(const PhysicalValuesView& values);
+
+    /**
+     * Histogram of physical values, with HISTOGRAM_NUM_BINS bins spread over a fixed range. Every value added
+     * must be within the range.
+     */
+    class PhysicalHistogram
+    {
+        public:
+
+            explicit PhysicalHistogram(const PhysicalMinMax& range)
+                : m_rangeMin(range.minMax.first)
+                , m_rangeSpan(range.minMax.second - range.minMax.first)
+                , m_bins(HISTOGRAM_NUM_BINS, 0)
+            { }
+
+            void Add(double value) noexcept
+            {
+                // Note: a range which holds a single value puts every value in the first bin
+                const auto binIndex = (m_rangeSpan > 0.0) ?
+                    static_cast<std::size_t>(((value - m_rangeMin) / m_rangeSpan) * (double) (HISTOGRAM_NUM_BINS - 1)) : 0U;
+
+                m_bins[binIndex]++;
+            }
+
+            /**
+             * Adds the counts of another histogram, which must cover the same range, to this one
+             */
+            void Merge(const PhysicalHistogram& other) noexcept
+            {
+                for (std::size_t binIndex = 0; binIndex < HISTOGRAM_NUM_BINS; ++binIndex)
+                {
+                    m_bins[binIndex] += other.m_bins[binIndex];
+                }
+            }
+
+            [[nodiscard]] std::vector<std::size_t> TakeBins() noexcept { return std::move(m_bins); }
+
+        private:
+
+            double m_rangeMin;
+            double m_rangeSpan;
+            std::vector<std::size_t> m_bins;
+    };
+
+    /**
+     * @return PhysicalStats compiled from a set of values' min/max and histogram
+     */
+    [[nodiscard]] PhysicalStats ToPhysicalStats(const PhysicalMinMax& minMax, PhysicalHistogram histogram);
+}
+
+#endif //NFITS_SRC_IMAGE_PHYSICALSTATSINTERNAL_H
@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/Image/PhysicalValues.h>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace NFITS
+{
+
+PhysicalValuesView::PhysicalValuesView(RawValuesSpan rawValues, PhysicalValueTransform transform)
+    : m_rawValues(rawValues)
+    , m_transform(std::move(transform))
+{
+
+}
+
+PhysicalValuesView::PhysicalValuesView(std::span<const double> physicalValues)
+    : m_rawValues(physicalValues)
+{
+
+}
+
+PhysicalValuesView::PhysicalValuesView(const RawImageValues& rawValues, PhysicalValueTransform transform)
+    : m_rawValues(std::visit([](const auto& values){ return RawValuesSpan(std::span(values)); }, rawValues))
+    , m_transform(std::move(transform))
+{
+
+}
+
+std::size_t PhysicalValuesView::size() const noexcept
+{
+    return std::visit([](const auto& rawValues){ return rawValues.size(); }, m_rawValues);
+}
+
+double PhysicalValuesView::operator[](std::size_t index) const
+{
+    return std::visit([&](const auto& rawValues){ return m_transform.Apply(rawValues[index]); }, m_rawValues);
+}
+
+PhysicalValuesView PhysicalValuesView::subspan(std::size_t offset, std::size_t count) const
+{
+    return {
+        std::visit([&](const auto& rawValues){ return RawValuesSpan(rawValues.subspan(offset, count)); }, m_rawValues),
+        m_transform
+    };
+}
+
+void PhysicalValuesView::CopyTo(std::span<double> dst) const
+{
+    assert(dst.size() >= size());
+
+    std::visit([&](const auto& rawValues){
+        std::ranges::transform(rawValues, dst.begin(), [&](const auto& rawValue){
+            return m_transform.Apply(rawValue);
+        });
+    }, m_rawValues);
+}
+
+}
@@ -0,0 +1,208 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/InstrumentedFITSByteSource.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+namespace NFITS
+{
+
+//
+// LatencyHistogram
+//
+void LatencyHistogram::Record(std::chrono::nanoseconds duration)
+{
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+    std::size_t bucketIndex = 0;
+
+    if (us > 0)
+    {
+        bucketIndex = std::min(static_cast<std::size_t>(std::bit_width(static_cast<uint64_t>(us))), BUCKET_COUNT - 1U);
+    }
+
+    buckets[bucketIndex]++;
+}
+
+uint64_t LatencyHistogram::GetCount() const
+{
+    return std::accumulate(buckets.cbegin(), buckets.cend(), uint64_t{0});
+}
+
+std::chrono::microseconds LatencyHistogram::GetPercentile(double percentile) const
+{
+    const auto count = GetCount();
+    if (count == 0)
+    {
+        return std::chrono::microseconds(0);
+    }
+
+    // Number of operations, in latency order, which must be covered to reach the percentile
+    const auto targetCount = std::max(
+        uint64_t{1},
+        static_cast<uint64_t>(std::ceil((std::clamp(percentile, 0.0, 100.0) / 100.0) * static_cast<double>(count)))
+    );
+
+    uint64_t coveredCount = 0;
+
+    for (std::size_t x = 0; x < BUCKET_COUNT; ++x)
+    {
+        coveredCount += buckets[x];
+
+        if (coveredCount >= targetCount)
+        {
+            // Upper bound of the bucket
+            return std::chrono::microseconds(int64_t{1} << x);
+        }
+    }
+
+    return std::chrono::microseconds(int64_t{1} << (BUCKET_COUNT - 1U));
+}
+
+//
+// InstrumentedFITSByteSource
+//
+std::unique_ptr<InstrumentedFITSByteSource> InstrumentedFITSByteSource::Create(std::unique_ptr<IFITSByteSource> pSource)
+{
+    return std::make_unique<InstrumentedFITSByteSource>(Tag{}, std::move(pSource));
+}
+
+InstrumentedFITSByteSource::InstrumentedFITSByteSource(InstrumentedFITSByteSource::Tag, std::unique_ptr<IFITSByteSource> pSource)
+    : m_pSource(std::move(pSource))
+{
+
+}
+
+InstrumentedFITSByteSource::~InstrumentedFITSByteSource() = default;
+
+ByteSourceIOStats InstrumentedFITSByteSource::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+void InstrumentedFITSByteSource::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats = {};
+}
+
+std::expected<ByteSize, Error> InstrumentedFITSByteSource::GetByteSize() const
+{
+    return m_pSource->GetByteSize();
+}
+
+Result InstrumentedFITSByteSource::Resize(const ByteSize& byteSize)
+{
+    return m_pSource->Resize(byteSize);
+}
+
+Result InstrumentedFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto result = m_pSource->ReadBytes(dst, byteOffset, byteSize);
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+
+    RecordOp(m_stats.reads, result, byteSize.value, duration);
+
+    return result;
+}
+
+Result InstrumentedFITSByteSource::ReadBytesV(std::span<const ReadRequest> requests)
+{
+    uintmax_t totalByteSize = 0;
+
+    for (const auto& request : requests)
+    {
+        totalByteSize += request.byteSize.value;
+    }
+
+    // Passed through as a vectored read, so that the wrapped source can still coalesce the requests
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto result = m_pSource->ReadBytesV(requests);
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+
+    RecordOp(m_stats.reads, result, totalByteSize, duration);
+
+    return result;
+}
+
+std::future<Result> InstrumentedFITSByteSource::ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // Note: deferred, so that the read is recorded on the thread which collects its result, without tying up
+    // a thread to wait for the wrapped source's read to finish
+    return std::async(std::launch::deferred, [this, byteSize, startTime, read = m_pSource->ReadBytesAsync(dst, byteOffset, byteSize)]() mutable {
+        auto result = read.get();
+        RecordOp(m_stats.reads, result, byteSize.value, std::chrono::steady_clock::now() - startTime);
+        return result;
+    });
+}
+
+Result InstrumentedFITSByteSource::WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto result = m_pSource->WriteBytes(src, byteOffset, byteSize, flush);
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+
+    RecordOp(m_stats.writes, result, byteSize.value, duration);
+
+    return result;
+}
+
+Result InstrumentedFITSByteSource::Flush()
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto result = m_pSource->Flush();
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+
+    RecordOp(m_stats.flushes, result, 0U, duration);
+
+    return result;
+}
+
+std::optional<std::span<const std::byte>> InstrumentedFITSByteSource::GetBytesView(const ByteOffset& byteOffset,
+                                                                                   const ByteSize& byteSize) const
+{
+    auto view = m_pSource->GetBytesView(byteOffset, byteSize);
+
+    if (view)
+    {
+        RecordOp(m_stats.views, Result::Success(), byteSize.value, std::chrono::nanoseconds(0));
+    }
+
+    return view;
+}
+
+void InstrumentedFITSByteSource::AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint)
+{
+    m_pSource->AdviseAccess(byteOffset, byteSize, hint);
+}
+
+void InstrumentedFITSByteSource::RecordOp(ByteSourceOpStats& opStats, const Result& result, uintmax_t byteSize, std::chrono::nanoseconds duration) const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+
+    opStats.count++;
+    opStats.totalDuration += duration;
+    opStats.latency.Record(duration);
+
+    if (result())
+    {
+        opStats.byteSize += byteSize;
+    }
+    else
+    {
+        opStats.failedCount++;
+    }
+}
+
+}
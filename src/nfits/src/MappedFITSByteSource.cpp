@@ -0,0 +1,276 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/MappedFITSByteSource.h>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace NFITS
+{
+
+std::expected<std::unique_ptr<MappedFITSByteSource>, Error> MappedFITSByteSource::Open(const std::filesystem::path& filePath)
+{
+    auto source = std::make_unique<MappedFITSByteSource>(Tag{}, filePath);
+
+    const auto result = source->Map();
+    if (!result)
+    {
+        return std::unexpected(*result.error);
+    }
+
+    return source;
+}
+
+MappedFITSByteSource::MappedFITSByteSource(MappedFITSByteSource::Tag, std::filesystem::path filePath)
+    : m_filePath(std::move(filePath))
+{
+
+}
+
+MappedFITSByteSource::~MappedFITSByteSource()
+{
+    Unmap();
+}
+
+std::expected<ByteSize, Error> MappedFITSByteSource::GetByteSize() const
+{
+    return ByteSize{m_byteSize};
+}
+
+Result MappedFITSByteSource::Resize(const ByteSize&)
+{
+    return Result::Fail("MappedFITSByteSource::Resize: Source is read-only");
+}
+
+Result MappedFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("MappedFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    const auto view = GetBytesView(byteOffset, byteSize);
+    if (!view)
+    {
+        return Result::Fail("MappedFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+    }
+
+    if (!view->empty())
+    {
+        memcpy(dst.data(), view->data(), view->size());
+    }
+
+    return Result::Success();
+}
+
+Result MappedFITSByteSource::WriteBytes(std::span<const std::byte>, const ByteOffset&, const ByteSize&, bool)
+{
+    return Result::Fail("MappedFITSByteSource::WriteBytes: Source is read-only");
+}
+
+Result MappedFITSByteSource::Flush()
+{
+    // no-op, nothing is ever written to the source
+
+    return Result::Success();
+}
+
+std::optional<std::span<const std::byte>> MappedFITSByteSource::GetBytesView(const ByteOffset& byteOffset,
+                                                                              const ByteSize& byteSize) const
+{
+    if ((byteOffset.value > m_byteSize) || (byteSize.value > (m_byteSize - byteOffset.value)))
+    {
+        return std::nullopt;
+    }
+
+    if (byteSize.value == 0)
+    {
+        return std::span<const std::byte>{};
+    }
+
+    return std::span<const std::byte>(m_pData + byteOffset.value, byteSize.value);
+}
+
+#if defined(_WIN32)
+
+void MappedFITSByteSource::AdviseAccess(const ByteOffset&, const ByteSize&, ByteAccessHint)
+{
+    // No madvise equivalent which is worth the trouble; the hint is ignored
+}
+
+Result MappedFITSByteSource::Map()
+{
+    const auto hFile = CreateFileW(
+        m_filePath.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return Result::Fail("MappedFITSByteSource: Failed to open the file");
+    }
+    m_hFile = hFile;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(hFile, &fileSize))
+    {
+        Unmap();
+        return Result::Fail("MappedFITSByteSource: Failed to determine the file's size");
+    }
+    m_byteSize = static_cast<std::uintmax_t>(fileSize.QuadPart);
+
+    // Empty files can't be mapped; they're represented by a null mapping instead
+    if (m_byteSize == 0)
+    {
+        return Result::Success();
+    }
+
+    const auto hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (hMapping == nullptr)
+    {
+        Unmap();
+        return Result::Fail("MappedFITSByteSource: Failed to create a file mapping");
+    }
+    m_hMapping = hMapping;
+
+    const auto pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (pData == nullptr)
+    {
+        Unmap();
+        return Result::Fail("MappedFITSByteSource: Failed to map a view of the file");
+    }
+    m_pData = static_cast<const std::byte*>(pData);
+
+    return Result::Success();
+}
+
+void MappedFITSByteSource::Unmap()
+{
+    if (m_pData != nullptr)
+    {
+        UnmapViewOfFile(m_pData);
+        m_pData = nullptr;
+    }
+
+    if (m_hMapping != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(m_hMapping));
+        m_hMapping = nullptr;
+    }
+
+    if (m_hFile != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(m_hFile));
+        m_hFile = nullptr;
+    }
+
+    m_byteSize = 0;
+}
+
+#else
+
+void MappedFITSByteSource::AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint)
+{
+    const auto view = GetBytesView(byteOffset, byteSize);
+    if (!view || view->empty())
+    {
+        return;
+    }
+
+    int advice = MADV_NORMAL;
+
+    switch (hint)
+    {
+        case ByteAccessHint::Normal:        advice = MADV_NORMAL; break;
+        case ByteAccessHint::Sequential:    advice = MADV_SEQUENTIAL; break;
+        case ByteAccessHint::Random:        advice = MADV_RANDOM; break;
+        case ByteAccessHint::WillNeed:      advice = MADV_WILLNEED; break;
+    }
+
+    // madvise requires a page-aligned start address, so widen the range down to the start of its first page
+    static const auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+
+    const auto startAddress = reinterpret_cast<std::uintptr_t>(view->data());
+    const auto alignedStartAddress = startAddress - (startAddress % pageSize);
+    const auto alignedByteSize = view->size() + (startAddress - alignedStartAddress);
+
+    // Advice is only a hint; failure to apply it is of no consequence
+    (void)madvise(reinterpret_cast<void*>(alignedStartAddress), alignedByteSize, advice);
+}
+
+Result MappedFITSByteSource::Map()
+{
+    m_fd = open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0)
+    {
+        return Result::Fail("MappedFITSByteSource: Failed to open the file");
+    }
+
+    struct stat fileStat{};
+    if (fstat(m_fd, &fileStat) != 0)
+    {
+        Unmap();
+        return Result::Fail("MappedFITSByteSource: Failed to determine the file's size");
+    }
+    m_byteSize = static_cast<std::uintmax_t>(fileStat.st_size);
+
+    // Empty files can't be mapped; they're represented by a null mapping instead
+    if (m_byteSize == 0)
+    {
+        return Result::Success();
+    }
+
+    // Note that the mapping doesn't follow the file's size; see the class's warning about truncated files
+    void* pData = mmap(nullptr, m_byteSize, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (pData == MAP_FAILED)
+    {
+        Unmap();
+        return Result::Fail("MappedFITSByteSource: Failed to memory map the file");
+    }
+    m_pData = static_cast<const std::byte*>(pData);
+
+    return Result::Success();
+}
+
+void MappedFITSByteSource::Unmap()
+{
+    if (m_pData != nullptr)
+    {
+        munmap(const_cast<std::byte*>(m_pData), m_byteSize);
+        m_pData = nullptr;
+    }
+
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+
+    m_byteSize = 0;
+}
+
+#endif
+
+}
@@ -6,8 +6,18 @@
  
 #include "Parsing.h"
 
+// SSE2 is part of the x86-64 baseline, so needs no runtime detection
+#if defined(__SSE2__) || defined(_M_X64)
+    #define NFITS_SCAN_SSE2
+    #include <emmintrin.h>
+#endif
+
 #include <algorithm>
+#include <array>
+#include <charconv>
 #include <queue>
+#include <string_view>
+#include <system_error>
 
 namespace NFITS
 {
@@ -118,6 +128,65 @@ bool ParseValueIndicator(KeywordValueIndicatorCSpan valueIndicatorSpan)
     return valueIndicatorSpan[0] == '=' && valueIndicatorSpan[1] == ' ';
 }
 
+HeaderBlockScan ScanHeaderBlock_Scalar(BlockCSpan blockSpan)
+{
+    HeaderBlockScan scan{};
+
+    const auto* pBlock = reinterpret_cast<const char*>(blockSpan.data());
+
+    for (unsigned int recordIndex = 0; recordIndex < KEYWORD_RECORDS_PER_HEADER_BLOCK; ++recordIndex)
+    {
+        const auto recordSpan = std::span<const char>(pBlock + (recordIndex * KEYWORD_RECORD_BYTE_SIZE.value), KEYWORD_RECORD_BYTE_SIZE.value);
+        const auto recordBit = uint64_t{1} << recordIndex;
+
+        if (std::string_view(recordSpan.data(), 8) == "END     ") { scan.endRecords |= recordBit; }
+        if ((recordSpan[8] == '=') && (recordSpan[9] == ' ')) { scan.valueIndicatorRecords |= recordBit; }
+        if (std::ranges::all_of(recordSpan, IsSpaceChar)) { scan.blankRecords |= recordBit; }
+    }
+
+    return scan;
+}
+
+HeaderBlockScan ScanHeaderBlock(BlockCSpan blockSpan)
+{
+#if defined(NFITS_SCAN_SSE2)
+    HeaderBlockScan scan{};
+
+    const auto* pBlock = reinterpret_cast<const char*>(blockSpan.data());
+
+    // A record's first 16 bytes, if its keyword name is END and it has a value indicator; compared byte by byte,
+    // bits 0-7 of the compare's mask are set for an END keyword name, and bits 8-9 for a value indicator
+    const auto headPattern = _mm_setr_epi8('E', 'N', 'D', ' ', ' ', ' ', ' ', ' ', '=', ' ', 0, 0, 0, 0, 0, 0);
+    const auto spaces = _mm_set1_epi8(' ');
+
+    for (unsigned int recordIndex = 0; recordIndex < KEYWORD_RECORDS_PER_HEADER_BLOCK; ++recordIndex)
+    {
+        const auto* pRecord = pBlock + (recordIndex * KEYWORD_RECORD_BYTE_SIZE.value);
+        const auto recordBit = uint64_t{1} << recordIndex;
+
+        const auto head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRecord));
+
+        const auto headMask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(head, headPattern)));
+        if ((headMask & 0xFFU) == 0xFFU) { scan.endRecords |= recordBit; }
+        if ((headMask & 0x300U) == 0x300U) { scan.valueIndicatorRecords |= recordBit; }
+
+        // The record's 80 bytes are exactly five 16 byte vectors
+        auto blank = _mm_cmpeq_epi8(head, spaces);
+        for (std::size_t offset = 16; offset < KEYWORD_RECORD_BYTE_SIZE.value; offset += 16)
+        {
+            const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRecord + offset));
+            blank = _mm_and_si128(blank, _mm_cmpeq_epi8(chunk, spaces));
+        }
+
+        if (_mm_movemask_epi8(blank) == 0xFFFF) { scan.blankRecords |= recordBit; }
+    }
+
+    return scan;
+#else
+    return ScanHeaderBlock_Scalar(blockSpan);
+#endif
+}
+
 /**
  * Scans forwards through a keyword record looking for the start of a comment, which is
  * defined by a forward slash that's not within a string. If a comment doesn't exist,
@@ -170,6 +239,27 @@ std::optional<std::size_t> FindCommentStartIndex(KeywordRecordCSpan keywordRecor
     return std::nullopt;
 }
 
+/**
+ * @return A number's characters without their leading '+' sign, if any, or std::nullopt if they start with more
+ * than one sign
+ */
+static std::optional<std::string_view> WithoutLeadingPlusSign(std::string_view numberStr)
+{
+    if (!numberStr.starts_with('+'))
+    {
+        return numberStr;
+    }
+
+    numberStr.remove_prefix(1);
+
+    if (!numberStr.empty() && IsSignChar(numberStr.front()))
+    {
+        return std::nullopt;
+    }
+
+    return numberStr;
+}
+
 /**
  * Parses an integer value out of a value span. Handles both fixed and free-floating integer values.
  *
@@ -185,14 +275,18 @@ std::optional<std::size_t> FindCommentStartIndex(KeywordRecordCSpan keywordRecor
  */
 std::expected<int64_t, Error> ParseValue_AsInteger(std::span<const char> valueSpan)
 {
-    std::string valStr;
+    // Position of the value's characters within the span
+    std::size_t valStart = 0;
+    std::size_t valEnd = 0;
 
     bool reachedNonSpaceChar = false;
     bool atLeastOneDigit = false;
     bool reachedStop = false;
 
-    for (const auto& c : valueSpan)
+    for (std::size_t pos = 0; pos < valueSpan.size(); ++pos)
     {
+        const auto& c = valueSpan[pos];
+
         const bool isDigitChar = IsDigit(c);
         const bool isSignChar = IsSignChar(c);
         const bool isValidChar = isDigitChar || isSignChar;
@@ -203,6 +297,11 @@ std::expected<int64_t, Error> ParseValue_AsInteger(std::span<const char> valueSp
         {
             continue;
         }
+        if (!reachedNonSpaceChar)
+        {
+            valStart = pos;
+            valEnd = pos;
+        }
         reachedNonSpaceChar = true;
 
         // Error if any non-space characters follow the value
@@ -219,7 +318,7 @@ std::expected<int64_t, Error> ParseValue_AsInteger(std::span<const char> valueSp
 
         if (isValidChar)
         {
-            valStr.push_back(c);
+            valEnd = pos + 1;
         }
         else if (isSpaceChar)
         {
@@ -242,18 +341,28 @@ std::expected<int64_t, Error> ParseValue_AsInteger(std::span<const char> valueSp
         return std::unexpected(Error::Msg("ParseValue_AsInteger: Require at least one valid digit"));
     }
 
-    try
-    {
-        return std::stol(valStr);
-    }
-    catch (const std::invalid_argument&)
+    const auto valStr = std::string_view(valueSpan.data() + valStart, valEnd - valStart);
+
+    // Note that std::from_chars doesn't accept a leading '+' sign
+    const auto numberStr = WithoutLeadingPlusSign(valStr);
+    if (!numberStr)
     {
         return std::unexpected(Error::Msg("ParseValue_AsInteger: No conversion to integer could be performed: {}", valStr));
     }
-    catch (const std::out_of_range&)
+
+    int64_t value{0};
+    const auto [ptr, ec] = std::from_chars(numberStr->data(), numberStr->data() + numberStr->size(), value);
+
+    if (ec == std::errc::result_out_of_range)
     {
         return std::unexpected(Error::Msg("ParseValue_AsInteger: Value out of range: {}", valStr));
     }
+    if ((ec != std::errc{}) || (ptr != numberStr->data() + numberStr->size()))
+    {
+        return std::unexpected(Error::Msg("ParseValue_AsInteger: No conversion to integer could be performed: {}", valStr));
+    }
+
+    return value;
 }
 
 std::expected<int64_t, Error> ParseKeywordValue_AsInteger(KeywordRecordCSpan keywordRecordSpan)
@@ -296,7 +405,10 @@ std::expected<int64_t, Error> ParseKeywordValue_AsInteger(KeywordRecordCSpan key
  */
 std::expected<double, Error> ParseValue_AsReal(std::span<const char> valueSpan)
 {
-    std::string valStr;
+    // The value's characters. Note that they're converted exactly as std::stod converted them; in particular
+    // conversion stops at a 'D' exponent letter, which std::from_chars doesn't know.
+    std::array<char, KEYWORD_RECORD_BYTE_SIZE.value> valChars{};
+    std::size_t valLength = 0;
 
     bool reachedNonSpaceChar = false;
     bool atLeastOneDigit = false;
@@ -358,7 +470,12 @@ std::expected<double, Error> ParseValue_AsReal(std::span<const char> valueSpan)
 
         if (isValidChar)
         {
-            valStr.push_back(c);
+            if (valLength == valChars.size())
+            {
+                return std::unexpected(Error::Msg("ParseValue_AsReal: Value is too long"));
+            }
+
+            valChars[valLength++] = c;
         }
         else if (isSpaceChar)
         {
@@ -392,18 +509,31 @@ std::expected<double, Error> ParseValue_AsReal(std::span<const char> valueSpan)
         return std::unexpected(Error::Msg("ParseValue_AsReal: Require at least one valid digit following an exponent"));
     }
 
-    try
-    {
-        return std::stod(valStr);
-    }
-    catch (const std::invalid_argument&)
+    const auto valStr = std::string_view(valChars.data(), valLength);
+
+    // Note that std::from_chars doesn't accept a leading '+' sign
+    const auto numberStr = WithoutLeadingPlusSign(valStr);
+    if (!numberStr)
     {
         return std::unexpected(Error::Msg("ParseValue_AsReal: No conversion to double could be performed: {}", valStr));
     }
-    catch (const std::out_of_range&)
+
+    // Note that, as the value's characters have been validated above, a conversion which doesn't consume all
+    // of them has only stopped at a 'D' exponent, or a redundant decimal point or exponent, such as in 1.2.3,
+    // and is accepted, as it was by std::stod
+    double value{0.0};
+    const auto [ptr, ec] = std::from_chars(numberStr->data(), numberStr->data() + numberStr->size(), value);
+
+    if (ec == std::errc::result_out_of_range)
     {
         return std::unexpected(Error::Msg("ParseValue_AsReal: Value out of range: {}", valStr));
     }
+    if (ec != std::errc{})
+    {
+        return std::unexpected(Error::Msg("ParseValue_AsReal: No conversion to double could be performed: {}", valStr));
+    }
+
+    return value;
 }
 
 std::expected<double, Error> ParseKeywordValue_AsReal(KeywordRecordCSpan keywordRecordSpan)
@@ -43,6 +43,33 @@ namespace NFITS
      */
     [[nodiscard]] NFITS_PUBLIC bool ParseValueIndicator(KeywordValueIndicatorCSpan valueIndicatorSpan);
 
+    /**
+     * Bitmasks which classify the keyword records of a header block; bit n describes the block's nth record
+     */
+    struct HeaderBlockScan
+    {
+        uint64_t endRecords{0};             // Records whose keyword name is END
+        uint64_t blankRecords{0};           // Records which are entirely spaces
+        uint64_t valueIndicatorRecords{0};  // Records with a value indicator ('= ') in bytes 9 and 10
+    };
+
+    /**
+     * Classifies all of a header block's keyword records by their byte patterns, without parsing any of them, so
+     * that the per-record parsers only need to be run on the records of interest. Uses SSE2 where available,
+     * comparing each record's first 16 bytes, and then its remaining bytes, with a few vector compares.
+     *
+     * @param blockSpan The header block's bytes
+     *
+     * @return The block's classified keyword records
+     */
+    [[nodiscard]] NFITS_PUBLIC HeaderBlockScan ScanHeaderBlock(BlockCSpan blockSpan);
+
+    /**
+     * The scalar implementation of ScanHeaderBlock, which it falls back to where SSE2 isn't available. Gives
+     * identical results.
+     */
+    [[nodiscard]] NFITS_PUBLIC HeaderBlockScan ScanHeaderBlock_Scalar(BlockCSpan blockSpan);
+
     /**
      * Parses a keyword value as an integer value
      */
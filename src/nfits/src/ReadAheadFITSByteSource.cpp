@@ -0,0 +1,396 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/ReadAheadFITSByteSource.h>
+#include <NFITS/Def.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace NFITS
+{
+
+std::unique_ptr<ReadAheadFITSByteSource> ReadAheadFITSByteSource::Create(std::unique_ptr<IFITSByteSource> pSource,
+                                                                         const ReadAheadParams& params)
+{
+    auto adjustedParams = params;
+
+    // Always prefetch at least a full block at a time
+    adjustedParams.windowByteSize = ByteSize(std::max(params.windowByteSize.value, BLOCK_BYTE_SIZE.value));
+
+    return std::make_unique<ReadAheadFITSByteSource>(Tag{}, std::move(pSource), adjustedParams);
+}
+
+ReadAheadFITSByteSource::ReadAheadFITSByteSource(ReadAheadFITSByteSource::Tag,
+                                                 std::unique_ptr<IFITSByteSource> pSource,
+                                                 const ReadAheadParams& params)
+    : m_pSource(std::move(pSource))
+    , m_params(params)
+    , m_nextSequentialOffset(std::numeric_limits<uintmax_t>::max())
+{
+    m_prefetchThread = std::thread(&ReadAheadFITSByteSource::PrefetchThreadFunc, this);
+}
+
+ReadAheadFITSByteSource::~ReadAheadFITSByteSource()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopPrefetchThread = true;
+    }
+
+    m_cv.notify_all();
+
+    m_prefetchThread.join();
+}
+
+ReadAheadStats ReadAheadFITSByteSource::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+std::expected<ByteSize, Error> ReadAheadFITSByteSource::GetByteSize() const
+{
+    if (m_pSource->SupportsConcurrentReads())
+    {
+        return m_pSource->GetByteSize();
+    }
+
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    return m_pSource->GetByteSize();
+}
+
+Result ReadAheadFITSByteSource::Resize(const ByteSize& byteSize)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    DiscardPrefetchedBytes(lock);
+
+    return m_pSource->Resize(byteSize);
+}
+
+Result ReadAheadFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("ReadAheadFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    if (byteSize.value == 0)
+    {
+        return Result::Success();
+    }
+
+    //
+    // Bulk reads, of at least a read chunk, are read directly from the source without engaging prefetching. They
+    // gain little from it, and are typically issued concurrently by parallel loaders, which would otherwise all
+    // wait on the one prefetch thread, and then copy out of its windows one at a time.
+    //
+    if (byteSize.value >= READ_CHUNK_BYTE_SIZE.value)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.directByteSize += byteSize.value;
+        }
+
+        return ReadFromSource(dst, byteOffset, byteSize);
+    }
+
+    const auto readStartOffset = byteOffset.value;
+    const auto readEndOffset = byteOffset.value + byteSize.value;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    //
+    // Track whether reads are arriving back-to-back
+    //
+    if (readStartOffset == m_nextSequentialOffset)
+    {
+        m_sequentialReadCount = std::min(m_sequentialReadCount + 1, std::numeric_limits<unsigned int>::max() - 1);
+    }
+    else
+    {
+        m_sequentialReadCount = 0;
+    }
+
+    m_nextSequentialOffset = readEndOffset;
+
+    const bool sequential = IsSequential(readStartOffset);
+
+    //
+    // Serve as much of the read as possible, from its start, out of prefetched bytes
+    //
+    uintmax_t offset = readStartOffset;
+
+    while (offset < readEndOffset)
+    {
+        // If the front window holds the next bytes, copy them out of it
+        auto& front = FrontWindow();
+        if (front.Contains(offset))
+        {
+            const auto copyByteSize = std::min(front.EndOffset(), readEndOffset) - offset;
+
+            std::copy_n(front.bytes.cbegin() + static_cast<std::ptrdiff_t>(offset - front.byteOffset),
+                        copyByteSize,
+                        dst.begin() + static_cast<std::ptrdiff_t>(offset - readStartOffset));
+
+            m_stats.servedByteSize += copyByteSize;
+            offset += copyByteSize;
+            continue;
+        }
+
+        // Otherwise, if the back window holds, or is being prefetched with, the next bytes, wait for it to
+        // be ready and swap it to be the front window
+        if (m_prefetchState == PrefetchState::Idle)
+        {
+            break;
+        }
+
+        const auto& back = BackWindow();
+        if ((offset < back.byteOffset) || (offset >= back.EndOffset()))
+        {
+            break;
+        }
+
+        if (m_prefetchState != PrefetchState::Complete)
+        {
+            m_stats.prefetchWaits++;
+            WaitForPrefetch(lock);
+
+            // Another reader may have consumed the prefetch while this one waited
+            continue;
+        }
+
+        m_prefetchState = PrefetchState::Idle;
+
+        if (!BackWindow().valid)
+        {
+            break;
+        }
+
+        front.valid = false;
+        m_frontWindowIndex = 1U - m_frontWindowIndex;
+
+        // Now that the back window is free, start prefetching what follows the new front window, or what
+        // follows this read if this read extends past the new front window
+        if (sequential)
+        {
+            EnsurePrefetch(std::max(FrontWindow().EndOffset(), readEndOffset));
+        }
+    }
+
+    if (offset == readEndOffset)
+    {
+        if (sequential)
+        {
+            EnsurePrefetch(FrontWindow().Contains(readEndOffset) ? FrontWindow().EndOffset() : readEndOffset);
+        }
+
+        return Result::Success();
+    }
+
+    //
+    // Read the remainder of the read directly from the source, prefetching what follows it in the meantime
+    //
+    if (sequential)
+    {
+        EnsurePrefetch(readEndOffset);
+    }
+
+    m_stats.directByteSize += readEndOffset - offset;
+
+    lock.unlock();
+
+    return ReadFromSource(
+        dst.subspan(static_cast<std::size_t>(offset - readStartOffset)),
+        ByteOffset(offset),
+        ByteSize(readEndOffset - offset)
+    );
+}
+
+Result ReadAheadFITSByteSource::WriteBytes(std::span<const std::byte> src, const ByteOffset& byteOffset, const ByteSize& byteSize, bool flush)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    DiscardPrefetchedBytes(lock);
+
+    return m_pSource->WriteBytes(src, byteOffset, byteSize, flush);
+}
+
+Result ReadAheadFITSByteSource::Flush()
+{
+    return m_pSource->Flush();
+}
+
+std::optional<std::span<const std::byte>> ReadAheadFITSByteSource::GetBytesView(const ByteOffset& byteOffset,
+                                                                                 const ByteSize& byteSize) const
+{
+    // A source which can provide zero-copy access to its bytes has no need for them to be prefetched
+    return m_pSource->GetBytesView(byteOffset, byteSize);
+}
+
+void ReadAheadFITSByteSource::AdviseAccess(const ByteOffset& byteOffset, const ByteSize& byteSize, ByteAccessHint hint)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        switch (hint)
+        {
+            case ByteAccessHint::Sequential:
+            {
+                m_sequentialAdvised = true;
+                m_sequentialAdvisedEndOffset = byteOffset.value + byteSize.value;
+
+                // Start prefetching the range right away, rather than waiting for it to be read from
+                if (!FrontWindow().Contains(byteOffset.value))
+                {
+                    EnsurePrefetch(byteOffset.value);
+                }
+            }
+            break;
+            case ByteAccessHint::Normal:
+            case ByteAccessHint::Random:
+            {
+                m_sequentialAdvised = false;
+                m_sequentialReadCount = 0;
+            }
+            break;
+            case ByteAccessHint::WillNeed:
+            break;
+        }
+    }
+
+    if (m_pSource->SupportsConcurrentReads())
+    {
+        m_pSource->AdviseAccess(byteOffset, byteSize, hint);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    m_pSource->AdviseAccess(byteOffset, byteSize, hint);
+}
+
+void ReadAheadFITSByteSource::PrefetchThreadFunc()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_cv.wait(lock, [this](){ return m_stopPrefetchThread || (m_prefetchState == PrefetchState::Requested); });
+
+        if (m_stopPrefetchThread)
+        {
+            return;
+        }
+
+        // While a prefetch is requested or in flight the back window belongs to this thread; nothing else
+        // touches it, or swaps which window is the back window
+        auto& back = BackWindow();
+        m_prefetchState = PrefetchState::InFlight;
+
+        lock.unlock();
+        const auto result = ReadFromSource(back.bytes, ByteOffset(back.byteOffset), ByteSize(back.byteSize));
+        lock.lock();
+
+        back.valid = result();
+        if (back.valid)
+        {
+            m_stats.prefetchedByteSize += back.byteSize;
+        }
+
+        m_prefetchState = PrefetchState::Complete;
+        m_cv.notify_all();
+    }
+}
+
+bool ReadAheadFITSByteSource::IsSequential(uintmax_t byteOffset) const
+{
+    if (m_sequentialAdvised && (byteOffset < m_sequentialAdvisedEndOffset))
+    {
+        return true;
+    }
+
+    return m_sequentialReadCount >= m_params.sequentialReadThreshold;
+}
+
+void ReadAheadFITSByteSource::EnsurePrefetch(uintmax_t byteOffset)
+{
+    // Only one prefetch is in flight at a time
+    if ((m_prefetchState == PrefetchState::Requested) || (m_prefetchState == PrefetchState::InFlight))
+    {
+        return;
+    }
+
+    auto& back = BackWindow();
+
+    // Nothing to do if the bytes were already prefetched
+    if ((m_prefetchState == PrefetchState::Complete) && back.valid && (back.byteOffset == byteOffset))
+    {
+        return;
+    }
+
+    const auto sourceByteSize = GetByteSize();
+    if (!sourceByteSize)
+    {
+        return;
+    }
+
+    // Don't prefetch past the end of the source, or past the end of a range advised as being sequentially accessed
+    auto endOffset = sourceByteSize->value;
+    if (m_sequentialAdvised && (byteOffset < m_sequentialAdvisedEndOffset))
+    {
+        endOffset = std::min(endOffset, m_sequentialAdvisedEndOffset);
+    }
+
+    if (byteOffset >= endOffset)
+    {
+        return;
+    }
+
+    back.byteOffset = byteOffset;
+    back.byteSize = std::min(m_params.windowByteSize.value, endOffset - byteOffset);
+    back.valid = false;
+
+    if (back.bytes.size() < back.byteSize)
+    {
+        back.bytes.resize(static_cast<std::size_t>(m_params.windowByteSize.value));
+    }
+
+    m_prefetchState = PrefetchState::Requested;
+    m_cv.notify_all();
+}
+
+void ReadAheadFITSByteSource::WaitForPrefetch(std::unique_lock<std::mutex>& lock)
+{
+    m_cv.wait(lock, [this](){
+        return (m_prefetchState == PrefetchState::Idle) || (m_prefetchState == PrefetchState::Complete);
+    });
+}
+
+void ReadAheadFITSByteSource::DiscardPrefetchedBytes(std::unique_lock<std::mutex>& lock)
+{
+    WaitForPrefetch(lock);
+
+    for (auto& window : m_windows)
+    {
+        window.valid = false;
+    }
+
+    m_prefetchState = PrefetchState::Idle;
+    m_nextSequentialOffset = std::numeric_limits<uintmax_t>::max();
+    m_sequentialReadCount = 0;
+}
+
+Result ReadAheadFITSByteSource::ReadFromSource(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) const
+{
+    if (m_pSource->SupportsConcurrentReads())
+    {
+        return m_pSource->ReadBytes(dst, byteOffset, byteSize);
+    }
+
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    return m_pSource->ReadBytes(dst, byteOffset, byteSize);
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <NFITS/SpanFITSByteSource.h>
+
+#include <cstring>
+
+namespace NFITS
+{
+
+std::unique_ptr<SpanFITSByteSource> SpanFITSByteSource::Create(std::span<const std::byte> bytes)
+{
+    return std::make_unique<SpanFITSByteSource>(Tag{}, bytes, nullptr);
+}
+
+std::unique_ptr<SpanFITSByteSource> SpanFITSByteSource::Create(std::span<const std::byte> bytes, std::shared_ptr<const void> pOwner)
+{
+    return std::make_unique<SpanFITSByteSource>(Tag{}, bytes, std::move(pOwner));
+}
+
+SpanFITSByteSource::SpanFITSByteSource(SpanFITSByteSource::Tag, std::span<const std::byte> bytes, std::shared_ptr<const void> pOwner)
+    : m_bytes(bytes)
+    , m_pOwner(std::move(pOwner))
+{
+
+}
+
+SpanFITSByteSource::~SpanFITSByteSource() = default;
+
+std::expected<ByteSize, Error> SpanFITSByteSource::GetByteSize() const
+{
+    return ByteSize{m_bytes.size()};
+}
+
+Result SpanFITSByteSource::Resize(const ByteSize&)
+{
+    return Result::Fail("SpanFITSByteSource::Resize: Source is read-only");
+}
+
+Result SpanFITSByteSource::ReadBytes(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return Result::Fail("SpanFITSByteSource::ReadBytes: dst size is too small for requested read");
+    }
+
+    const auto view = GetBytesView(byteOffset, byteSize);
+    if (!view)
+    {
+        return Result::Fail("SpanFITSByteSource::ReadBytes: Byte offset/size is out of bounds");
+    }
+
+    if (!view->empty())
+    {
+        memcpy(dst.data(), view->data(), view->size());
+    }
+
+    return Result::Success();
+}
+
+Result SpanFITSByteSource::WriteBytes(std::span<const std::byte>, const ByteOffset&, const ByteSize&, bool)
+{
+    return Result::Fail("SpanFITSByteSource::WriteBytes: Source is read-only");
+}
+
+Result SpanFITSByteSource::Flush()
+{
+    // no-op, nothing is ever written to the source
+
+    return Result::Success();
+}
+
+std::optional<std::span<const std::byte>> SpanFITSByteSource::GetBytesView(const ByteOffset& byteOffset,
+                                                                            const ByteSize& byteSize) const
+{
+    if ((byteOffset.value > m_bytes.size()) || (byteSize.value > (m_bytes.size() - byteOffset.value)))
+    {
+        return std::nullopt;
+    }
+
+    return m_bytes.subspan(static_cast<std::size_t>(byteOffset.value), static_cast<std::size_t>(byteSize.value));
+}
+
+}
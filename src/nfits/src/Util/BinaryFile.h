@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_UTIL_BINARYFILE_H
+#define NFITS_SRC_UTIL_BINARYFILE_H
+
+#include <fstream>
+#include <type_traits>
+
+namespace NFITS
+{
+    // Helpers for reading/writing the trivially copyable values of the library's index files, in native byte order
+
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    static inline void WriteValue(std::ofstream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] static inline bool ReadValue(std::ifstream& stream, T& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return stream.good();
+    }
+}
+
+#endif //NFITS_SRC_UTIL_BINARYFILE_H
@@ -0,0 +1,379 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "IOUring.h"
+
+#if defined(__linux__)
+    #include <linux/io_uring.h>
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <optional>
+
+namespace NFITS
+{
+
+namespace
+{
+    std::future<Result> ReadyFuture(Result result)
+    {
+        std::promise<Result> promise;
+        promise.set_value(std::move(result));
+        return promise.get_future();
+    }
+}
+
+struct IOUring::Request
+{
+    int fd;
+    std::span<std::byte> dst;
+    uintmax_t byteOffset;
+    uintmax_t byteSize;
+    uintmax_t numBytesRead{0};
+    std::promise<Result> promise;
+};
+
+#if defined(__linux__)
+
+// Completion user data for entries whose completions are ignored
+static constexpr uint64_t IGNORED_USER_DATA = 1U;
+
+// Max number of bytes transferred by one read entry
+static constexpr uintmax_t MAX_TRANSFER_BYTE_SIZE = 1U << 30U;
+
+std::unique_ptr<IOUring> IOUring::Create(unsigned int queueDepth)
+{
+    auto ioUring = std::make_unique<IOUring>(Tag{});
+
+    if (!ioUring->Init(queueDepth))
+    {
+        return nullptr;
+    }
+
+    return ioUring;
+}
+
+IOUring::IOUring(IOUring::Tag)
+{
+
+}
+
+IOUring::~IOUring()
+{
+    if (m_completionThread.joinable())
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_submitMutex);
+
+            // Let any reads in flight finish, as their buffers are owned by their callers
+            m_slotCv.wait(lock, [this](){ return m_inFlightCount == 0; });
+        }
+
+        // Tell the completion thread to exit. Signalled through the eventfd rather than a ring entry, which the
+        // kernel could refuse, leaving the thread waiting forever.
+        const uint64_t stopValue = 1U;
+        while ((write(m_stopEventFd, &stopValue, sizeof(stopValue)) < 0) && (errno == EINTR)) { }
+
+        m_completionThread.join();
+    }
+
+    Destroy();
+}
+
+bool IOUring::Init(unsigned int queueDepth)
+{
+    io_uring_params params{};
+
+    const auto ringFd = syscall(__NR_io_uring_setup, queueDepth, &params);
+    if (ringFd < 0)
+    {
+        return false;
+    }
+
+    m_ringFd = static_cast<int>(ringFd);
+
+    m_sqRingByteSize = params.sq_off.array + (params.sq_entries * sizeof(unsigned int));
+    m_cqRingByteSize = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+    m_sqesByteSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    // Newer kernels map both rings with one mapping
+    const bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMapping)
+    {
+        m_sqRingByteSize = std::max(m_sqRingByteSize, m_cqRingByteSize);
+        m_cqRingByteSize = m_sqRingByteSize;
+    }
+
+    const auto mapRegion = [&](std::size_t byteSize, off_t offset) -> void* {
+        void* pRegion = mmap(nullptr, byteSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, offset);
+        return pRegion == MAP_FAILED ? nullptr : pRegion;
+    };
+
+    m_pSQRing = mapRegion(m_sqRingByteSize, static_cast<off_t>(IORING_OFF_SQ_RING));
+    if (m_pSQRing == nullptr) { Destroy(); return false; }
+
+    m_pCQRing = singleMapping ? m_pSQRing : mapRegion(m_cqRingByteSize, static_cast<off_t>(IORING_OFF_CQ_RING));
+    if (m_pCQRing == nullptr) { Destroy(); return false; }
+
+    m_pSQEs = mapRegion(m_sqesByteSize, static_cast<off_t>(IORING_OFF_SQES));
+    if (m_pSQEs == nullptr) { Destroy(); return false; }
+
+    auto* pSQRing = static_cast<std::byte*>(m_pSQRing);
+    m_pSQHead = reinterpret_cast<unsigned int*>(pSQRing + params.sq_off.head);
+    m_pSQTail = reinterpret_cast<unsigned int*>(pSQRing + params.sq_off.tail);
+    m_pSQMask = reinterpret_cast<unsigned int*>(pSQRing + params.sq_off.ring_mask);
+    m_pSQArray = reinterpret_cast<unsigned int*>(pSQRing + params.sq_off.array);
+
+    auto* pCQRing = static_cast<std::byte*>(m_pCQRing);
+    m_pCQHead = reinterpret_cast<unsigned int*>(pCQRing + params.cq_off.head);
+    m_pCQTail = reinterpret_cast<unsigned int*>(pCQRing + params.cq_off.tail);
+    m_pCQMask = reinterpret_cast<unsigned int*>(pCQRing + params.cq_off.ring_mask);
+    m_pCQEs = pCQRing + params.cq_off.cqes;
+
+    m_sqEntryCount = params.sq_entries;
+
+    m_stopEventFd = eventfd(0U, EFD_CLOEXEC);
+    if (m_stopEventFd < 0) { Destroy(); return false; }
+
+    m_completionThread = std::thread(&IOUring::CompletionThreadFunc, this);
+
+    return true;
+}
+
+void IOUring::Destroy()
+{
+    if (m_pSQEs != nullptr) { munmap(m_pSQEs, m_sqesByteSize); m_pSQEs = nullptr; }
+    if ((m_pCQRing != nullptr) && (m_pCQRing != m_pSQRing)) { munmap(m_pCQRing, m_cqRingByteSize); }
+    m_pCQRing = nullptr;
+    if (m_pSQRing != nullptr) { munmap(m_pSQRing, m_sqRingByteSize); m_pSQRing = nullptr; }
+    if (m_ringFd >= 0) { close(m_ringFd); m_ringFd = -1; }
+    if (m_stopEventFd >= 0) { close(m_stopEventFd); m_stopEventFd = -1; }
+}
+
+std::future<Result> IOUring::SubmitRead(int fd, std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize)
+{
+    if (dst.size() < byteSize.value)
+    {
+        return ReadyFuture(Result::Fail("IOUring::SubmitRead: dst size is too small for requested read"));
+    }
+
+    if (byteSize.value == 0)
+    {
+        return ReadyFuture(Result::Success());
+    }
+
+    auto pRequest = std::make_unique<Request>(Request{
+        .fd = fd,
+        .dst = dst,
+        .byteOffset = byteOffset.value,
+        .byteSize = byteSize.value,
+        .numBytesRead = 0,
+        .promise = {}
+    });
+    auto future = pRequest->promise.get_future();
+
+    std::unique_lock<std::mutex> lock(m_submitMutex);
+
+    // Limiting reads in flight to the submission queue's size guarantees the completion queue, which is
+    // larger, never overflows
+    m_slotCv.wait(lock, [this](){ return m_inFlightCount < m_sqEntryCount; });
+
+    if (!PushRead(pRequest.get()))
+    {
+        return ReadyFuture(Result::Fail("IOUring::SubmitRead: Failed to submit read, errno: {}", errno));
+    }
+
+    m_inFlightCount++;
+
+    // Owned by the completion thread from here on
+    (void)pRequest.release();
+
+    return future;
+}
+
+bool IOUring::PushRead(Request* pRequest)
+{
+    const auto remainingByteSize = std::min(pRequest->byteSize - pRequest->numBytesRead, MAX_TRANSFER_BYTE_SIZE);
+
+    return PushEntry(
+        IORING_OP_READ,
+        pRequest->fd,
+        pRequest->dst.data() + pRequest->numBytesRead,
+        static_cast<uint32_t>(remainingByteSize),
+        pRequest->byteOffset + pRequest->numBytesRead,
+        reinterpret_cast<uint64_t>(pRequest)
+    );
+}
+
+bool IOUring::PushEntry(uint8_t opcode, int fd, void* pAddr, uint32_t len, uint64_t offset, uint64_t userData)
+{
+    // This thread is the only writer of the tail, the kernel is the only writer of the head
+    const unsigned int tail = *m_pSQTail;
+    const unsigned int index = tail & *m_pSQMask;
+
+    auto* pEntry = static_cast<io_uring_sqe*>(m_pSQEs) + index;
+    std::memset(pEntry, 0, sizeof(io_uring_sqe));
+    pEntry->opcode = opcode;
+    pEntry->fd = fd;
+    pEntry->addr = reinterpret_cast<uint64_t>(pAddr);
+    pEntry->len = len;
+    pEntry->off = offset;
+    pEntry->user_data = userData;
+
+    m_pSQArray[index] = index;
+
+    std::atomic_ref<unsigned int>(*m_pSQTail).store(tail + 1, std::memory_order_release);
+
+    while (true)
+    {
+        const auto toSubmit = (tail + 1) - std::atomic_ref<unsigned int>(*m_pSQHead).load(std::memory_order_acquire);
+
+        if (syscall(__NR_io_uring_enter, m_ringFd, toSubmit, 0U, 0U, nullptr, 0) >= 0)
+        {
+            return true;
+        }
+
+        if ((errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // The kernel didn't take the entry. Turn it into a no-op whose completion is ignored, so that it's
+        // harmless when a later submission does take it.
+        pEntry->opcode = IORING_OP_NOP;
+        pEntry->user_data = IGNORED_USER_DATA;
+
+        return false;
+    }
+}
+
+void IOUring::CompletionThreadFunc()
+{
+    std::array<pollfd, 2> pollFds{
+        pollfd{.fd = m_ringFd, .events = POLLIN, .revents = 0},
+        pollfd{.fd = m_stopEventFd, .events = POLLIN, .revents = 0}
+    };
+
+    while (true)
+    {
+        // This thread is the only writer of the head, the kernel is the only writer of the tail
+        unsigned int head = *m_pCQHead;
+        const unsigned int tail = std::atomic_ref<unsigned int>(*m_pCQTail).load(std::memory_order_acquire);
+
+        if (head == tail)
+        {
+            // Block until at least one completion is available, or until told to stop. Stopping waits for
+            // every read in flight to finish first, so no completions are left unhandled.
+            if (poll(pollFds.data(), pollFds.size(), -1) < 0)
+            {
+                continue;
+            }
+
+            if ((pollFds[1].revents & POLLIN) != 0)
+            {
+                return;
+            }
+
+            continue;
+        }
+
+        for (; head != tail; ++head)
+        {
+            const auto completion = static_cast<const io_uring_cqe*>(m_pCQEs)[head & *m_pCQMask];
+
+            if (completion.user_data == IGNORED_USER_DATA) { continue; }
+
+            OnReadCompleted(reinterpret_cast<Request*>(completion.user_data), completion.res);
+        }
+
+        std::atomic_ref<unsigned int>(*m_pCQHead).store(head, std::memory_order_release);
+    }
+}
+
+void IOUring::OnReadCompleted(Request* pRequest, int32_t res)
+{
+    std::optional<Result> result;
+
+    if ((res == -EINTR) || (res == -EAGAIN))
+    {
+        // Retried below
+    }
+    else if (res < 0)
+    {
+        result = Result::Fail("IOUring: Read failed, errno: {}", -res);
+    }
+    else if (res == 0)
+    {
+        result = Result::Fail("IOUring: Byte offset/size is out of bounds");
+    }
+    else
+    {
+        pRequest->numBytesRead += static_cast<uintmax_t>(res);
+
+        if (pRequest->numBytesRead == pRequest->byteSize)
+        {
+            result = Result::Success();
+        }
+    }
+
+    //
+    // If the read isn't finished, resubmit it for its remaining bytes. It keeps its in-flight slot.
+    //
+    if (!result)
+    {
+        std::lock_guard<std::mutex> lock(m_submitMutex);
+
+        if (PushRead(pRequest))
+        {
+            return;
+        }
+
+        result = Result::Fail("IOUring: Failed to resubmit read, errno: {}", errno);
+    }
+
+    const auto request = std::unique_ptr<Request>(pRequest);
+    request->promise.set_value(*result);
+
+    {
+        std::lock_guard<std::mutex> lock(m_submitMutex);
+        m_inFlightCount--;
+    }
+
+    m_slotCv.notify_all();
+}
+
+#else
+
+std::unique_ptr<IOUring> IOUring::Create(unsigned int)
+{
+    return nullptr;
+}
+
+IOUring::IOUring(IOUring::Tag)
+{
+
+}
+
+IOUring::~IOUring() = default;
+
+std::future<Result> IOUring::SubmitRead(int, std::span<std::byte>, const ByteOffset&, const ByteSize&)
+{
+    return ReadyFuture(Result::Fail("IOUring::SubmitRead: io_uring is not supported on this platform"));
+}
+
+#endif
+
+}
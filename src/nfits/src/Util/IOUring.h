@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_UTIL_IOURING_H
+#define NFITS_SRC_UTIL_IOURING_H
+
+#include <NFITS/Bytes.h>
+#include <NFITS/Result.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace NFITS
+{
+    /**
+     * Minimal io_uring instance, driven via raw syscalls, which performs positional file reads asynchronously.
+     *
+     * Reads are submitted to the kernel's submission queue as they're requested, and a dedicated thread reaps
+     * their completions, so any number of reads, up to the queue depth, are in flight at once. Reads which
+     * complete short are resubmitted for their remaining bytes.
+     *
+     * The completion thread waits on the ring's fd together with an eventfd, which is signalled to stop it, so
+     * stopping doesn't depend on the kernel accepting any further submissions.
+     *
+     * Only available on Linux kernels with io_uring support; Create returns nullptr otherwise.
+     */
+    class IOUring
+    {
+        public:
+
+            /**
+             * @param queueDepth Max number of reads in flight at once. Further reads wait for a free slot.
+             *
+             * @return An IOUring, or nullptr if io_uring isn't available (non-Linux, kernel lacking support,
+             * or io_uring being disallowed by the process's sandbox)
+             */
+            [[nodiscard]] static std::unique_ptr<IOUring> Create(unsigned int queueDepth);
+
+        private:
+
+            struct Tag{};
+
+        public:
+
+            explicit IOUring(Tag tag);
+            ~IOUring();
+
+            IOUring(const IOUring&) = delete;
+            IOUring& operator=(const IOUring&) = delete;
+
+            /**
+             * Submit a read of bytes from a file. The file descriptor and dst must remain valid until the
+             * returned future is ready.
+             *
+             * @return A future which receives whether all bytes were read successfully
+             */
+            [[nodiscard]] std::future<Result> SubmitRead(int fd, std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize);
+
+        private:
+
+            struct Request;
+
+        private:
+
+            [[nodiscard]] bool Init(unsigned int queueDepth);
+            void Destroy();
+
+            // Require m_submitMutex to be held
+            [[nodiscard]] bool PushRead(Request* pRequest);
+            [[nodiscard]] bool PushEntry(uint8_t opcode, int fd, void* pAddr, uint32_t len, uint64_t offset, uint64_t userData);
+
+            void CompletionThreadFunc();
+            void OnReadCompleted(Request* pRequest, int32_t res);
+
+        private:
+
+            int m_ringFd{-1};
+            int m_stopEventFd{-1};
+
+            void* m_pSQRing{nullptr};
+            std::size_t m_sqRingByteSize{0};
+            void* m_pCQRing{nullptr};
+            std::size_t m_cqRingByteSize{0};
+            void* m_pSQEs{nullptr};
+            std::size_t m_sqesByteSize{0};
+
+            unsigned int* m_pSQHead{nullptr};
+            unsigned int* m_pSQTail{nullptr};
+            unsigned int* m_pSQMask{nullptr};
+            unsigned int* m_pSQArray{nullptr};
+            unsigned int* m_pCQHead{nullptr};
+            unsigned int* m_pCQTail{nullptr};
+            unsigned int* m_pCQMask{nullptr};
+            void* m_pCQEs{nullptr};
+            unsigned int m_sqEntryCount{0};
+
+            // Guards submission queue access and the in-flight count
+            std::mutex m_submitMutex;
+            std::condition_variable m_slotCv;
+            unsigned int m_inFlightCount{0};
+
+            std::thread m_completionThread;
+    };
+}
+
+#endif //NFITS_SRC_UTIL_IOURING_H
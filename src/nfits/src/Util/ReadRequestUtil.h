@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_UTIL_READREQUESTUTIL_H
+#define NFITS_SRC_UTIL_READREQUESTUTIL_H
+
+#include <NFITS/IFITSByteSource.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace NFITS
+{
+    /**
+     * @return The indices of the non-empty requests, ordered by increasing byte offset
+     */
+    [[nodiscard]] static inline std::vector<std::size_t> GetOrderedRequestIndices(std::span<const ReadRequest> requests)
+    {
+        std::vector<std::size_t> indices;
+        indices.reserve(requests.size());
+
+        for (std::size_t x = 0; x < requests.size(); ++x)
+        {
+            if (requests[x].byteSize.value > 0)
+            {
+                indices.push_back(x);
+            }
+        }
+
+        std::ranges::sort(indices, [&](std::size_t a, std::size_t b){
+            return requests[a].byteOffset < requests[b].byteOffset;
+        });
+
+        return indices;
+    }
+
+    /**
+     * @return Whether every request's dst is large enough to hold its bytes
+     */
+    [[nodiscard]] static inline bool AreRequestDstsValid(std::span<const ReadRequest> requests)
+    {
+        return std::ranges::all_of(requests, [](const ReadRequest& request){
+            return request.dst.size() >= request.byteSize.value;
+        });
+    }
+}
+
+#endif //NFITS_SRC_UTIL_READREQUESTUTIL_H
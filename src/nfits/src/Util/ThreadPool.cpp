@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
+namespace NFITS
+{
+
+// Min number of threads in the IO pool; IO tasks spend most of their time blocked, so the pool is sized
+// for queue depth rather than for the number of cores
+static constexpr std::size_t MIN_IO_THREAD_COUNT = 8U;
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    threadCount = std::max(threadCount, std::size_t{1});
+
+    m_threads.reserve(threadCount);
+
+    for (std::size_t x = 0; x < threadCount; ++x)
+    {
+        m_threads.emplace_back(&ThreadPool::ThreadFunc, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_cv.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::Enqueue(std::move_only_function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+
+    m_cv.notify_one();
+}
+
+void ThreadPool::ThreadFunc()
+{
+    while (true)
+    {
+        std::move_only_function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this](){ return m_stop || !m_tasks.empty(); });
+
+            // Finish any remaining tasks before stopping, so that no future is left without a result
+            if (m_tasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task();
+    }
+}
+
+ThreadPool& GetIOThreadPool()
+{
+    static ThreadPool threadPool(std::max(MIN_IO_THREAD_COUNT, static_cast<std::size_t>(std::thread::hardware_concurrency())));
+    return threadPool;
+}
+
+ThreadPool& GetComputeThreadPool()
+{
+    static ThreadPool threadPool(static_cast<std::size_t>(std::thread::hardware_concurrency()));
+    return threadPool;
+}
+
+Result ParallelForEachIndex(ThreadPool& pool,
+                            std::size_t count,
+                            const std::function<Result(std::size_t index, std::size_t workerIndex)>& func,
+                            const std::function<bool()>& isCancelled)
+{
+    std::atomic<std::size_t> nextIndex{0};
+    std::atomic<bool> stop{false};
+
+    std::mutex failureMutex;
+    std::optional<Result> failure;
+
+    const auto workerFunc = [&](std::size_t workerIndex){
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            const auto index = nextIndex.fetch_add(1U, std::memory_order_relaxed);
+            if (index >= count)
+            {
+                return;
+            }
+
+            auto result = (isCancelled && isCancelled()) ? Result::Fail("ParallelForEachIndex: Cancelled")
+                                                         : func(index, workerIndex);
+            if (!result)
+            {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) { failure = std::move(result); }
+                stop = true;
+            }
+        }
+    };
+
+    //
+    // The calling thread works through indices alongside the pool's threads, so a single index, or a pool
+    // that's busy with other work, doesn't cost a thread hop
+    //
+    const auto numWorkers = std::min(count, pool.GetThreadCount() + 1U);
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(numWorkers);
+
+    for (std::size_t workerIndex = 1; workerIndex < numWorkers; ++workerIndex)
+    {
+        workers.push_back(pool.Submit([&, workerIndex](){ workerFunc(workerIndex); }));
+    }
+
+    workerFunc(0);
+
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    return failure ? *failure : Result::Success();
+}
+
+}
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_SRC_UTIL_THREADPOOL_H
+#define NFITS_SRC_UTIL_THREADPOOL_H
+
+#include <NFITS/Result.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace NFITS
+{
+    /**
+     * Simple fixed-size pool of worker threads which run submitted tasks in FIFO order.
+     */
+    class ThreadPool
+    {
+        public:
+
+            explicit ThreadPool(std::size_t threadCount);
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            [[nodiscard]] std::size_t GetThreadCount() const noexcept { return m_threads.size(); }
+
+            /**
+             * Submit a task to be run on one of the pool's threads
+             *
+             * @return A future which receives the task's return value once it has run
+             */
+            template <typename Func>
+            [[nodiscard]] std::future<std::invoke_result_t<Func>> Submit(Func&& func)
+            {
+                std::packaged_task<std::invoke_result_t<Func>()> task(std::forward<Func>(func));
+                auto future = task.get_future();
+
+                Enqueue(std::move(task));
+
+                return future;
+            }
+
+        private:
+
+            void Enqueue(std::move_only_function<void()> task);
+            void ThreadFunc();
+
+        private:
+
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::queue<std::move_only_function<void()>> m_tasks;
+            bool m_stop{false};
+
+            std::vector<std::thread> m_threads;
+    };
+
+    /**
+     * @return A process-wide pool which runs blocking IO tasks, such as async reads of byte sources
+     * which have no async IO mechanism of their own. Created on first use.
+     */
+    [[nodiscard]] ThreadPool& GetIOThreadPool();
+
+    /**
+     * @return A process-wide pool which runs CPU bound tasks, such as decoding chunks of image data, with
+     * one thread per hardware thread. Created on first use.
+     *
+     * Tasks run on it must not block on other tasks submitted to it.
+     */
+    [[nodiscard]] ThreadPool& GetComputeThreadPool();
+
+    /**
+     * Calls func for every index in [0, count), spread across the pool's threads as well as the calling thread,
+     * and waits for all of the calls to finish. Indices are handed out in order, one at a time, to whichever
+     * thread is free next. No further indices are handed out once a call fails, or once isCancelled, if set,
+     * returns true.
+     *
+     * func is called as func(index, workerIndex), where workerIndex, which is less than
+     * pool.GetThreadCount() + 1, identifies the thread making the call, so that callers can keep scratch
+     * state per thread rather than per index.
+     *
+     * @return Success if every call succeeded; otherwise the first failure, or a failure if cancelled
+     */
+    [[nodiscard]] Result ParallelForEachIndex(ThreadPool& pool,
+                                              std::size_t count,
+                                              const std::function<Result(std::size_t index, std::size_t workerIndex)>& func,
+                                              const std::function<bool()>& isCancelled = {});
+}
+
+#endif //NFITS_SRC_UTIL_THREADPOOL_H
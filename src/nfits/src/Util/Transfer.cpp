@@ -6,12 +6,127 @@
  
 #include <NFITS/Util/Transfer.h>
 #include <NFITS/IFITSByteSource.h>
+#include <NFITS/ConcurrentDiskFITSByteSource.h>
 #include <NFITS/FITSBlockSource.h>
 
+#include <array>
+#include <vector>
+#include <algorithm>
+
 namespace NFITS
 {
 
+namespace
+{
+    bool IsCancelled(const CopyParams& params)
+    {
+        return params.isCancelled && params.isCancelled();
+    }
+
+    void ReportProgress(const CopyParams& params, uintmax_t copiedByteSize, uintmax_t totalByteSize)
+    {
+        if (params.onProgress)
+        {
+            params.onProgress(copiedByteSize, totalByteSize);
+        }
+    }
+
+    Result CopyDiskSource(ConcurrentDiskFITSByteSource* pSrc,
+                          ConcurrentDiskFITSByteSource* pDst,
+                          uintmax_t totalByteSize,
+                          uintmax_t chunkByteSize,
+                          const CopyParams& params)
+    {
+        for (uintmax_t byteOffset = 0; byteOffset < totalByteSize; byteOffset += chunkByteSize)
+        {
+            if (IsCancelled(params))
+            {
+                return Result::Fail("CopyFITSSource: Copy was cancelled");
+            }
+
+            const auto byteSize = std::min(totalByteSize - byteOffset, chunkByteSize);
+
+            auto result = pSrc->CopyBytesTo(*pDst, ByteOffset(byteOffset), ByteSize(byteSize));
+            if (!result) { return result; }
+
+            // The copied bytes may never have passed through the destination's writes, so flushing is a sync
+            if (params.flush)
+            {
+                result = pDst->SyncToDisk();
+                if (!result) { return result; }
+            }
+
+            ReportProgress(params, byteOffset + byteSize, totalByteSize);
+        }
+
+        return Result::Success();
+    }
+
+    Result CopyPipelined(IFITSByteSource* pSrc,
+                         IFITSByteSource* pDst,
+                         uintmax_t totalByteSize,
+                         uintmax_t chunkByteSize,
+                         const CopyParams& params)
+    {
+        if (totalByteSize == 0)
+        {
+            return Result::Success();
+        }
+
+        // Double buffered; the next chunk is read into one buffer while the current chunk is written from the other
+        const auto bufferByteSize = static_cast<std::size_t>(std::min(totalByteSize, chunkByteSize));
+        std::array<std::vector<std::byte>, 2> chunkBuffers{
+            std::vector<std::byte>(bufferByteSize),
+            std::vector<std::byte>(bufferByteSize)
+        };
+
+        const auto chunkByteSizeAt = [&](uintmax_t byteOffset){
+            return ByteSize(std::min(totalByteSize - byteOffset, chunkByteSize));
+        };
+
+        auto pendingRead = pSrc->ReadBytesAsync(chunkBuffers[0], ByteOffset(0), chunkByteSizeAt(0));
+
+        for (uintmax_t byteOffset = 0, chunkIndex = 0; byteOffset < totalByteSize; ++chunkIndex)
+        {
+            auto result = pendingRead.get();
+            if (!result) { return result; }
+
+            if (IsCancelled(params))
+            {
+                return Result::Fail("CopyFITSSource: Copy was cancelled");
+            }
+
+            const auto byteSize = chunkByteSizeAt(byteOffset);
+            const auto nextByteOffset = byteOffset + byteSize.value;
+
+            if (nextByteOffset < totalByteSize)
+            {
+                pendingRead = pSrc->ReadBytesAsync(chunkBuffers[(chunkIndex + 1) % 2], ByteOffset(nextByteOffset), chunkByteSizeAt(nextByteOffset));
+            }
+
+            result = pDst->WriteBytes(chunkBuffers[chunkIndex % 2], ByteOffset(byteOffset), byteSize, params.flush);
+            if (!result)
+            {
+                // The read in flight references the chunk buffers; let it finish before they're destroyed
+                if (pendingRead.valid()) { pendingRead.wait(); }
+                return result;
+            }
+
+            ReportProgress(params, nextByteOffset, totalByteSize);
+
+            byteOffset = nextByteOffset;
+        }
+
+        return Result::Success();
+    }
+}
+
 Result CopyFITSSource(IFITSByteSource* pSrc, IFITSByteSource* pDst, bool flush)
+{
+    return CopyFITSSource(pSrc, pDst, CopyParams{.flush = flush});
+}
+
+Result CopyFITSSource(IFITSByteSource* pSrc, IFITSByteSource* pDst, const CopyParams& params)
 {
     // Wrap the byte sources with block sources to work with them on a per-block basis
     FITSBlockSource blockSrc(pSrc);
@@ -24,24 +139,28 @@ Result CopyFITSSource(IFITSByteSource* pSrc, IFITSByteSource* pDst, bool flush)
     }
 
     // Resize the destination to match the source's block count
-    auto result = blockDst.ResizeBlocks(*sourceBlocks);
+    const auto result = blockDst.ResizeBlocks(*sourceBlocks);
     if (!result)
     {
         return result;
     }
 
-    BlockBytes blockBytes{};
+    const auto totalByteSize = (BLOCK_BYTE_SIZE * *sourceBlocks).value;
+    const auto chunkByteSize = std::max(params.chunkByteSize.value / BLOCK_BYTE_SIZE.value, uintmax_t{1}) * BLOCK_BYTE_SIZE.value;
 
-    for (uintmax_t blockIndex = 0; blockIndex < *sourceBlocks; ++blockIndex)
+    // Disk to disk copies can be done without reading the bytes into memory
+    if ((pSrc->GetType() == BYTE_SOURCE_TYPE_CONCURRENT_DISK) && (pDst->GetType() == BYTE_SOURCE_TYPE_CONCURRENT_DISK))
     {
-        result = blockSrc.ReadBlock(blockBytes, blockIndex);
-        if (!result) { return result; }
-
-        result = blockDst.WriteBlock(blockBytes, blockIndex, flush);
-        if (!result) { return result; }
+        return CopyDiskSource(
+            static_cast<ConcurrentDiskFITSByteSource*>(pSrc),
+            static_cast<ConcurrentDiskFITSByteSource*>(pDst),
+            totalByteSize,
+            chunkByteSize,
+            params
+        );
     }
 
-    return Result::Success();
+    return CopyPipelined(pSrc, pDst, totalByteSize, chunkByteSize, params);
 }
 
-}
\ No newline at end of file
+}
@@ -34,7 +34,7 @@ bool HeaderBlockContainsKeywordName(const HeaderBlock& headerBlock, const std::s
 
 bool HeaderContainsKeywordName(const Header& header, const std::string& keywordName)
 {
-    return std::ranges::any_of(header.headerBlocks, [&](const auto& headerBlock){
+    return std::ranges::any_of(header.GetHeaderBlocks(), [&](const auto& headerBlock){
         return HeaderBlockContainsKeywordName(headerBlock, keywordName);
     });
 }
@@ -44,7 +44,7 @@ Result ValidatePrimaryHeader(const Header& header)
     // [3.2]
     // "The primary HDU and every extension HDU shall consist of
     // one or more 2880-byte header blocks[..]"
-    if (header.headerBlocks.empty())
+    if (header.GetNumHeaderBlocks() == 0)
     {
         return Result::Fail("ValidatePrimaryHeader: Header must contain one or more header blocks");
     }
@@ -56,7 +56,7 @@ Result ValidatePrimaryHeader(const Header& header)
     // [Table 7]
     // "Mandatory keywords for primary header"
     // "SIMPLE, BITPIX, NAXIS, NAXISn, n = 1, . . . , NAXIS, END
-    const auto& firstHeaderBlock = header.headerBlocks.at(0);
+    const auto& firstHeaderBlock = header.GetHeaderBlocks().at(0);
 
     if (!HeaderBlockContainsKeywordName(firstHeaderBlock, KEYWORD_NAME_SIMPLE, 0U))
     {
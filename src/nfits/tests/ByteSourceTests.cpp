@@ -0,0 +1,1203 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <gtest/gtest.h>
+
+#include "TestUtil.h"
+
+#include <NFITS/MappedFITSByteSource.h>
+#include <NFITS/ConcurrentDiskFITSByteSource.h>
+#include <NFITS/DiskFITSByteSource.h>
+#include <NFITS/DirectDiskFITSByteSource.h>
+#include <NFITS/MemoryFITSByteSource.h>
+#include <NFITS/FITSBlockSource.h>
+#include <NFITS/CachingFITSByteSource.h>
+#include <NFITS/ReadAheadFITSByteSource.h>
+#include <NFITS/InstrumentedFITSByteSource.h>
+#include <NFITS/SpanFITSByteSource.h>
+#include <NFITS/GzipFITSByteSource.h>
+#include <NFITS/Util/Transfer.h>
+#include <NFITS/FITSFile.h>
+#include <NFITS/Data/ImageData.h>
+
+#include <zlib.h>
+
+#include <future>
+#include <random>
+#include <thread>
+
+using namespace NFITS;
+
+namespace
+{
+    std::unique_ptr<MemoryFITSByteSource> CreatePatternMemorySource(std::size_t byteSize, std::vector<std::byte>& outBytes)
+    {
+        outBytes.resize(byteSize);
+        for (std::size_t x = 0; x < outBytes.size(); ++x) { outBytes[x] = static_cast<std::byte>((x * 31) % 251); }
+
+        auto source = std::make_unique<MemoryFITSByteSource>();
+        (void)source->Resize(ByteSize(byteSize));
+        (void)source->WriteBytes(outBytes, ByteOffset(0), ByteSize(byteSize), true);
+
+        return source;
+    }
+
+    // Ranges, out of order, which are disjoint, adjacent, separated by small and large gaps, and empty
+    const std::vector<std::pair<std::size_t, std::size_t>> VECTORED_READ_RANGES = {
+        {9000, 500}, {100, 200}, {300, 50}, {400, 10}, {200000, 1000}, {5000, 0}, {2880, 2880}
+    };
+
+    std::vector<ReadRequest> CreateReadRequests(const std::vector<std::pair<std::size_t, std::size_t>>& ranges,
+                                                std::vector<std::vector<std::byte>>& outDsts)
+    {
+        outDsts.clear();
+        for (const auto& range : ranges) { outDsts.emplace_back(range.second); }
+
+        std::vector<ReadRequest> requests;
+        for (std::size_t x = 0; x < ranges.size(); ++x)
+        {
+            requests.push_back(ReadRequest{.dst = outDsts[x], .byteOffset = ByteOffset(ranges[x].first), .byteSize = ByteSize(ranges[x].second)});
+        }
+
+        return requests;
+    }
+
+    // Bytes from a small alphabet, which compress to many deflate blocks rather than a few long matches
+    std::vector<std::byte> CreateCompressibleBytes(std::size_t byteSize)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> dist(0, 15);
+
+        std::vector<std::byte> bytes(byteSize);
+        for (auto& byte : bytes) { byte = static_cast<std::byte>('a' + dist(rng)); }
+
+        return bytes;
+    }
+
+    std::vector<std::byte> GzipCompress(std::span<const std::byte> bytes)
+    {
+        z_stream stream{};
+        (void)deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+
+        std::vector<std::byte> compressed(deflateBound(&stream, static_cast<uLong>(bytes.size())));
+
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(bytes.data()));
+        stream.avail_in = static_cast<uInt>(bytes.size());
+        stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+        stream.avail_out = static_cast<uInt>(compressed.size());
+
+        (void)deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        (void)deflateEnd(&stream);
+
+        return compressed;
+    }
+
+    std::unique_ptr<MemoryFITSByteSource> CreateMemorySource(std::span<const std::byte> bytes)
+    {
+        auto source = std::make_unique<MemoryFITSByteSource>();
+        (void)source->Resize(ByteSize(bytes.size()));
+        (void)source->WriteBytes(bytes, ByteOffset(0), ByteSize(bytes.size()), true);
+
+        return source;
+    }
+
+    bool DstsMatchSource(const std::vector<std::pair<std::size_t, std::size_t>>& ranges,
+                         const std::vector<std::vector<std::byte>>& dsts,
+                         const std::vector<std::byte>& sourceBytes)
+    {
+        bool allMatch = true;
+        for (std::size_t x = 0; x < ranges.size(); ++x)
+        {
+            allMatch &= std::ranges::equal(dsts[x], std::span(sourceBytes).subspan(ranges[x].first, ranges[x].second));
+        }
+        return allMatch;
+    }
+}
+
+TEST(MappedFITSByteSource, ReadBytesAndView)
+{
+    // Setup
+    std::vector<std::byte> fileBytes(5000);
+    for (std::size_t x = 0; x < fileBytes.size(); ++x) { fileBytes[x] = static_cast<std::byte>(x % 251); }
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_mapped_read.bin", fileBytes);
+
+    // Act
+    auto source = MappedFITSByteSource::Open(filePath);
+    ASSERT_TRUE(source);
+
+    std::vector<std::byte> readBytes(100);
+    const auto readResult = (*source)->ReadBytes(readBytes, ByteOffset(4000), ByteSize(100));
+    const auto view = (*source)->GetBytesView(ByteOffset(4000), ByteSize(100));
+    const auto outOfBoundsView = (*source)->GetBytesView(ByteOffset(4950), ByteSize(100));
+    const auto outOfBoundsRead = (*source)->ReadBytes(readBytes, ByteOffset(4950), ByteSize(100));
+
+    // Assert
+    EXPECT_EQ((*source)->GetByteSize()->value, 5000U);
+    ASSERT_TRUE(readResult());
+    ASSERT_TRUE(view);
+    EXPECT_TRUE(std::ranges::equal(readBytes, std::span(fileBytes).subspan(4000, 100)));
+    EXPECT_TRUE(std::ranges::equal(*view, std::span(fileBytes).subspan(4000, 100)));
+    EXPECT_FALSE(outOfBoundsView);
+    EXPECT_FALSE(outOfBoundsRead());
+
+    source->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(MappedFITSByteSource, IsReadOnly)
+{
+    // Setup
+    const auto filePath = TestUtil::WriteTempFile("nfits_mapped_readonly.bin", std::vector<std::byte>(2880));
+
+    auto source = MappedFITSByteSource::Open(filePath);
+    ASSERT_TRUE(source);
+
+    // Act
+    const std::vector<std::byte> writeBytes(10);
+    const auto writeResult = (*source)->WriteBytes(writeBytes, ByteOffset(0), ByteSize(10), true);
+    const auto resizeResult = (*source)->Resize(ByteSize(5760));
+
+    // Assert
+    EXPECT_FALSE(writeResult());
+    EXPECT_FALSE(resizeResult());
+
+    source->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(MappedFITSByteSource, LoadImageData)
+{
+    // Setup
+    const std::vector<int16_t> values{1, -2, 300, -400, 5000, -6000};
+    const auto filePath = TestUtil::WriteTempFile("nfits_mapped_image.fits", TestUtil::BuildInt16ImageFITS(3, 2, values));
+
+    auto source = MappedFITSByteSource::Open(filePath);
+    ASSERT_TRUE(source);
+
+    // Act
+    auto fitsFile = FITSFile::OpenBlocking(std::move(*source));
+    ASSERT_TRUE(fitsFile);
+    ASSERT_EQ((*fitsFile)->GetNumHDUs(), 1U);
+
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), values.size());
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        EXPECT_EQ(imageSlice->physicalValues[x], static_cast<double>(values[x]));
+    }
+
+    fitsFile->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(SpanFITSByteSource, LoadImageDataWithoutCopying)
+{
+    // Setup - A FITS file's bytes, held by a shared buffer which only the source keeps alive
+    const std::vector<int16_t> values{1, -2, 300, -400, 5000, -6000};
+    auto pBytes = std::make_shared<const std::vector<std::byte>>(TestUtil::BuildInt16ImageFITS(3, 2, values));
+    const std::span<const std::byte> bytes(*pBytes);
+
+    auto source = SpanFITSByteSource::Create(bytes, std::move(pBytes));
+
+    // Views are of the borrowed memory itself
+    const auto view = source->GetBytesView(ByteOffset(100), ByteSize(50));
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view->data(), bytes.data() + 100);
+    EXPECT_FALSE(source->GetBytesView(ByteOffset(bytes.size() - 10), ByteSize(20)));
+    EXPECT_FALSE(source->WriteBytes(bytes, ByteOffset(0), ByteSize(10), false)());
+
+    // Act
+    auto fitsFile = FITSFile::OpenBlocking(std::move(source));
+    ASSERT_TRUE(fitsFile);
+    ASSERT_EQ((*fitsFile)->GetNumHDUs(), 1U);
+
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), values.size());
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        EXPECT_EQ(imageSlice->physicalValues[x], static_cast<double>(values[x]));
+    }
+}
+
+TEST(ConcurrentDiskFITSByteSource, ConcurrentReads)
+{
+    // Setup
+    std::vector<std::byte> fileBytes(BLOCK_BYTE_SIZE.value * 64);
+    for (std::size_t x = 0; x < fileBytes.size(); ++x) { fileBytes[x] = static_cast<std::byte>(x % 253); }
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_concurrent_read.bin", fileBytes);
+
+    auto source = ConcurrentDiskFITSByteSource::Open(filePath, ConcurrentDiskFITSByteSource::Access::ReadOnly, false);
+    ASSERT_TRUE(source);
+    ASSERT_TRUE((*source)->SupportsConcurrentReads());
+
+    // Act - Each thread reads every other block, starting from a different block, many times over
+    static constexpr std::size_t NUM_THREADS = 4;
+    std::vector<bool> threadMatches(NUM_THREADS, false);
+    std::vector<std::thread> threads;
+
+    for (std::size_t threadIndex = 0; threadIndex < NUM_THREADS; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex](){
+            bool matches = true;
+            BlockBytes blockBytes{};
+
+            for (std::size_t iteration = 0; iteration < 50; ++iteration)
+            {
+                for (std::size_t blockIndex = threadIndex; blockIndex < 64; blockIndex += 2)
+                {
+                    const auto byteOffset = blockIndex * BLOCK_BYTE_SIZE.value;
+
+                    matches &= (*source)->ReadBytes(blockBytes, ByteOffset(byteOffset), BLOCK_BYTE_SIZE)();
+                    matches &= std::ranges::equal(blockBytes, std::span(fileBytes).subspan(byteOffset, BLOCK_BYTE_SIZE.value));
+                }
+            }
+
+            threadMatches[threadIndex] = matches;
+        });
+    }
+
+    for (auto& thread : threads) { thread.join(); }
+
+    // Assert
+    for (const auto& matches : threadMatches)
+    {
+        EXPECT_TRUE(matches);
+    }
+
+    source->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(ConcurrentDiskFITSByteSource, ReadWrite)
+{
+    // Setup
+    const auto filePath = std::filesystem::temp_directory_path() / "nfits_concurrent_write.bin";
+    std::filesystem::remove(filePath);
+
+    auto source = ConcurrentDiskFITSByteSource::Open(filePath, ConcurrentDiskFITSByteSource::Access::ReadWrite, true);
+    ASSERT_TRUE(source);
+
+    // Act
+    const std::vector<std::byte> writeBytes(100, std::byte{7});
+    std::vector<std::byte> readBytes(100);
+    std::vector<std::byte> outOfBoundsBytes(100);
+
+    const auto resizeResult = (*source)->Resize(BLOCK_BYTE_SIZE);
+    const auto writeResult = (*source)->WriteBytes(writeBytes, ByteOffset(1000), ByteSize(100), true);
+    const auto readResult = (*source)->ReadBytes(readBytes, ByteOffset(1000), ByteSize(100));
+    const auto outOfBoundsRead = (*source)->ReadBytes(outOfBoundsBytes, ByteOffset(2850), ByteSize(100));
+
+    // Assert
+    EXPECT_TRUE(resizeResult());
+    EXPECT_TRUE(writeResult());
+    EXPECT_TRUE(readResult());
+    EXPECT_FALSE(outOfBoundsRead());
+    EXPECT_EQ((*source)->GetByteSize()->value, BLOCK_BYTE_SIZE.value);
+    EXPECT_EQ(readBytes, writeBytes);
+
+    source->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(ConcurrentDiskFITSByteSource, ManyAsyncReadsInFlight)
+{
+    // Setup
+    std::vector<std::byte> fileBytes(BLOCK_BYTE_SIZE.value * 64);
+    for (std::size_t x = 0; x < fileBytes.size(); ++x) { fileBytes[x] = static_cast<std::byte>(x % 239); }
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_async_read.bin", fileBytes);
+
+    auto source = ConcurrentDiskFITSByteSource::Open(filePath, ConcurrentDiskFITSByteSource::Access::ReadOnly, false);
+    ASSERT_TRUE(source);
+
+    // Act - Submit more reads, at scattered unaligned offsets, than can be in flight at once, before waiting on any
+    static constexpr std::size_t NUM_READS = 300;
+    static constexpr std::size_t READ_BYTE_SIZE = 1000;
+
+    std::vector<std::vector<std::byte>> readBytes(NUM_READS, std::vector<std::byte>(READ_BYTE_SIZE));
+    std::vector<std::size_t> readOffsets(NUM_READS);
+    std::vector<std::future<Result>> readFutures;
+
+    for (std::size_t x = 0; x < NUM_READS; ++x)
+    {
+        readOffsets[x] = (x * 7919) % (fileBytes.size() - READ_BYTE_SIZE);
+        readFutures.push_back((*source)->ReadBytesAsync(readBytes[x], ByteOffset(readOffsets[x]), ByteSize(READ_BYTE_SIZE)));
+    }
+
+    std::vector<std::byte> outOfBoundsBytes(READ_BYTE_SIZE);
+    auto outOfBoundsFuture = (*source)->ReadBytesAsync(outOfBoundsBytes, ByteOffset(fileBytes.size() + 10), ByteSize(READ_BYTE_SIZE));
+
+    // Assert
+    bool allMatch = true;
+    for (std::size_t x = 0; x < NUM_READS; ++x)
+    {
+        allMatch &= readFutures[x].get()();
+        allMatch &= std::ranges::equal(readBytes[x], std::span(fileBytes).subspan(readOffsets[x], READ_BYTE_SIZE));
+    }
+    EXPECT_TRUE(allMatch);
+    EXPECT_FALSE(outOfBoundsFuture.get()());
+
+    source->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(MemoryFITSByteSource, ReadBytesAsync)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto source = CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 4, sourceBytes);
+
+    // Act
+    std::vector<std::byte> firstBytes(2000);
+    std::vector<std::byte> secondBytes(2000);
+
+    auto firstFuture = source->ReadBytesAsync(firstBytes, ByteOffset(100), ByteSize(2000));
+    auto secondFuture = source->ReadBytesAsync(secondBytes, ByteOffset(5000), ByteSize(2000));
+
+    // Assert
+    ASSERT_TRUE(firstFuture.get()());
+    ASSERT_TRUE(secondFuture.get()());
+    EXPECT_TRUE(std::ranges::equal(firstBytes, std::span(sourceBytes).subspan(100, 2000)));
+    EXPECT_TRUE(std::ranges::equal(secondBytes, std::span(sourceBytes).subspan(5000, 2000)));
+}
+
+TEST(FITSBlockSource, ReadBlocksMatchesReadBlock)
+{
+    // Setup
+    MemoryFITSByteSource source;
+    ASSERT_TRUE(source.Resize(BLOCK_BYTE_SIZE * 8)());
+
+    std::vector<std::byte> sourceBytes(BLOCK_BYTE_SIZE.value * 8);
+    for (std::size_t x = 0; x < sourceBytes.size(); ++x) { sourceBytes[x] = static_cast<std::byte>(x % 239); }
+    ASSERT_TRUE(source.WriteBytes(sourceBytes, ByteOffset(0), ByteSize(sourceBytes.size()), true)());
+
+    FITSBlockSource blockSource(&source);
+
+    // Act
+    std::vector<std::byte> blocksBytes(BLOCK_BYTE_SIZE.value * 5);
+    const auto readBlocksResult = blockSource.ReadBlocks(blocksBytes, 2, 5);
+
+    std::vector<std::byte> spanBytes(1000);
+    const auto readSpanResult = blockSource.ReadSpan(spanBytes, ByteOffset(3000), ByteSize(1000));
+
+    // Assert
+    ASSERT_TRUE(readBlocksResult());
+    ASSERT_TRUE(readSpanResult());
+
+    for (uintmax_t x = 0; x < 5; ++x)
+    {
+        BlockBytes blockBytes{};
+        ASSERT_TRUE(blockSource.ReadBlock(blockBytes, 2 + x)());
+        EXPECT_TRUE(std::ranges::equal(blockBytes, std::span(blocksBytes).subspan(x * BLOCK_BYTE_SIZE.value, BLOCK_BYTE_SIZE.value)));
+    }
+
+    EXPECT_TRUE(std::ranges::equal(spanBytes, std::span(sourceBytes).subspan(3000, 1000)));
+}
+
+TEST(DiskFITSByteSource, LoadMultiChunkImageData)
+{
+    // Setup - An image which spans multiple read chunks
+    const int64_t width = 2000;
+    const int64_t height = 1600;
+
+    std::vector<int16_t> values(static_cast<std::size_t>(width * height));
+    for (std::size_t x = 0; x < values.size(); ++x) { values[x] = static_cast<int16_t>((x * 7) % 30011); }
+
+    const auto fitsBytes = TestUtil::BuildInt16ImageFITS(width, height, values);
+    ASSERT_GT(fitsBytes.size(), READ_CHUNK_BYTE_SIZE.value);
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_disk_multichunk.fits", fitsBytes);
+
+    auto source = DiskFITSByteSource::Open(filePath, false);
+    ASSERT_TRUE(source);
+
+    // Act
+    auto fitsFile = FITSFile::OpenBlocking(std::move(*source));
+    ASSERT_TRUE(fitsFile);
+
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), values.size());
+
+    bool allMatch = true;
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        allMatch &= static_cast<int16_t>(imageSlice->physicalValues[x]) == values[x];
+    }
+    EXPECT_TRUE(allMatch);
+
+    fitsFile->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(DirectDiskFITSByteSource, UnalignedReadsMatchFile)
+{
+    // Setup - A file whose size isn't a multiple of the direct I/O alignment
+    std::vector<std::byte> fileBytes(DIRECT_IO_CHUNK_BYTE_SIZE.value + 100000);
+    for (std::size_t x = 0; x < fileBytes.size(); ++x) { fileBytes[x] = static_cast<std::byte>((x * 7) % 251); }
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_direct_read.bin", fileBytes);
+
+    auto source = DirectDiskFITSByteSource::Open(filePath);
+    ASSERT_TRUE(source);
+
+    // Reads of blocks, of aligned and unaligned ranges, of an unaligned chunk of blocks, of ranges larger than
+    // one bounce buffer, and at the end of the file
+    const std::vector<std::pair<std::size_t, std::size_t>> ranges = {
+        {BLOCK_BYTE_SIZE.value * 3, BLOCK_BYTE_SIZE.value * 5},
+        {0, DIRECT_IO_ALIGNMENT_BYTE_SIZE.value * 2},
+        {1, 1},
+        {BLOCK_BYTE_SIZE.value * 7, READ_CHUNK_BYTE_SIZE.value},
+        {5000, DIRECT_IO_CHUNK_BYTE_SIZE.value + 30000},
+        {fileBytes.size() - 10, 10},
+        {0, fileBytes.size()}
+    };
+
+    // Act/Assert
+    for (const auto& range : ranges)
+    {
+        std::vector<std::byte> readBytes(range.second);
+        ASSERT_TRUE((*source)->ReadBytes(readBytes, ByteOffset(range.first), ByteSize(range.second))());
+        EXPECT_TRUE(std::ranges::equal(readBytes, std::span(fileBytes).subspan(range.first, range.second)));
+    }
+
+    std::vector<std::byte> readBytes(20);
+    EXPECT_FALSE((*source)->ReadBytes(readBytes, ByteOffset(fileBytes.size() - 10), ByteSize(20))());
+    EXPECT_FALSE((*source)->WriteBytes(readBytes, ByteOffset(0), ByteSize(10), false)());
+
+    source->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(DirectDiskFITSByteSource, LoadMultiChunkImageData)
+{
+    // Setup - An image which spans multiple read chunks
+    const int64_t width = 2000;
+    const int64_t height = 1600;
+
+    std::vector<int16_t> values(static_cast<std::size_t>(width * height));
+    for (std::size_t x = 0; x < values.size(); ++x) { values[x] = static_cast<int16_t>((x * 11) % 30011); }
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_direct_multichunk.fits", TestUtil::BuildInt16ImageFITS(width, height, values));
+
+    auto source = DirectDiskFITSByteSource::Open(filePath);
+    ASSERT_TRUE(source);
+
+    // Act
+    auto fitsFile = FITSFile::OpenBlocking(std::move(*source));
+    ASSERT_TRUE(fitsFile);
+
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), values.size());
+
+    bool allMatch = true;
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        allMatch &= static_cast<int16_t>(imageSlice->physicalValues[x]) == values[x];
+    }
+    EXPECT_TRUE(allMatch);
+
+    fitsFile->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(CopyFITSSource, CopiesAllBlocks)
+{
+    // Setup
+    const auto blockCount = READ_CHUNK_BLOCK_COUNT + 3U;
+
+    std::vector<std::byte> sourceBytes(BLOCK_BYTE_SIZE.value * blockCount);
+    for (std::size_t x = 0; x < sourceBytes.size(); ++x) { sourceBytes[x] = static_cast<std::byte>(x % 241); }
+
+    MemoryFITSByteSource src;
+    ASSERT_TRUE(src.Resize(ByteSize(sourceBytes.size()))());
+    ASSERT_TRUE(src.WriteBytes(sourceBytes, ByteOffset(0), ByteSize(sourceBytes.size()), true)());
+
+    MemoryFITSByteSource dst;
+
+    // Act
+    const auto result = CopyFITSSource(&src, &dst, false);
+
+    // Assert
+    ASSERT_TRUE(result());
+    ASSERT_EQ(dst.GetByteSize()->value, sourceBytes.size());
+
+    std::vector<std::byte> dstBytes(sourceBytes.size());
+    ASSERT_TRUE(dst.ReadBytes(dstBytes, ByteOffset(0), ByteSize(dstBytes.size()))());
+    EXPECT_EQ(dstBytes, sourceBytes);
+}
+
+TEST(CopyFITSSource, DiskToDiskReportsProgress)
+{
+    // Setup
+    const auto srcPath = std::filesystem::temp_directory_path() / "nfits_copy_src.bin";
+    const auto dstPath = std::filesystem::temp_directory_path() / "nfits_copy_dst.bin";
+    std::filesystem::remove(srcPath);
+    std::filesystem::remove(dstPath);
+
+    std::vector<std::byte> sourceBytes;
+    const auto memorySource = CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 25, sourceBytes);
+
+    auto src = ConcurrentDiskFITSByteSource::Open(srcPath, ConcurrentDiskFITSByteSource::Access::ReadWrite, true);
+    auto dst = ConcurrentDiskFITSByteSource::Open(dstPath, ConcurrentDiskFITSByteSource::Access::ReadWrite, true);
+    ASSERT_TRUE(src);
+    ASSERT_TRUE(dst);
+    ASSERT_TRUE((*src)->Resize(ByteSize(sourceBytes.size()))());
+    ASSERT_TRUE((*src)->WriteBytes(sourceBytes, ByteOffset(0), ByteSize(sourceBytes.size()), true)());
+
+    // Act - Copy in chunks of 10 blocks, syncing each to disk
+    std::vector<uintmax_t> progress;
+
+    const auto result = CopyFITSSource(src->get(), dst->get(), CopyParams{
+        .flush = true,
+        .chunkByteSize = BLOCK_BYTE_SIZE * 10U,
+        .onProgress = [&](uintmax_t copiedByteSize, uintmax_t totalByteSize){
+            EXPECT_EQ(totalByteSize, sourceBytes.size());
+            progress.push_back(copiedByteSize);
+        }
+    });
+
+    // Assert
+    ASSERT_TRUE(result());
+    ASSERT_EQ((*dst)->GetByteSize()->value, sourceBytes.size());
+
+    std::vector<std::byte> dstBytes(sourceBytes.size());
+    ASSERT_TRUE((*dst)->ReadBytes(dstBytes, ByteOffset(0), ByteSize(dstBytes.size()))());
+    EXPECT_EQ(dstBytes, sourceBytes);
+    EXPECT_EQ(progress, (std::vector<uintmax_t>{BLOCK_BYTE_SIZE.value * 10, BLOCK_BYTE_SIZE.value * 20, BLOCK_BYTE_SIZE.value * 25}));
+
+    src->reset();
+    dst->reset();
+    std::filesystem::remove(srcPath);
+    std::filesystem::remove(dstPath);
+}
+
+TEST(CopyFITSSource, Cancellation)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto src = CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 30, sourceBytes);
+    MemoryFITSByteSource dst;
+
+    // Act - Cancel once the first chunk has been copied
+    unsigned int progressCount = 0;
+
+    const auto result = CopyFITSSource(src.get(), &dst, CopyParams{
+        .chunkByteSize = BLOCK_BYTE_SIZE * 10U,
+        .onProgress = [&](uintmax_t, uintmax_t){ progressCount++; },
+        .isCancelled = [&](){ return progressCount >= 1U; }
+    });
+
+    // Assert
+    EXPECT_FALSE(result());
+    EXPECT_EQ(progressCount, 1U);
+
+    std::vector<std::byte> dstBytes(BLOCK_BYTE_SIZE.value * 10);
+    ASSERT_TRUE(dst.ReadBytes(dstBytes, ByteOffset(0), ByteSize(dstBytes.size()))());
+    EXPECT_TRUE(std::ranges::equal(dstBytes, std::span(sourceBytes).subspan(0, dstBytes.size())));
+}
+
+TEST(CachingFITSByteSource, RepeatedReadsHitCache)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto pCache = std::make_shared<FITSByteCache>(FITSByteCacheParams{.byteBudget = ByteSize(1024U * 1024U), .pageBlockCount = 1U, .shardCount = 4U});
+    auto source = CachingFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 10, sourceBytes), pCache, "");
+
+    // Act
+    std::vector<std::byte> firstRead(5000);
+    std::vector<std::byte> secondRead(5000);
+
+    const auto firstResult = source->ReadBytes(firstRead, ByteOffset(1000), ByteSize(5000));
+    const auto statsAfterFirst = pCache->GetStats();
+    const auto secondResult = source->ReadBytes(secondRead, ByteOffset(1000), ByteSize(5000));
+    const auto statsAfterSecond = pCache->GetStats();
+
+    // Assert - The read spans pages 0,1,2; missed the first time, hit the second time
+    ASSERT_TRUE(firstResult());
+    ASSERT_TRUE(secondResult());
+    EXPECT_TRUE(std::ranges::equal(firstRead, std::span(sourceBytes).subspan(1000, 5000)));
+    EXPECT_EQ(firstRead, secondRead);
+
+    EXPECT_EQ(statsAfterFirst.hits, 0U);
+    EXPECT_EQ(statsAfterFirst.misses, 3U); // Three misses, whose run of uncached pages was read with one read
+    EXPECT_EQ(statsAfterFirst.residentByteSize, BLOCK_BYTE_SIZE.value * 3);
+    EXPECT_EQ(statsAfterSecond.hits, 3U);
+    EXPECT_EQ(statsAfterSecond.misses, 3U);
+}
+
+TEST(CachingFITSByteSource, ChunkSizedReadsBypassCache)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto pCache = std::make_shared<FITSByteCache>(FITSByteCacheParams{});
+    auto source = CachingFITSByteSource::Create(CreatePatternMemorySource(READ_CHUNK_BYTE_SIZE.value * 2, sourceBytes), pCache, "");
+
+    // Act - A read of a whole chunk, from an offset which isn't page aligned, and a read of one block
+    std::vector<std::byte> chunkBytes(READ_CHUNK_BYTE_SIZE.value);
+    BlockBytes blockBytes{};
+
+    const auto chunkResult = source->ReadBytes(chunkBytes, ByteOffset(BLOCK_BYTE_SIZE), READ_CHUNK_BYTE_SIZE);
+    const auto statsAfterChunk = pCache->GetStats();
+    const auto blockResult = source->ReadBytes(blockBytes, ByteOffset(0), BLOCK_BYTE_SIZE);
+    const auto statsAfterBlock = pCache->GetStats();
+
+    // Assert - Only the block read went through the cache
+    ASSERT_TRUE(chunkResult());
+    ASSERT_TRUE(blockResult());
+    EXPECT_TRUE(std::ranges::equal(chunkBytes, std::span(sourceBytes).subspan(BLOCK_BYTE_SIZE.value, READ_CHUNK_BYTE_SIZE.value)));
+
+    EXPECT_EQ(statsAfterChunk.misses, 0U);
+    EXPECT_EQ(statsAfterChunk.residentByteSize, 0U);
+    EXPECT_EQ(statsAfterBlock.misses, 1U);
+    EXPECT_EQ(statsAfterBlock.residentByteSize, pCache->GetPageByteSize().value);
+}
+
+TEST(CachingFITSByteSource, EvictsToStayWithinBudget)
+{
+    // Setup - A single shard budget which only holds two pages
+    std::vector<std::byte> sourceBytes;
+    auto pCache = std::make_shared<FITSByteCache>(FITSByteCacheParams{.byteBudget = BLOCK_BYTE_SIZE * 2, .pageBlockCount = 1U, .shardCount = 1U});
+    auto source = CachingFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 10, sourceBytes), pCache, "");
+
+    // Act
+    BlockBytes blockBytes{};
+    bool allMatch = true;
+
+    for (uintmax_t blockIndex = 0; blockIndex < 10; ++blockIndex)
+    {
+        allMatch &= source->ReadBytes(blockBytes, ByteOffset(BLOCK_BYTE_SIZE * blockIndex), BLOCK_BYTE_SIZE)();
+        allMatch &= std::ranges::equal(blockBytes, std::span(sourceBytes).subspan(blockIndex * BLOCK_BYTE_SIZE.value, BLOCK_BYTE_SIZE.value));
+    }
+
+    const auto stats = pCache->GetStats();
+
+    // Assert
+    EXPECT_TRUE(allMatch);
+    EXPECT_EQ(stats.evictions, 8U);
+    EXPECT_EQ(stats.residentByteSize, BLOCK_BYTE_SIZE.value * 2);
+}
+
+TEST(CachingFITSByteSource, WritesInvalidateCachedBytes)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto pCache = std::make_shared<FITSByteCache>(FITSByteCacheParams{});
+    auto source = CachingFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 4, sourceBytes), pCache, "");
+
+    std::vector<std::byte> readBytes(100);
+    ASSERT_TRUE(source->ReadBytes(readBytes, ByteOffset(500), ByteSize(100))());
+
+    // Act
+    const std::vector<std::byte> writeBytes(50, std::byte{0xAB});
+    const auto writeResult = source->WriteBytes(writeBytes, ByteOffset(520), ByteSize(50), true);
+    const auto readResult = source->ReadBytes(readBytes, ByteOffset(500), ByteSize(100));
+
+    // Assert
+    ASSERT_TRUE(writeResult());
+    ASSERT_TRUE(readResult());
+    EXPECT_TRUE(std::ranges::equal(std::span(readBytes).subspan(0, 20), std::span(sourceBytes).subspan(500, 20)));
+    EXPECT_TRUE(std::ranges::equal(std::span(readBytes).subspan(20, 50), writeBytes));
+    EXPECT_TRUE(std::ranges::equal(std::span(readBytes).subspan(70, 30), std::span(sourceBytes).subspan(570, 30)));
+}
+
+TEST(CachingFITSByteSource, SharedKeySharesCachedBytes)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto pCache = std::make_shared<FITSByteCache>(FITSByteCacheParams{});
+
+    std::vector<std::byte> readBytes(100);
+    {
+        auto firstSource = CachingFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 4, sourceBytes), pCache, "key");
+        ASSERT_TRUE(firstSource->ReadBytes(readBytes, ByteOffset(0), ByteSize(100))());
+    }
+
+    // Act - A second source, with the same key, reading the same bytes after the first source was destroyed
+    auto secondSource = CachingFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 4, sourceBytes), pCache, "key");
+    const auto readResult = secondSource->ReadBytes(readBytes, ByteOffset(0), ByteSize(100));
+
+    // Assert
+    ASSERT_TRUE(readResult());
+    EXPECT_EQ(pCache->GetStats().hits, 1U);
+    EXPECT_TRUE(std::ranges::equal(readBytes, std::span(sourceBytes).subspan(0, 100)));
+}
+
+TEST(ReadAheadFITSByteSource, SequentialReadsAreServedFromPrefetchedBytes)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto source = ReadAheadFITSByteSource::Create(
+        CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 40, sourceBytes),
+        ReadAheadParams{.windowByteSize = ByteSize(BLOCK_BYTE_SIZE.value * 4), .sequentialReadThreshold = 2U}
+    );
+
+    // Act - Read the whole source, in order, in reads which don't line up with the prefetch windows
+    std::vector<std::byte> readBytes(sourceBytes.size());
+    bool allSucceeded = true;
+
+    for (std::size_t offset = 0; offset < sourceBytes.size(); offset += 1000)
+    {
+        const auto readByteSize = std::min<std::size_t>(1000, sourceBytes.size() - offset);
+        allSucceeded &= source->ReadBytes(std::span(readBytes).subspan(offset), ByteOffset(offset), ByteSize(readByteSize))();
+    }
+
+    const auto stats = source->GetStats();
+
+    // Assert
+    EXPECT_TRUE(allSucceeded);
+    EXPECT_EQ(readBytes, sourceBytes);
+
+    // Only the reads before access was detected as sequential were read directly
+    EXPECT_EQ(stats.directByteSize, 3000U);
+    EXPECT_EQ(stats.servedByteSize, sourceBytes.size() - 3000U);
+    EXPECT_GE(stats.prefetchedByteSize, stats.servedByteSize);
+}
+
+TEST(ReadAheadFITSByteSource, RandomReadsDontPrefetch)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto source = ReadAheadFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 10, sourceBytes));
+
+    // Act
+    std::vector<std::byte> readBytes(100);
+    bool allMatch = true;
+
+    for (const std::size_t offset : {20000U, 500U, 9000U, 100U, 25000U})
+    {
+        allMatch &= source->ReadBytes(readBytes, ByteOffset(offset), ByteSize(100))();
+        allMatch &= std::ranges::equal(readBytes, std::span(sourceBytes).subspan(offset, 100));
+    }
+
+    // Assert
+    EXPECT_TRUE(allMatch);
+    EXPECT_EQ(source->GetStats().prefetchedByteSize, 0U);
+    EXPECT_EQ(source->GetStats().directByteSize, 500U);
+}
+
+TEST(ReadAheadFITSByteSource, WritesDiscardPrefetchedBytes)
+{
+    // Setup - Advise sequential access, which starts prefetching the start of the source
+    std::vector<std::byte> sourceBytes;
+    auto source = ReadAheadFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 4, sourceBytes));
+    source->AdviseAccess(ByteOffset(0), ByteSize(sourceBytes.size()), ByteAccessHint::Sequential);
+
+    std::vector<std::byte> readBytes(100);
+    ASSERT_TRUE(source->ReadBytes(readBytes, ByteOffset(0), ByteSize(100))());
+
+    // Act
+    const std::vector<std::byte> writeBytes(50, std::byte{0xAB});
+    const auto writeResult = source->WriteBytes(writeBytes, ByteOffset(120), ByteSize(50), true);
+    const auto readResult = source->ReadBytes(readBytes, ByteOffset(100), ByteSize(100));
+
+    // Assert
+    ASSERT_TRUE(writeResult());
+    ASSERT_TRUE(readResult());
+    EXPECT_TRUE(std::ranges::equal(std::span(readBytes).subspan(0, 20), std::span(sourceBytes).subspan(100, 20)));
+    EXPECT_TRUE(std::ranges::equal(std::span(readBytes).subspan(20, 50), writeBytes));
+    EXPECT_TRUE(std::ranges::equal(std::span(readBytes).subspan(70, 30), std::span(sourceBytes).subspan(170, 30)));
+}
+
+TEST(ReadAheadFITSByteSource, ChunkSizedReadsBypassPrefetching)
+{
+    // Setup - Advise sequential access, as image loads do
+    std::vector<std::byte> sourceBytes;
+    auto source = ReadAheadFITSByteSource::Create(CreatePatternMemorySource(READ_CHUNK_BYTE_SIZE.value * 3, sourceBytes));
+    source->AdviseAccess(ByteOffset(0), ByteSize(sourceBytes.size()), ByteAccessHint::Sequential);
+
+    // Act - Read chunks concurrently, out of order
+    std::vector<std::byte> readBytes(sourceBytes.size());
+
+    auto readChunk = [&](std::size_t chunkIndex){
+        const auto offset = chunkIndex * READ_CHUNK_BYTE_SIZE.value;
+        return source->ReadBytes(std::span(readBytes).subspan(offset), ByteOffset(offset), READ_CHUNK_BYTE_SIZE)();
+    };
+
+    auto chunk2Read = std::async(std::launch::async, readChunk, 2U);
+    auto chunk0Read = std::async(std::launch::async, readChunk, 0U);
+    const bool chunk1Read = readChunk(1U);
+
+    // Assert
+    EXPECT_TRUE(chunk0Read.get());
+    EXPECT_TRUE(chunk1Read);
+    EXPECT_TRUE(chunk2Read.get());
+    EXPECT_EQ(readBytes, sourceBytes);
+
+    const auto stats = source->GetStats();
+    EXPECT_EQ(stats.directByteSize, sourceBytes.size());
+    EXPECT_EQ(stats.servedByteSize, 0U);
+    EXPECT_EQ(stats.prefetchWaits, 0U);
+}
+
+TEST(ReadAheadFITSByteSource, LoadMultiChunkImageData)
+{
+    // Setup - An image which spans multiple read chunks, read from disk through a read-ahead source
+    const int64_t width = 2000;
+    const int64_t height = 1600;
+
+    std::vector<int16_t> values(static_cast<std::size_t>(width * height));
+    for (std::size_t x = 0; x < values.size(); ++x) { values[x] = static_cast<int16_t>((x * 13) % 30011); }
+
+    const auto fitsBytes = TestUtil::BuildInt16ImageFITS(width, height, values);
+    const auto filePath = TestUtil::WriteTempFile("nfits_readahead_multichunk.fits", fitsBytes);
+
+    auto diskSource = DiskFITSByteSource::Open(filePath, false);
+    ASSERT_TRUE(diskSource);
+
+    auto source = ReadAheadFITSByteSource::Create(std::move(*diskSource));
+    const auto* pSource = source.get();
+
+    // Act
+    auto fitsFile = FITSFile::OpenBlocking(std::move(source));
+    ASSERT_TRUE(fitsFile);
+
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), values.size());
+
+    bool allMatch = true;
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        allMatch &= static_cast<int16_t>(imageSlice->physicalValues[x]) == values[x];
+    }
+    EXPECT_TRUE(allMatch);
+
+    // Whole read chunks of the image data bypassed prefetching; only its final, partial, chunk was read through it
+    const auto stats = pSource->GetStats();
+    EXPECT_GE(stats.directByteSize, READ_CHUNK_BYTE_SIZE.value);
+    EXPECT_GE(stats.directByteSize + stats.servedByteSize, static_cast<uintmax_t>(width * height * 2));
+
+    fitsFile->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(IFITSByteSource, ReadBytesV)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto source = CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 100, sourceBytes);
+
+    std::vector<std::vector<std::byte>> dsts;
+    const auto requests = CreateReadRequests(VECTORED_READ_RANGES, dsts);
+
+    // Overlapping ranges
+    std::vector<std::vector<std::byte>> overlappingDsts;
+    const auto overlappingRequests = CreateReadRequests({{1000, 500}, {1200, 500}}, overlappingDsts);
+
+    // Act
+    const auto result = source->ReadBytesV(requests);
+    const auto overlappingResult = source->ReadBytesV(overlappingRequests);
+
+    // Assert
+    ASSERT_TRUE(result());
+    ASSERT_TRUE(overlappingResult());
+    EXPECT_TRUE(DstsMatchSource(VECTORED_READ_RANGES, dsts, sourceBytes));
+    EXPECT_TRUE(DstsMatchSource({{1000, 500}, {1200, 500}}, overlappingDsts, sourceBytes));
+}
+
+TEST(ConcurrentDiskFITSByteSource, ReadBytesV)
+{
+    // Setup
+    std::vector<std::byte> fileBytes(BLOCK_BYTE_SIZE.value * 100);
+    for (std::size_t x = 0; x < fileBytes.size(); ++x) { fileBytes[x] = static_cast<std::byte>(x % 229); }
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_readv.bin", fileBytes);
+
+    auto source = ConcurrentDiskFITSByteSource::Open(filePath, ConcurrentDiskFITSByteSource::Access::ReadOnly, false);
+    ASSERT_TRUE(source);
+
+    std::vector<std::vector<std::byte>> dsts;
+    const auto requests = CreateReadRequests(VECTORED_READ_RANGES, dsts);
+
+    std::vector<std::vector<std::byte>> overlappingDsts;
+    const auto overlappingRequests = CreateReadRequests({{1000, 500}, {1200, 500}}, overlappingDsts);
+
+    std::vector<std::vector<std::byte>> outOfBoundsDsts;
+    const auto outOfBoundsRequests = CreateReadRequests({{100, 10}, {fileBytes.size() - 5, 10}}, outOfBoundsDsts);
+
+    // Act
+    const auto result = (*source)->ReadBytesV(requests);
+    const auto overlappingResult = (*source)->ReadBytesV(overlappingRequests);
+    const auto outOfBoundsResult = (*source)->ReadBytesV(outOfBoundsRequests);
+
+    // Assert
+    ASSERT_TRUE(result());
+    ASSERT_TRUE(overlappingResult());
+    EXPECT_FALSE(outOfBoundsResult());
+    EXPECT_TRUE(DstsMatchSource(VECTORED_READ_RANGES, dsts, fileBytes));
+    EXPECT_TRUE(DstsMatchSource({{1000, 500}, {1200, 500}}, overlappingDsts, fileBytes));
+
+    source->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(InstrumentedFITSByteSource, RecordsOpCountsAndBytes)
+{
+    // Setup
+    std::vector<std::byte> sourceBytes;
+    auto source = InstrumentedFITSByteSource::Create(CreatePatternMemorySource(BLOCK_BYTE_SIZE.value * 4, sourceBytes));
+
+    // Act
+    std::vector<std::byte> readBytes(1000);
+    const auto readResult1 = source->ReadBytes(readBytes, ByteOffset(0), ByteSize(1000));
+    const auto readResult2 = source->ReadBytes(readBytes, ByteOffset(5000), ByteSize(500));
+    const auto failedReadResult = source->ReadBytes(readBytes, ByteOffset(sourceBytes.size()), ByteSize(100));
+
+    const std::vector<std::byte> writeBytes(200, std::byte{0xAB});
+    const auto writeResult = source->WriteBytes(writeBytes, ByteOffset(100), ByteSize(200), false);
+    const auto flushResult = source->Flush();
+
+    const auto stats = source->GetStats();
+
+    // Assert
+    ASSERT_TRUE(readResult1());
+    ASSERT_TRUE(readResult2());
+    ASSERT_FALSE(failedReadResult());
+    ASSERT_TRUE(writeResult());
+    ASSERT_TRUE(flushResult());
+
+    EXPECT_EQ(stats.reads.count, 3U);
+    EXPECT_EQ(stats.reads.failedCount, 1U);
+    EXPECT_EQ(stats.reads.byteSize, 1500U);
+    EXPECT_EQ(stats.reads.latency.GetCount(), 3U);
+
+    EXPECT_EQ(stats.writes.count, 1U);
+    EXPECT_EQ(stats.writes.byteSize, 200U);
+    EXPECT_EQ(stats.flushes.count, 1U);
+
+    // Percentiles are monotonic
+    EXPECT_LE(stats.reads.latency.GetPercentile(50.0), stats.reads.latency.GetPercentile(99.0));
+
+    // Resetting clears all stats
+    source->ResetStats();
+    EXPECT_EQ(source->GetStats().reads.count, 0U);
+    EXPECT_EQ(source->GetStats().reads.latency.GetCount(), 0U);
+}
+
+TEST(InstrumentedFITSByteSource, RecordsViewsAndForwardsAsyncReads)
+{
+    // Setup - A source which provides views, and which records the async reads it's asked to perform
+    class AsyncCountingSource : public MemoryFITSByteSource
+    {
+        public:
+
+            std::future<Result> ReadBytesAsync(std::span<std::byte> dst, const ByteOffset& byteOffset, const ByteSize& byteSize) override
+            {
+                numAsyncReads++;
+                return MemoryFITSByteSource::ReadBytesAsync(dst, byteOffset, byteSize);
+            }
+
+            std::optional<std::span<const std::byte>> GetBytesView(const ByteOffset& byteOffset, const ByteSize& byteSize) const override
+            {
+                return std::span<const std::byte>(bytes).subspan(static_cast<std::size_t>(byteOffset.value), static_cast<std::size_t>(byteSize.value));
+            }
+
+            std::vector<std::byte> bytes;
+            std::size_t numAsyncReads{0};
+    };
+
+    auto pWrappedSource = std::make_unique<AsyncCountingSource>();
+    pWrappedSource->bytes.resize(BLOCK_BYTE_SIZE.value);
+    for (std::size_t x = 0; x < pWrappedSource->bytes.size(); ++x) { pWrappedSource->bytes[x] = static_cast<std::byte>((x * 31) % 251); }
+    (void)pWrappedSource->Resize(ByteSize(pWrappedSource->bytes.size()));
+    (void)pWrappedSource->WriteBytes(pWrappedSource->bytes, ByteOffset(0), ByteSize(pWrappedSource->bytes.size()), true);
+
+    const auto pCountingSource = pWrappedSource.get();
+    auto source = InstrumentedFITSByteSource::Create(std::move(pWrappedSource));
+
+    // Act
+    const auto view = source->GetBytesView(ByteOffset(100), ByteSize(300));
+
+    std::vector<std::byte> readBytes(500);
+    auto asyncRead = source->ReadBytesAsync(readBytes, ByteOffset(200), ByteSize(500));
+    const auto asyncReadResult = asyncRead.get();
+
+    const auto stats = source->GetStats();
+
+    // Assert
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view->size(), 300U);
+    EXPECT_EQ(stats.views.count, 1U);
+    EXPECT_EQ(stats.views.byteSize, 300U);
+
+    ASSERT_TRUE(asyncReadResult());
+    EXPECT_TRUE(std::ranges::equal(readBytes, std::span(pCountingSource->bytes).subspan(200, 500)));
+    EXPECT_EQ(pCountingSource->numAsyncReads, 1U);
+    EXPECT_EQ(stats.reads.count, 1U);
+    EXPECT_EQ(stats.reads.byteSize, 500U);
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+    // Setup
+    LatencyHistogram histogram;
+
+    // Act - 90 fast ops and 10 slow ops
+    for (int x = 0; x < 90; ++x) { histogram.Record(std::chrono::microseconds(3)); }
+    for (int x = 0; x < 10; ++x) { histogram.Record(std::chrono::milliseconds(5)); }
+
+    // Assert - Percentiles are reported as the upper bound of the bucket they fall into
+    EXPECT_EQ(histogram.GetCount(), 100U);
+    EXPECT_EQ(histogram.GetPercentile(50.0), std::chrono::microseconds(4));
+    EXPECT_EQ(histogram.GetPercentile(90.0), std::chrono::microseconds(4));
+    EXPECT_EQ(histogram.GetPercentile(99.0), std::chrono::microseconds(8192));
+    EXPECT_EQ(LatencyHistogram{}.GetPercentile(50.0), std::chrono::microseconds(0));
+}
+
+TEST(GzipFITSByteSource, RandomReadsMatchUncompressedBytes)
+{
+    // Setup
+    const auto bytes = CreateCompressibleBytes(1024U * 1024U);
+    const auto compressed = GzipCompress(bytes);
+
+    // Act
+    auto source = GzipFITSByteSource::Create(CreateMemorySource(compressed), GzipParams{.checkpointSpacing = ByteSize(64U * 1024U), .cachedSpanCount = 2U});
+    ASSERT_TRUE(source);
+
+    // Assert
+    EXPECT_EQ((*source)->GetByteSize()->value, bytes.size());
+    EXPECT_GT((*source)->GetNumCheckpoints(), 4U);
+
+    // Reads which are within a span, cross spans, and are out of order, so spans are evicted and re-inflated
+    const std::vector<std::pair<std::size_t, std::size_t>> ranges = {
+        {900000, 5000}, {0, 100}, {65000, 200000}, {bytes.size() - 10, 10}, {300000, 1}, {0, bytes.size()}
+    };
+
+    for (const auto& range : ranges)
+    {
+        std::vector<std::byte> readBytes(range.second);
+        ASSERT_TRUE((*source)->ReadBytes(readBytes, ByteOffset(range.first), ByteSize(range.second))());
+        EXPECT_TRUE(std::ranges::equal(readBytes, std::span(bytes).subspan(range.first, range.second)));
+    }
+
+    std::vector<std::byte> readBytes(20);
+    EXPECT_FALSE((*source)->ReadBytes(readBytes, ByteOffset(bytes.size() - 10), ByteSize(20))());
+    EXPECT_FALSE((*source)->WriteBytes(readBytes, ByteOffset(0), ByteSize(10), false)());
+}
+
+TEST(GzipFITSByteSource, MultipleMembers)
+{
+    // Setup - Two gzip members, concatenated
+    const auto bytes = CreateCompressibleBytes(512U * 1024U);
+    const auto half = std::span(bytes).size() / 2;
+
+    auto compressed = GzipCompress(std::span(bytes).first(half));
+    const auto compressed2 = GzipCompress(std::span(bytes).subspan(half));
+    compressed.insert(compressed.end(), compressed2.begin(), compressed2.end());
+
+    // Act
+    auto source = GzipFITSByteSource::Create(CreateMemorySource(compressed), GzipParams{.checkpointSpacing = ByteSize(48U * 1024U)});
+    ASSERT_TRUE(source);
+
+    // Assert - Including reads which cross from one member into the next
+    EXPECT_EQ((*source)->GetByteSize()->value, bytes.size());
+
+    std::vector<std::byte> readBytes(bytes.size());
+    ASSERT_TRUE((*source)->ReadBytes(readBytes, ByteOffset(0), ByteSize(bytes.size()))());
+    EXPECT_TRUE(std::ranges::equal(readBytes, bytes));
+
+    readBytes.resize(100000);
+    ASSERT_TRUE((*source)->ReadBytes(readBytes, ByteOffset(half - 50000), ByteSize(100000))());
+    EXPECT_TRUE(std::ranges::equal(readBytes, std::span(bytes).subspan(half - 50000, 100000)));
+}
+
+TEST(GzipFITSByteSource, PersistedIndexIsLoaded)
+{
+    // Setup
+    const auto bytes = CreateCompressibleBytes(256U * 1024U);
+    const auto compressed = GzipCompress(bytes);
+
+    const auto indexFilePath = std::filesystem::temp_directory_path() / "nfits_gzip_index.idx";
+    std::filesystem::remove(indexFilePath);
+
+    const GzipParams params{.checkpointSpacing = ByteSize(32U * 1024U), .indexFilePath = indexFilePath};
+
+    // Act - The first create builds and saves the index, the second loads it
+    auto source = GzipFITSByteSource::Create(CreateMemorySource(compressed), params);
+    ASSERT_TRUE(source);
+    ASSERT_TRUE(std::filesystem::exists(indexFilePath));
+
+    auto loadedSource = GzipFITSByteSource::Create(CreateMemorySource(compressed), params);
+    ASSERT_TRUE(loadedSource);
+
+    // An index which doesn't match the compressed bytes is ignored
+    auto otherCompressed = GzipCompress(CreateCompressibleBytes(100U * 1024U));
+    auto otherSource = GzipFITSByteSource::Create(CreateMemorySource(otherCompressed), params);
+    ASSERT_TRUE(otherSource);
+
+    // Assert
+    EXPECT_EQ((*loadedSource)->GetNumCheckpoints(), (*source)->GetNumCheckpoints());
+    EXPECT_EQ((*loadedSource)->GetByteSize()->value, bytes.size());
+    EXPECT_EQ((*otherSource)->GetByteSize()->value, 100U * 1024U);
+
+    std::vector<std::byte> readBytes(10000);
+    ASSERT_TRUE((*loadedSource)->ReadBytes(readBytes, ByteOffset(200000), ByteSize(10000))());
+    EXPECT_TRUE(std::ranges::equal(readBytes, std::span(bytes).subspan(200000, 10000)));
+
+    std::filesystem::remove(indexFilePath);
+}
+
+TEST(GzipFITSByteSource, LoadImageData)
+{
+    // Setup
+    const std::vector<int16_t> values{1, -2, 300, -400, 5000, -6000};
+    const auto compressed = GzipCompress(TestUtil::BuildInt16ImageFITS(3, 2, values));
+
+    EXPECT_FALSE(GzipFITSByteSource::Create(CreateMemorySource(TestUtil::BuildInt16ImageFITS(3, 2, values))));
+
+    // Act
+    auto source = GzipFITSByteSource::Create(CreateMemorySource(compressed));
+    ASSERT_TRUE(source);
+
+    auto fitsFile = FITSFile::OpenBlocking(std::move(*source));
+    ASSERT_TRUE(fitsFile);
+    ASSERT_EQ((*fitsFile)->GetNumHDUs(), 1U);
+
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), values.size());
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        EXPECT_EQ(imageSlice->physicalValues[x], static_cast<double>(values[x]));
+    }
+}
@@ -0,0 +1,595 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <gtest/gtest.h>
+
+#include "TestUtil.h"
+
+#include <NFITS/FITSFile.h>
+#include <NFITS/MemoryFITSByteSource.h>
+#include <NFITS/MappedFITSByteSource.h>
+#include <NFITS/DiskFITSByteSource.h>
+#include <NFITS/KeywordCommon.h>
+#include <NFITS/Data/ImageData.h>
+#include <NFITS/Data/DataUtil.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <filesystem>
+#include <variant>
+
+using namespace NFITS;
+
+namespace
+{
+    std::unique_ptr<MemoryFITSByteSource> CreateMemorySource(const std::vector<std::byte>& bytes)
+    {
+        auto source = std::make_unique<MemoryFITSByteSource>();
+        (void)source->Resize(ByteSize(bytes.size()));
+        (void)source->WriteBytes(bytes, ByteOffset(0), ByteSize(bytes.size()), true);
+
+        return source;
+    }
+
+    /**
+     * @return The bytes of a FITS file whose primary HDU has no data, and a header which spans multiple blocks,
+     * followed by an int16 image extension HDU
+     */
+    std::vector<std::byte> BuildMultiBlockHeaderFITS(const std::vector<int16_t>& extensionValues)
+    {
+        std::vector<std::byte> bytes;
+
+        TestUtil::AppendKeywordRecord(bytes, "SIMPLE  =                    T");
+        TestUtil::AppendKeywordRecord(bytes, "BITPIX  =                    8");
+        TestUtil::AppendKeywordRecord(bytes, "NAXIS   =                    0");
+        TestUtil::AppendKeywordRecord(bytes, "EXTEND  =                    T");
+        for (unsigned int x = 0; x < 50; ++x)
+        {
+            TestUtil::AppendKeywordRecord(bytes, std::format("HISTORY Processing step {}", x));
+        }
+        TestUtil::AppendKeywordRecord(bytes, "OBJECT  = 'M31     '");
+        TestUtil::AppendKeywordRecord(bytes, "END");
+        TestUtil::PadToBlockSize(bytes, std::byte{' '});
+
+        const auto extensionBytes = TestUtil::BuildInt16TwoImageFITS({}, extensionValues);
+
+        // Skip the two image file's primary HDU, which is a single header block with no data
+        bytes.insert(bytes.end(), extensionBytes.begin() + static_cast<std::ptrdiff_t>(BLOCK_BYTE_SIZE.value), extensionBytes.end());
+
+        return bytes;
+    }
+}
+
+TEST(FITSFile, LazyHeadersMatchEagerOpen)
+{
+    // Setup
+    const std::vector<int16_t> extensionValues{-400, 5000, -6000, 7, 8};
+    const auto fitsBytes = BuildMultiBlockHeaderFITS(extensionValues);
+
+    // Act
+    auto eagerFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes));
+    auto lazyFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), FITSFileOpenParams{.lazyHeaders = true});
+
+    // Assert - The file's structure is known without any header having been parsed
+    ASSERT_TRUE(eagerFile);
+    ASSERT_TRUE(lazyFile);
+    ASSERT_EQ((*lazyFile)->GetNumHDUs(), 2U);
+    ASSERT_EQ((*eagerFile)->GetNumHDUs(), 2U);
+
+    for (uintmax_t hduIndex = 0; hduIndex < 2U; ++hduIndex)
+    {
+        const auto* pEagerHDU = *(*eagerFile)->GetHDU(hduIndex);
+        const auto* pLazyHDU = *(*lazyFile)->GetHDU(hduIndex);
+
+        EXPECT_FALSE(pLazyHDU->header.IsParsed());
+        EXPECT_TRUE(pEagerHDU->header.IsParsed());
+
+        EXPECT_EQ(pLazyHDU->type, pEagerHDU->type);
+        EXPECT_EQ(pLazyHDU->isPrimary, pEagerHDU->isPrimary);
+        EXPECT_EQ(pLazyHDU->GetHeaderBlockStartIndex(), pEagerHDU->GetHeaderBlockStartIndex());
+        EXPECT_EQ(pLazyHDU->GetHeaderBlockCount(), pEagerHDU->GetHeaderBlockCount());
+        EXPECT_EQ(pLazyHDU->GetDataBlockCount(), pEagerHDU->GetDataBlockCount());
+        EXPECT_EQ(pLazyHDU->GetDataByteSize(), pEagerHDU->GetDataByteSize());
+    }
+
+    EXPECT_EQ((*(*lazyFile)->GetHDU(0))->GetHeaderBlockCount(), 2U);
+
+    // Accessing a header's keyword records parses it
+    const auto& lazyHeader = (*(*lazyFile)->GetHDU(0))->header;
+    const auto object = lazyHeader.GetFirstKeywordRecord_AsString("OBJECT");
+
+    EXPECT_TRUE(lazyHeader.IsParsed());
+    ASSERT_TRUE(object);
+    EXPECT_EQ(*object, "M31");
+    EXPECT_EQ(lazyHeader.GetKeywordsStartingWith("HISTORY").size(), 50U);
+    EXPECT_EQ(lazyHeader.GetHeaderBlocks().size(), 2U);
+    EXPECT_FALSE((*(*lazyFile)->GetHDU(1))->header.IsParsed());
+}
+
+TEST(FITSFile, LazyHeadersLoadImageData)
+{
+    // Setup
+    const std::vector<int16_t> extensionValues{-400, 5000, -6000, 7, 8};
+    auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(BuildMultiBlockHeaderFITS(extensionValues)), FITSFileOpenParams{.lazyHeaders = true});
+    ASSERT_TRUE(fitsFile);
+
+    // Act
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(1));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), extensionValues.size());
+    for (std::size_t x = 0; x < extensionValues.size(); ++x)
+    {
+        EXPECT_EQ(imageSlice->physicalValues[x], static_cast<double>(extensionValues[x]));
+    }
+}
+
+TEST(ImageData, KeepsIntegerValuesAtStoredWidth)
+{
+    // Setup
+    const std::vector<int16_t> values{1, -5, 3, 100};
+    const auto fitsBytes = TestUtil::BuildInt16ImageFITS(2, 2, values, {
+        "BZERO   =              32768.0",
+        "BSCALE  =                  2.0",
+        "BLANK   =                   -5"
+    });
+
+    auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes));
+    ASSERT_TRUE(fitsFile);
+
+    // Act
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    ASSERT_TRUE(imageData);
+
+    const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+
+    // Assert
+    ASSERT_TRUE(std::holds_alternative<std::span<const int16_t>>((*imageData)->GetPhysicalValues().GetRawValues()));
+
+    ASSERT_TRUE(imageSlice);
+    ASSERT_EQ(imageSlice->physicalValues.size(), values.size());
+    EXPECT_EQ(imageSlice->physicalValues[0], 32770.0);
+    EXPECT_TRUE(std::isnan(imageSlice->physicalValues[1]));
+    EXPECT_EQ(imageSlice->physicalValues[2], 32774.0);
+    EXPECT_EQ(imageSlice->physicalValues[3], 32968.0);
+
+    EXPECT_EQ(imageSlice->physicalStats.minMax.first, 32770.0);
+    EXPECT_EQ(imageSlice->physicalStats.minMax.second, 32968.0);
+}
+
+TEST(ImageData, LoadsFloat32PhysicalValues)
+{
+    // Setup
+    const std::vector<double> values{1.5, -2.25, 1.0e10, 0.1};
+
+    std::vector<std::byte> fitsBytes;
+    TestUtil::AppendKeywordRecord(fitsBytes, "SIMPLE  =                    T");
+    TestUtil::AppendKeywordRecord(fitsBytes, "BITPIX  =                  -64");
+    TestUtil::AppendKeywordRecord(fitsBytes, "NAXIS   =                    2");
+    TestUtil::AppendKeywordRecord(fitsBytes, "NAXIS1  =                    2");
+    TestUtil::AppendKeywordRecord(fitsBytes, "NAXIS2  =                    2");
+    TestUtil::AppendKeywordRecord(fitsBytes, "BZERO   =                 10.0");
+    TestUtil::AppendKeywordRecord(fitsBytes, "END");
+    TestUtil::PadToBlockSize(fitsBytes, std::byte{' '});
+    for (const auto& value : values)
+    {
+        const auto uValue = std::bit_cast<uint64_t>(value);
+        for (int shift = 56; shift >= 0; shift -= 8)
+        {
+            fitsBytes.push_back(static_cast<std::byte>((uValue >> static_cast<unsigned int>(shift)) & 0xFFU));
+        }
+    }
+    TestUtil::PadToBlockSize(fitsBytes, std::byte{0});
+
+    auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes));
+    ASSERT_TRUE(fitsFile);
+
+    // Act
+    const auto doubleData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0));
+    const auto floatData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0), ImageLoadParams{.float32PhysicalValues = true});
+
+    // Assert
+    ASSERT_TRUE(doubleData);
+    ASSERT_TRUE(floatData);
+
+    const auto doubleValues = (*doubleData)->GetPhysicalValues();
+    const auto floatValues = (*floatData)->GetPhysicalValues();
+
+    EXPECT_TRUE(std::holds_alternative<std::span<const double>>(doubleValues.GetRawValues()));
+    ASSERT_TRUE(std::holds_alternative<std::span<const float>>(floatValues.GetRawValues()));
+
+    ASSERT_EQ(floatValues.size(), values.size());
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        EXPECT_EQ(doubleValues[x], 10.0 + values[x]);
+        EXPECT_EQ(floatValues[x], static_cast<double>(static_cast<float>(10.0 + values[x])));
+    }
+
+    const auto floatSlice = (*floatData)->GetImageSlice(ImageSliceKey{});
+    ASSERT_TRUE(floatSlice);
+    EXPECT_EQ(floatSlice->physicalStats.minMax.first, static_cast<double>(static_cast<float>(10.0 - 2.25)));
+    EXPECT_EQ(floatSlice->physicalStats.minMax.second, static_cast<double>(static_cast<float>(10.0 + 1.0e10)));
+}
+
+TEST(ImageData, LoadsMultiChunkImageFromEachKindOfSource)
+{
+    // Setup - An image whose data spans several read chunks, and whose last chunk is partial
+    static constexpr int64_t WIDTH = 2048;
+    static constexpr int64_t HEIGHT = 3000;
+
+    std::vector<int16_t> values(static_cast<std::size_t>(WIDTH * HEIGHT));
+    for (std::size_t x = 0; x < values.size(); ++x) { values[x] = static_cast<int16_t>((x * 7U) % 65521U); }
+
+    const auto fitsBytes = TestUtil::BuildInt16ImageFITS(WIDTH, HEIGHT, values, {"BZERO   =                100.0"});
+    ASSERT_GT(fitsBytes.size(), READ_CHUNK_BYTE_SIZE.value * 2U);
+
+    const auto filePath = TestUtil::WriteTempFile("nfits_multi_chunk_image.fits", fitsBytes);
+
+    auto mappedSource = MappedFITSByteSource::Open(filePath);
+    auto diskSource = DiskFITSByteSource::Open(filePath, false);
+    ASSERT_TRUE(mappedSource);
+    ASSERT_TRUE(diskSource);
+
+    // A source which supports concurrent reads, one which provides a view of its memory, and one which
+    // supports neither, and so is loaded with a read pipeline
+    auto memoryFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes));
+    auto mappedFile = FITSFile::OpenBlocking(std::move(*mappedSource));
+    auto diskFile = FITSFile::OpenBlocking(std::move(*diskSource));
+    ASSERT_TRUE(memoryFile);
+    ASSERT_TRUE(mappedFile);
+    ASSERT_TRUE(diskFile);
+
+    for (const auto& fitsFile : {memoryFile->get(), mappedFile->get(), diskFile->get()})
+    {
+        // Act
+        const auto imageData = LoadImageDataFromFileBlocking(fitsFile, *fitsFile->GetHDU(0));
+
+        // Assert
+        ASSERT_TRUE(imageData);
+
+        const auto physicalValues = (*imageData)->GetPhysicalValues();
+
+        const auto rawValues = physicalValues.GetRawValues();
+        ASSERT_TRUE(std::holds_alternative<std::span<const int16_t>>(rawValues));
+        EXPECT_TRUE(std::ranges::equal(std::get<std::span<const int16_t>>(rawValues), values));
+
+        EXPECT_EQ(physicalValues[values.size() - 1U], 100.0 + static_cast<double>(values.back()));
+
+        // The stats compiled as the image was loaded match those compiled from all of its values at once
+        const auto imageSlice = (*imageData)->GetImageSlice(ImageSliceKey{});
+        ASSERT_TRUE(imageSlice);
+
+        const auto expectedStats = CompilePhysicalStats({physicalValues});
+        EXPECT_EQ(imageSlice->physicalStats.minMax, expectedStats.minMax);
+        EXPECT_EQ(imageSlice->physicalStats.histogram, expectedStats.histogram);
+        EXPECT_EQ(imageSlice->cubePhysicalStats.histogramCumulative, expectedStats.histogramCumulative);
+    }
+
+    mappedFile->reset();
+    diskFile->reset();
+    std::filesystem::remove(filePath);
+}
+
+TEST(ImageData, LoadCanBeCancelled)
+{
+    // Setup
+    const std::vector<int16_t> values{1, 2, 3, 4};
+    const auto fitsBytes = TestUtil::BuildInt16ImageFITS(2, 2, values);
+
+    auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes));
+    ASSERT_TRUE(fitsFile);
+
+    // Act
+    const auto imageData = LoadImageDataFromFileBlocking(fitsFile->get(), *(*fitsFile)->GetHDU(0), ImageLoadParams{
+        .isCancelled = [](){ return true; }
+    });
+
+    // Assert
+    EXPECT_FALSE(imageData);
+}
+
+TEST(DataUtil, LoadsMultipleHDUsDataInOrder)
+{
+    // Setup - More files than loads which may run at once
+    std::vector<std::unique_ptr<FITSFile>> fitsFiles;
+    std::vector<HDUDataLoad> loads;
+
+    for (int16_t x = 0; x < 5; ++x)
+    {
+        auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(TestUtil::BuildInt16ImageFITS(2, 2, {x, 1, 2, 3})));
+        ASSERT_TRUE(fitsFile);
+
+        loads.push_back(HDUDataLoad{.pFile = fitsFile->get(), .pHDU = *(*fitsFile)->GetHDU(0)});
+        fitsFiles.push_back(std::move(*fitsFile));
+    }
+
+    // Act
+    const auto results = LoadHDUsDataBlocking(loads, ImageLoadParams{}, 2U);
+    const auto cancelledResults = LoadHDUsDataBlocking(loads, ImageLoadParams{.isCancelled = [](){ return true; }}, 2U);
+
+    // Assert
+    ASSERT_EQ(results.size(), loads.size());
+    ASSERT_EQ(cancelledResults.size(), loads.size());
+
+    for (std::size_t x = 0; x < results.size(); ++x)
+    {
+        ASSERT_TRUE(results[x]);
+
+        const auto pImageData = dynamic_cast<const ImageData*>(results[x]->get());
+        ASSERT_NE(pImageData, nullptr);
+
+        const auto imageSlice = pImageData->GetImageSlice(ImageSliceKey{});
+        ASSERT_TRUE(imageSlice);
+        EXPECT_EQ(imageSlice->physicalValues[0], static_cast<double>(x));
+
+        EXPECT_FALSE(cancelledResults[x]);
+    }
+}
+
+TEST(FITSFile, HDUIndexReopensWithoutReadingHeaders)
+{
+    // Setup
+    const std::vector<int16_t> extensionValues{-400, 5000, -6000, 7, 8};
+    const auto fitsBytes = BuildMultiBlockHeaderFITS(extensionValues);
+
+    const auto indexFilePath = std::filesystem::temp_directory_path() / "nfits_hdu_index.idx";
+    std::filesystem::remove(indexFilePath);
+
+    const FITSFileOpenParams params{.hduIndexFilePath = indexFilePath, .hduIndexKey = "file-v1"};
+
+    // Act - Open once to write the index, then reopen a source of the same size but whose bytes are all zero;
+    // only possible if the HDUs come from the index rather than from the source
+    auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), params);
+    ASSERT_TRUE(fitsFile);
+    ASSERT_TRUE(std::filesystem::exists(indexFilePath));
+
+    const auto zeroBytes = std::vector<std::byte>(fitsBytes.size(), std::byte{0});
+    auto indexedFile = FITSFile::OpenBlocking(CreateMemorySource(zeroBytes), params);
+
+    // Assert
+    ASSERT_TRUE(indexedFile);
+    ASSERT_EQ((*indexedFile)->GetNumHDUs(), 2U);
+
+    for (uintmax_t hduIndex = 0; hduIndex < 2U; ++hduIndex)
+    {
+        const auto* pHDU = *(*fitsFile)->GetHDU(hduIndex);
+        const auto* pIndexedHDU = *(*indexedFile)->GetHDU(hduIndex);
+
+        EXPECT_EQ(pIndexedHDU->type, pHDU->type);
+        EXPECT_EQ(pIndexedHDU->isPrimary, pHDU->isPrimary);
+        EXPECT_EQ(pIndexedHDU->GetHeaderBlockStartIndex(), pHDU->GetHeaderBlockStartIndex());
+        EXPECT_EQ(pIndexedHDU->GetHeaderBlockCount(), pHDU->GetHeaderBlockCount());
+        EXPECT_EQ(pIndexedHDU->GetDataBlockCount(), pHDU->GetDataBlockCount());
+        EXPECT_EQ(pIndexedHDU->GetDataByteSize(), pHDU->GetDataByteSize());
+        EXPECT_EQ(pIndexedHDU->header.GetRawBytes(), pHDU->header.GetRawBytes());
+    }
+
+    EXPECT_EQ((*(*indexedFile)->GetHDU(0))->header.GetFirstKeywordRecord_AsString("OBJECT"), "M31");
+
+    // Assert - The index isn't used for a different key, or a source of a different size
+    auto otherKeyParams = params;
+    otherKeyParams.hduIndexKey = "file-v2";
+    EXPECT_FALSE(FITSFile::OpenBlocking(CreateMemorySource(zeroBytes), otherKeyParams));
+
+    std::filesystem::remove(indexFilePath);
+    ASSERT_TRUE(FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), params));
+
+    const auto smallerBytes = TestUtil::BuildInt16ImageFITS(2, 1, {1, 2});
+    const auto smallerFile = FITSFile::OpenBlocking(CreateMemorySource(smallerBytes), params);
+    ASSERT_TRUE(smallerFile);
+    EXPECT_EQ((*(*smallerFile)->GetHDU(0))->GetDataByteSize(), 4U);
+
+    std::filesystem::remove(indexFilePath);
+}
+
+TEST(FITSFile, HDUIndexSavesLazyHeadersWithoutParsing)
+{
+    // Setup
+    const auto fitsBytes = BuildMultiBlockHeaderFITS({1, 2, 3});
+
+    const auto indexFilePath = std::filesystem::temp_directory_path() / "nfits_hdu_index_lazy.idx";
+    std::filesystem::remove(indexFilePath);
+
+    const FITSFileOpenParams params{.lazyHeaders = true, .hduIndexFilePath = indexFilePath, .hduIndexKey = "file-v1"};
+
+    // Act
+    const auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), params);
+
+    // Assert - The index was written, from the headers' raw bytes, without parsing the headers
+    ASSERT_TRUE(fitsFile);
+    ASSERT_TRUE(std::filesystem::exists(indexFilePath));
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(indexFilePath.string() + ".tmp")));
+
+    for (uintmax_t hduIndex = 0; hduIndex < (*fitsFile)->GetNumHDUs(); ++hduIndex)
+    {
+        EXPECT_FALSE((*(*fitsFile)->GetHDU(hduIndex))->header.IsParsed());
+    }
+
+    // Assert - The saved raw bytes are the same as those of the parsed headers
+    const auto indexedFile = FITSFile::OpenBlocking(CreateMemorySource(std::vector<std::byte>(fitsBytes.size())), params);
+    ASSERT_TRUE(indexedFile);
+
+    const auto& header = (*(*fitsFile)->GetHDU(1))->header;
+    const auto rawBytes = header.GetRawBytes();
+    (void)header.GetHeaderBlocks();
+
+    EXPECT_EQ((*(*indexedFile)->GetHDU(1))->header.GetRawBytes(), rawBytes);
+    EXPECT_EQ(header.GetRawBytes(), rawBytes);
+
+    std::filesystem::remove(indexFilePath);
+}
+
+TEST(FITSFile, OpenReportsEachHDUAsRead)
+{
+    // Setup
+    const auto fitsBytes = BuildMultiBlockHeaderFITS({1, 2, 3});
+
+    std::vector<std::pair<std::size_t, uintmax_t>> reportedHDUs;
+
+    const FITSFileOpenParams params{
+        .onHDU = [&](const HDU& hdu, std::size_t hduIndex){ reportedHDUs.emplace_back(hduIndex, hdu.GetHeaderBlockStartIndex()); }
+    };
+
+    // Act
+    const auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), params);
+
+    // Assert
+    ASSERT_TRUE(fitsFile);
+    ASSERT_EQ(reportedHDUs.size(), 2U);
+
+    for (std::size_t x = 0; x < reportedHDUs.size(); ++x)
+    {
+        EXPECT_EQ(reportedHDUs[x].first, x);
+        EXPECT_EQ(reportedHDUs[x].second, (*(*fitsFile)->GetHDU(x))->GetHeaderBlockStartIndex());
+    }
+}
+
+TEST(FITSFile, OpenCanBeCancelledBetweenHDUs)
+{
+    // Setup
+    const auto fitsBytes = BuildMultiBlockHeaderFITS({1, 2, 3});
+
+    std::size_t numReportedHDUs = 0;
+
+    const FITSFileOpenParams params{
+        .onHDU = [&](const HDU&, std::size_t){ numReportedHDUs++; },
+        .isCancelled = [&](){ return numReportedHDUs == 1U; }
+    };
+
+    // Act
+    const auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), params);
+
+    // Assert - Only the first HDU was read before the open was cancelled
+    EXPECT_FALSE(fitsFile);
+    EXPECT_EQ(numReportedHDUs, 1U);
+}
+
+TEST(FITSFile, OpenStopsAfterMaxNumHDUs)
+{
+    // Setup
+    const auto fitsBytes = BuildMultiBlockHeaderFITS({1, 2, 3});
+
+    const auto indexFilePath = std::filesystem::temp_directory_path() / "nfits_hdu_index_max.idx";
+    std::filesystem::remove(indexFilePath);
+
+    std::size_t numReportedHDUs = 0;
+
+    const FITSFileOpenParams params{
+        .hduIndexFilePath = indexFilePath,
+        .hduIndexKey = "file-v1",
+        .onHDU = [&](const HDU&, std::size_t){ numReportedHDUs++; },
+        .maxNumHDUs = 1U
+    };
+
+    // Act
+    const auto fitsFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), params);
+
+    // Assert - Only the first HDU was read, and no index was written for the partially read file
+    ASSERT_TRUE(fitsFile);
+    EXPECT_EQ((*fitsFile)->GetNumHDUs(), 1U);
+    EXPECT_EQ(numReportedHDUs, 1U);
+    EXPECT_FALSE(std::filesystem::exists(indexFilePath));
+
+    // Assert - Only the first HDU is used from a full index
+    ASSERT_TRUE(FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), FITSFileOpenParams{.hduIndexFilePath = indexFilePath, .hduIndexKey = "file-v1"}));
+    ASSERT_TRUE(std::filesystem::exists(indexFilePath));
+
+    const auto indexedFile = FITSFile::OpenBlocking(CreateMemorySource(fitsBytes), params);
+    ASSERT_TRUE(indexedFile);
+    EXPECT_EQ((*indexedFile)->GetNumHDUs(), 1U);
+
+    std::filesystem::remove(indexFilePath);
+}
+
+TEST(Header, KeywordIndexLookups)
+{
+    // Setup - A two block header with duplicate keyword names, an invalid keyword name, and names which
+    // share prefixes
+    std::vector<std::byte> bytes;
+
+    TestUtil::AppendKeywordRecord(bytes, "SIMPLE  =                    T");
+    TestUtil::AppendKeywordRecord(bytes, "NAXIS   =                    2");
+    TestUtil::AppendKeywordRecord(bytes, "NAXIS2  =                   20");
+    TestUtil::AppendKeywordRecord(bytes, "NAXIS1  =                   10");
+    TestUtil::AppendKeywordRecord(bytes, "bad     =                    1");
+    for (unsigned int x = 0; x < 40; ++x)
+    {
+        TestUtil::AppendKeywordRecord(bytes, std::format("CTYPE{}  = 'RA---TAN'", x % 3));
+    }
+    TestUtil::AppendKeywordRecord(bytes, "NAXIS1  =                   99");
+    TestUtil::AppendKeywordRecord(bytes, "END");
+    TestUtil::PadToBlockSize(bytes, std::byte{' '});
+
+    const auto header = Header::FromRawBytes(std::make_shared<const std::vector<std::byte>>(bytes));
+
+    // Act
+    const auto naxis1 = header.GetFirstKeywordRecord_AsInteger("NAXIS1");
+    const auto naxisRecords = header.GetKeywordsStartingWith("NAXIS");
+    const auto ctypeRecords = header.GetKeywordsStartingWith("CTYPE");
+
+    // Assert - The first record with a name is found, and prefix matches are in header order
+    EXPECT_EQ(header.GetNumHeaderBlocks(), 2U);
+    ASSERT_TRUE(naxis1);
+    EXPECT_EQ(*naxis1, 10);
+    EXPECT_FALSE(header.GetFirstKeywordRecord("bad"));
+    EXPECT_FALSE(header.GetFirstKeywordRecord("NAXIS3"));
+    EXPECT_FALSE(header.GetFirstKeywordRecord("NAXIS1234"));
+    EXPECT_EQ(header.GetFirstKeywordRecord_AsString("CTYPE2"), "RA---TAN");
+
+    ASSERT_EQ(naxisRecords.size(), 4U);
+    EXPECT_EQ(naxisRecords[0].GetKeywordName(), "NAXIS");
+    EXPECT_EQ(naxisRecords[1].GetKeywordName(), "NAXIS2");
+    EXPECT_EQ(naxisRecords[2].GetKeywordName(), "NAXIS1");
+    EXPECT_EQ(naxisRecords[3].GetKeywordValue_AsInteger(), 99);
+
+    EXPECT_EQ(ctypeRecords.size(), 40U);
+    EXPECT_TRUE(header.GetKeywordsStartingWith("NAXIS12345").empty());
+    EXPECT_EQ(header.GetKeywordsStartingWith("").size(), 46U);
+}
+
+TEST(Header, TypedValuesMatchKeywordRecordParsing)
+{
+    // Setup - Records whose values are of each type
+    std::vector<std::byte> bytes;
+
+    TestUtil::AppendKeywordRecord(bytes, "SIMPLE  =                    T");
+    TestUtil::AppendKeywordRecord(bytes, "BITPIX  =                  -32 / bits per pixel");
+    TestUtil::AppendKeywordRecord(bytes, "BZERO   =              32768.5");
+    TestUtil::AppendKeywordRecord(bytes, "BSCALE  =              1.0E-02");
+    TestUtil::AppendKeywordRecord(bytes, "OBJECT  = 'M31 / Andromeda'    / name");
+    TestUtil::AppendKeywordRecord(bytes, "COMMENT A comment");
+    TestUtil::AppendKeywordRecord(bytes, "END");
+    TestUtil::PadToBlockSize(bytes, std::byte{' '});
+
+    const auto header = Header::FromRawBytes(std::make_shared<const std::vector<std::byte>>(bytes));
+
+    // Assert - Every typed getter agrees with parsing the record itself, whether or not the value is of the
+    // requested type
+    for (const auto& keywordName : {"SIMPLE", "BITPIX", "BZERO", "BSCALE", "OBJECT", "COMMENT"})
+    {
+        const auto keywordRecord = header.GetFirstKeywordRecord(keywordName);
+        ASSERT_TRUE(keywordRecord);
+
+        EXPECT_EQ(header.GetFirstKeywordRecord_AsInteger(keywordName).value_or(-1), keywordRecord->GetKeywordValue_AsInteger().value_or(-1));
+        EXPECT_EQ(header.GetFirstKeywordRecord_AsReal(keywordName).has_value(), keywordRecord->GetKeywordValue_AsReal().has_value());
+        EXPECT_EQ(header.GetFirstKeywordRecord_AsLogical(keywordName).has_value(), keywordRecord->GetKeywordValue_AsLogical().has_value());
+        EXPECT_EQ(header.GetFirstKeywordRecord_AsString(keywordName).value_or("-"), keywordRecord->GetKeywordValue_AsString().value_or("-"));
+    }
+
+    EXPECT_EQ(header.GetFirstKeywordRecord_AsInteger("BITPIX"), -32);
+    EXPECT_DOUBLE_EQ(*header.GetFirstKeywordRecord_AsReal("BITPIX"), -32.0);
+    EXPECT_DOUBLE_EQ(*header.GetFirstKeywordRecord_AsReal("BZERO"), 32768.5);
+    EXPECT_DOUBLE_EQ(*header.GetFirstKeywordRecord_AsReal("BSCALE"), 0.01);
+    EXPECT_FALSE(header.GetFirstKeywordRecord_AsInteger("BZERO"));
+    EXPECT_EQ(header.GetFirstKeywordRecord_AsLogical("SIMPLE"), true);
+    EXPECT_EQ(header.GetFirstKeywordRecord_AsString("OBJECT"), "M31 / Andromeda");
+    EXPECT_FALSE(header.GetFirstKeywordRecord_AsString("NAXIS"));
+}
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <gtest/gtest.h>
+
+#include <Image/ImageKernels.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace NFITS;
+
+namespace
+{
+    /**
+     * @return The big endian bytes of the provided values
+     */
+    template <typename T>
+    std::vector<std::byte> ToBigEndianBytes(const std::vector<T>& values)
+    {
+        std::vector<std::byte> bytes(values.size() * sizeof(T));
+
+        for (std::size_t x = 0; x < values.size(); ++x)
+        {
+            std::memcpy(bytes.data() + (x * sizeof(T)), &values[x], sizeof(T));
+
+            if constexpr (std::endian::native != std::endian::big)
+            {
+                std::reverse(bytes.begin() + static_cast<std::ptrdiff_t>(x * sizeof(T)),
+                             bytes.begin() + static_cast<std::ptrdiff_t>((x + 1) * sizeof(T)));
+            }
+        }
+
+        return bytes;
+    }
+
+    /**
+     * @return 37 values of type T, which covers full vectors as well as a scalar tail, including the extremes
+     * of T's range
+     */
+    template <typename T>
+    std::vector<T> CreateTestValues()
+    {
+        std::vector<T> values;
+
+        for (int x = 0; x < 35; ++x)
+        {
+            values.push_back(static_cast<T>((x * 37) % 251));
+        }
+        values.push_back(std::numeric_limits<T>::lowest());
+        values.push_back(std::numeric_limits<T>::max());
+
+        return values;
+    }
+
+    template <typename T>
+    void ExpectDecodesToPhysicalValues(int64_t bitpix, const PhysicalValueTransform& transform)
+    {
+        const auto values = CreateTestValues<T>();
+        const auto bytes = ToBigEndianBytes(values);
+
+        std::vector<double> doubleValues(values.size());
+        std::vector<float> floatValues(values.size());
+
+        ASSERT_TRUE(DecodeBigEndianToPhysicalValues(bytes, bitpix, transform, doubleValues)());
+        ASSERT_TRUE(DecodeBigEndianToPhysicalValues(bytes, bitpix, transform, floatValues)());
+
+        for (std::size_t x = 0; x < values.size(); ++x)
+        {
+            const auto expected = transform.Apply(values[x]);
+
+            if (std::isnan(expected))
+            {
+                EXPECT_TRUE(std::isnan(doubleValues[x]));
+                EXPECT_TRUE(std::isnan(floatValues[x]));
+                continue;
+            }
+
+            EXPECT_DOUBLE_EQ(doubleValues[x], expected);
+            EXPECT_FLOAT_EQ(floatValues[x], static_cast<float>(expected));
+        }
+    }
+
+    template <typename T>
+    void ExpectDecodesBigEndianValues()
+    {
+        const auto values = CreateTestValues<T>();
+        const auto bytes = ToBigEndianBytes(values);
+
+        std::vector<T> decoded(values.size());
+        DecodeBigEndianValues(bytes, std::span<T>(decoded));
+
+        EXPECT_EQ(std::memcmp(decoded.data(), values.data(), values.size() * sizeof(T)), 0);
+    }
+}
+
+TEST(ImageKernels, DecodeBigEndianValues)
+{
+    ExpectDecodesBigEndianValues<uint8_t>();
+    ExpectDecodesBigEndianValues<int16_t>();
+    ExpectDecodesBigEndianValues<int32_t>();
+    ExpectDecodesBigEndianValues<float>();
+    ExpectDecodesBigEndianValues<double>();
+}
+
+TEST(ImageKernels, DecodeToPhysicalValues_IdentityTransform)
+{
+    const auto transform = PhysicalValueTransform{};
+
+    ExpectDecodesToPhysicalValues<uint8_t>(8, transform);
+    ExpectDecodesToPhysicalValues<int16_t>(16, transform);
+    ExpectDecodesToPhysicalValues<int32_t>(32, transform);
+    ExpectDecodesToPhysicalValues<float>(-32, transform);
+    ExpectDecodesToPhysicalValues<double>(-64, transform);
+}
+
+TEST(ImageKernels, DecodeToPhysicalValues_ScaledWithBlank)
+{
+    // Note: 74 is one of the test values of every type
+    const auto transform = PhysicalValueTransform{.zero = 32768.0, .scale = 0.5, .blank = 74};
+
+    ExpectDecodesToPhysicalValues<uint8_t>(8, transform);
+    ExpectDecodesToPhysicalValues<int16_t>(16, transform);
+    ExpectDecodesToPhysicalValues<int32_t>(32, transform);
+    ExpectDecodesToPhysicalValues<float>(-32, transform);
+    ExpectDecodesToPhysicalValues<double>(-64, transform);
+}
+
+TEST(ImageKernels, DecodeToPhysicalValues_InvalidInput)
+{
+    const std::vector<std::byte> bytes(6);
+    std::vector<double> physicalValues(4);
+
+    // Unsupported bitpix
+    EXPECT_FALSE(DecodeBigEndianToPhysicalValues(bytes, 24, PhysicalValueTransform{}, physicalValues)());
+
+    // Too few bytes for the number of values
+    EXPECT_FALSE(DecodeBigEndianToPhysicalValues(bytes, 16, PhysicalValueTransform{}, physicalValues)());
+}
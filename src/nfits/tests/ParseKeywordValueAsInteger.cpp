@@ -175,3 +175,16 @@ TEST(ParseKeywordValueAsInteger, FreeFormat_NoComment)
     ASSERT_TRUE(result);
     EXPECT_EQ(*result, 123);
 }
+
+TEST(ParseKeywordValueAsInteger, FixedFormat_OutOfRange)
+{
+    // Setup
+    const std::string keywordRecord = "KEYWORD = 123456789012345678901234567890                                        ";
+    ASSERT_EQ(keywordRecord.length(), 80);
+
+    // Act
+    const auto result = ParseKeywordValue_AsInteger(KeywordRecordCSpan(keywordRecord));
+
+    // Assert
+    EXPECT_FALSE(result);
+}
@@ -287,3 +287,16 @@ TEST(ParseKeywordValueAsReal, FreeFormat_NoComment)
     ASSERT_TRUE(result);
     EXPECT_DOUBLE_EQ(*result, std::stod("2.8988638E+02"));
 }
+
+TEST(ParseKeywordValueAsReal, FixedFormat_OutOfRange)
+{
+    // Setup
+    const std::string keywordRecord = "KEYWORD =           1.0E+99999                                                  ";
+    ASSERT_EQ(keywordRecord.length(), 80);
+
+    // Act
+    const auto result = ParseKeywordValue_AsReal(KeywordRecordCSpan(keywordRecord));
+
+    // Assert
+    EXPECT_FALSE(result);
+}
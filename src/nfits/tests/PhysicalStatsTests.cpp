@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <gtest/gtest.h>
+
+#include <Image/ImagePipeline.h>
+
+#include <NFITS/Image/PhysicalStats.h>
+
+#include <limits>
+#include <vector>
+
+using namespace NFITS;
+
+namespace
+{
+    void ExpectStatsEqual(const PhysicalStats& actual, const PhysicalStats& expected)
+    {
+        EXPECT_EQ(actual.minMax, expected.minMax);
+        EXPECT_EQ(actual.histogram, expected.histogram);
+        EXPECT_EQ(actual.histogramCumulative, expected.histogramCumulative);
+    }
+}
+
+TEST(CalculateImagePhysicalStats, MatchesStatsCompiledPerSliceAndCube)
+{
+    // Setup - Two slice cubes of three 5x4 slices each, with a blank value, and a slice of a single value
+    const auto sliceSpan = ImageSliceSpan{.axes = {5, 4, 3, 2}};
+    static constexpr std::size_t SLICE_SIZE = 20;
+    static constexpr std::size_t CUBE_SIZE = SLICE_SIZE * 3U;
+
+    std::vector<int16_t> values(CUBE_SIZE * 2U);
+    for (std::size_t x = 0; x < values.size(); ++x)
+    {
+        values[x] = static_cast<int16_t>((static_cast<int>(x) * 37 % 101) - 50);
+    }
+    for (std::size_t x = SLICE_SIZE * 4U; x < SLICE_SIZE * 5U; ++x)
+    {
+        values[x] = 7;
+    }
+
+    const auto physicalValues = PhysicalValuesView(
+        PhysicalValuesView::RawValuesSpan(std::span<const int16_t>(values)),
+        PhysicalValueTransform{.zero = 10.0, .scale = 0.5, .blank = values[3]}
+    );
+
+    // Act
+    const auto imageStats = CalculateImagePhysicalStats(physicalValues, sliceSpan);
+
+    // Assert
+    ASSERT_EQ(imageStats.slicePhysicalStats.size(), 6U);
+    ASSERT_EQ(imageStats.sliceCubePhysicalStats.size(), 2U);
+
+    for (std::size_t sliceIndex = 0; sliceIndex < 6U; ++sliceIndex)
+    {
+        ExpectStatsEqual(imageStats.slicePhysicalStats[sliceIndex],
+                         CompilePhysicalStats({physicalValues.subspan(sliceIndex * SLICE_SIZE, SLICE_SIZE)}));
+    }
+
+    for (std::size_t sliceCubeIndex = 0; sliceCubeIndex < 2U; ++sliceCubeIndex)
+    {
+        ExpectStatsEqual(imageStats.sliceCubePhysicalStats[sliceCubeIndex],
+                         CompilePhysicalStats({physicalValues.subspan(sliceCubeIndex * CUBE_SIZE, CUBE_SIZE)}));
+    }
+
+    // The slice of a single value has all of its values in the first bin
+    EXPECT_EQ(imageStats.slicePhysicalStats[4].histogram.front(), SLICE_SIZE);
+}
+
+TEST(CalculateImagePhysicalStats, NoFiniteValues)
+{
+    // Setup
+    const std::vector<double> values(6, std::numeric_limits<double>::quiet_NaN());
+
+    // Act
+    const auto imageStats = CalculateImagePhysicalStats(PhysicalValuesView(std::span<const double>(values)),
+                                                        ImageSliceSpan{.axes = {3, 2}});
+
+    // Assert
+    ASSERT_EQ(imageStats.slicePhysicalStats.size(), 1U);
+    ASSERT_EQ(imageStats.sliceCubePhysicalStats.size(), 1U);
+
+    EXPECT_EQ(imageStats.slicePhysicalStats[0].minMax.first, std::numeric_limits<double>::max());
+    EXPECT_EQ(imageStats.slicePhysicalStats[0].minMax.second, std::numeric_limits<double>::lowest());
+    EXPECT_EQ(imageStats.sliceCubePhysicalStats[0].histogramCumulative.back(), 0U);
+}
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <gtest/gtest.h>
+
+#include "TestUtil.h"
+
+#include <Parsing.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NFITS;
+
+TEST(ScanHeaderBlock, HappyPath)
+{
+    // Setup
+    std::vector<std::byte> bytes;
+
+    TestUtil::AppendKeywordRecord(bytes, "SIMPLE  =                    T");   // 0
+    TestUtil::AppendKeywordRecord(bytes, "COMMENT END of nothing");          // 1
+    TestUtil::AppendKeywordRecord(bytes, "");                                // 2
+    TestUtil::AppendKeywordRecord(bytes, "ENDX    =                    1");  // 3
+    TestUtil::AppendKeywordRecord(bytes, "                               x");// 4
+    TestUtil::AppendKeywordRecord(bytes, "END");                             // 5
+    TestUtil::PadToBlockSize(bytes, std::byte{' '});                         // 6-35
+
+    // Act
+    const auto scan = ScanHeaderBlock(BlockCSpan(bytes.data(), BLOCK_BYTE_SIZE.value));
+
+    // Assert
+    EXPECT_EQ(scan.endRecords, uint64_t{1} << 5U);
+    EXPECT_EQ(scan.valueIndicatorRecords, (uint64_t{1} << 0U) | (uint64_t{1} << 3U));
+    EXPECT_EQ(scan.blankRecords, (((uint64_t{1} << 36U) - 1U) & ~uint64_t{0x3F}) | (uint64_t{1} << 2U));
+}
+
+TEST(ScanHeaderBlock, NoEndKeyword)
+{
+    // Setup - Every record has a value, and the last ends with END in its value
+    std::vector<std::byte> bytes;
+
+    for (unsigned int x = 0; x < KEYWORD_RECORDS_PER_HEADER_BLOCK; ++x)
+    {
+        TestUtil::AppendKeywordRecord(bytes, "OBJECT  = 'END     '");
+    }
+
+    // Act
+    const auto scan = ScanHeaderBlock(BlockCSpan(bytes.data(), BLOCK_BYTE_SIZE.value));
+
+    // Assert
+    EXPECT_EQ(scan.endRecords, 0U);
+    EXPECT_EQ(scan.blankRecords, 0U);
+    EXPECT_EQ(scan.valueIndicatorRecords, (uint64_t{1} << 36U) - 1U);
+}
+
+TEST(ScanHeaderBlock, ZeroFilledBlock)
+{
+    // Setup
+    const std::vector<std::byte> bytes(BLOCK_BYTE_SIZE.value, std::byte{0});
+
+    // Act
+    const auto scan = ScanHeaderBlock(BlockCSpan(bytes.data(), BLOCK_BYTE_SIZE.value));
+
+    // Assert
+    EXPECT_EQ(scan.endRecords, 0U);
+    EXPECT_EQ(scan.blankRecords, 0U);
+    EXPECT_EQ(scan.valueIndicatorRecords, 0U);
+}
+
+TEST(ScanHeaderBlock, MatchesScalarScan)
+{
+    // Setup - Blocks of records built from the bytes which the scan looks for, so that records which are nearly,
+    // but not quite, END, blank, or value records are common
+    static constexpr std::array<char, 6> RECORD_CHARS = {' ', ' ', '=', 'E', 'N', 'D'};
+
+    std::mt19937 generator(1234U);
+    std::uniform_int_distribution<std::size_t> charDistribution(0U, RECORD_CHARS.size() - 1U);
+    std::uniform_int_distribution<unsigned int> kindDistribution(0U, 3U);
+
+    for (unsigned int blockIndex = 0; blockIndex < 100U; ++blockIndex)
+    {
+        std::vector<std::byte> bytes;
+
+        for (unsigned int x = 0; x < KEYWORD_RECORDS_PER_HEADER_BLOCK; ++x)
+        {
+            switch (kindDistribution(generator))
+            {
+                case 0: TestUtil::AppendKeywordRecord(bytes, "END"); break;
+                case 1: TestUtil::AppendKeywordRecord(bytes, ""); break;
+                case 2: TestUtil::AppendKeywordRecord(bytes, "NAXIS   =                    2"); break;
+                default:
+                {
+                    std::string record(KEYWORD_RECORD_BYTE_SIZE.value, ' ');
+                    for (auto& c : record) { c = RECORD_CHARS[charDistribution(generator)]; }
+                    TestUtil::AppendKeywordRecord(bytes, record);
+                }
+                break;
+            }
+        }
+
+        const BlockCSpan blockSpan(bytes.data(), BLOCK_BYTE_SIZE.value);
+
+        // Act
+        const auto scan = ScanHeaderBlock(blockSpan);
+        const auto scalarScan = ScanHeaderBlock_Scalar(blockSpan);
+
+        // Assert
+        EXPECT_EQ(scan.endRecords, scalarScan.endRecords) << "Block " << blockIndex;
+        EXPECT_EQ(scan.blankRecords, scalarScan.blankRecords) << "Block " << blockIndex;
+        EXPECT_EQ(scan.valueIndicatorRecords, scalarScan.valueIndicatorRecords) << "Block " << blockIndex;
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#include <gtest/gtest.h>
+
+#include "TestUtil.h"
+
+#include <NFITS/FITSStreamReader.h>
+
+#include <format>
+#include <sstream>
+#include <string>
+
+using namespace NFITS;
+
+namespace
+{
+    std::stringstream ToStream(const std::vector<std::byte>& bytes)
+    {
+        return std::stringstream(std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()), std::ios::in | std::ios::binary);
+    }
+}
+
+TEST(FITSStreamReader, ReadsEachHDUInOrder)
+{
+    // Setup
+    const std::vector<int16_t> primaryValues{1, -2, 300};
+    const std::vector<int16_t> extensionValues{-400, 5000, -6000, 7, 8};
+    auto stream = ToStream(TestUtil::BuildInt16TwoImageFITS(primaryValues, extensionValues));
+
+    // Act - Collect each HDU's data as it arrives
+    std::vector<uintmax_t> streamBlockStartIndices;
+    std::vector<uintmax_t> dataByteSizes;
+    std::vector<std::vector<int16_t>> values;
+
+    const auto result = ReadFITSStreamBlocking(stream, FITSStreamParams{
+        .onHDU = [&](const StreamedHDU& streamedHDU){
+            streamBlockStartIndices.push_back(streamedHDU.streamBlockStartIndex);
+            dataByteSizes.push_back(streamedHDU.pHDU->GetDataByteSize());
+            values.emplace_back();
+            return true;
+        },
+        .onHDUData = [&](const StreamedHDU&, uintmax_t, std::span<const std::byte> dataBytes){
+            for (std::size_t x = 0; x + 1U < dataBytes.size(); x += 2U)
+            {
+                values.back().push_back(static_cast<int16_t>((std::to_integer<uint16_t>(dataBytes[x]) << 8U) | std::to_integer<uint16_t>(dataBytes[x + 1U])));
+            }
+            return true;
+        }
+    });
+
+    // Assert
+    ASSERT_TRUE(result());
+    EXPECT_EQ(streamBlockStartIndices, (std::vector<uintmax_t>{0U, 2U}));
+    EXPECT_EQ(dataByteSizes, (std::vector<uintmax_t>{primaryValues.size() * 2U, extensionValues.size() * 2U}));
+    ASSERT_EQ(values.size(), 2U);
+    EXPECT_EQ(values[0], primaryValues);
+    EXPECT_EQ(values[1], extensionValues);
+}
+
+TEST(FITSStreamReader, HandsOffDataInBoundedChunks)
+{
+    // Setup - An image whose data spans three blocks
+    std::vector<int16_t> values(BLOCK_BYTE_SIZE.value + 10U);
+    for (std::size_t x = 0; x < values.size(); ++x) { values[x] = static_cast<int16_t>(x); }
+
+    auto stream = ToStream(TestUtil::BuildInt16ImageFITS(static_cast<int64_t>(values.size()), 1, values));
+
+    // Act - Read the data a block at a time
+    std::vector<std::pair<uintmax_t, std::size_t>> chunks;
+
+    const auto result = ReadFITSStreamBlocking(stream, FITSStreamParams{
+        .onHDUData = [&](const StreamedHDU&, uintmax_t dataByteOffset, std::span<const std::byte> dataBytes){
+            chunks.emplace_back(dataByteOffset, dataBytes.size());
+            return true;
+        },
+        .dataChunkByteSize = BLOCK_BYTE_SIZE
+    });
+
+    // Assert - Three chunks, the last of which excludes the final block's padding
+    ASSERT_TRUE(result());
+    ASSERT_EQ(chunks.size(), 3U);
+    EXPECT_EQ(chunks[0], std::make_pair(uintmax_t{0}, std::size_t{BLOCK_BYTE_SIZE.value}));
+    EXPECT_EQ(chunks[1], std::make_pair(uintmax_t{BLOCK_BYTE_SIZE.value}, std::size_t{BLOCK_BYTE_SIZE.value}));
+    EXPECT_EQ(chunks[2], std::make_pair(uintmax_t{BLOCK_BYTE_SIZE.value * 2U}, std::size_t{20U}));
+}
+
+TEST(FITSStreamReader, CallbackStopsReading)
+{
+    // Setup
+    auto stream = ToStream(TestUtil::BuildInt16TwoImageFITS({1, 2}, {3, 4}));
+
+    // Act
+    unsigned int hduCount = 0;
+    const auto result = ReadFITSStreamBlocking(stream, FITSStreamParams{
+        .onHDU = [&](const StreamedHDU&){ hduCount++; return true; },
+        .onHDUData = [&](const StreamedHDU&, uintmax_t, std::span<const std::byte>){ return false; }
+    });
+
+    // Assert
+    EXPECT_TRUE(result());
+    EXPECT_EQ(hduCount, 1U);
+}
+
+TEST(FITSStreamReader, TruncatedStreamFails)
+{
+    // Setup - Cut the stream off partway through the extension HDU's data
+    auto bytes = TestUtil::BuildInt16TwoImageFITS({1, 2}, {3, 4});
+    bytes.resize(bytes.size() - 100U);
+    auto stream = ToStream(bytes);
+
+    // Act
+    unsigned int hduCount = 0;
+    const auto result = ReadFITSStreamBlocking(stream, FITSStreamParams{
+        .onHDU = [&](const StreamedHDU&){ hduCount++; return true; }
+    });
+
+    // Assert - Both HDUs were still handed off, as their headers arrived before the stream ended
+    EXPECT_FALSE(result());
+    EXPECT_EQ(hduCount, 2U);
+}
+
+TEST(FITSStreamReader, HeaderWithoutEndFails)
+{
+    // Setup - A header which never ends
+    std::vector<std::byte> bytes;
+    TestUtil::AppendKeywordRecord(bytes, "SIMPLE  =                    T");
+    for (unsigned int x = 0; x < 200; ++x)
+    {
+        TestUtil::AppendKeywordRecord(bytes, std::format("HISTORY Processing step {}", x));
+    }
+    TestUtil::PadToBlockSize(bytes, std::byte{' '});
+
+    auto stream = ToStream(bytes);
+
+    // Act
+    const auto result = ReadFITSStreamBlocking(stream, FITSStreamParams{.maxHeaderBlockCount = 2U});
+
+    // Assert
+    EXPECT_FALSE(result());
+}
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Joe @ NEON Software
+ *
+ * SPDX-License-Identifier: MIT
+ */
+ 
+#ifndef NFITS_TESTS_TESTUTIL_H
+#define NFITS_TESTS_TESTUTIL_H
+
+#include <NFITS/Def.h>
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <format>
+
+namespace NFITS::TestUtil
+{
+    /**
+     * Appends a keyword record, space padded to the keyword record byte size, to the provided bytes
+     */
+    inline void AppendKeywordRecord(std::vector<std::byte>& bytes, const std::string& keywordRecord)
+    {
+        std::string card = keywordRecord;
+        card.resize(KEYWORD_RECORD_BYTE_SIZE.value, ' ');
+
+        for (const auto& c : card)
+        {
+            bytes.push_back(static_cast<std::byte>(c));
+        }
+    }
+
+    /**
+     * Pads the provided bytes with the provided fill byte until they're a multiple of the block byte size
+     */
+    inline void PadToBlockSize(std::vector<std::byte>& bytes, std::byte fill)
+    {
+        while (bytes.size() % BLOCK_BYTE_SIZE.value != 0)
+        {
+            bytes.push_back(fill);
+        }
+    }
+
+    /**
+     * @return The bytes of a FITS file containing a single primary image HDU of BITPIX=16, with the
+     * provided dimensions, holding the provided (native endianness) values. Any extra keyword records are
+     * appended to the header after the required ones.
+     */
+    inline std::vector<std::byte> BuildInt16ImageFITS(int64_t width,
+                                                      int64_t height,
+                                                      const std::vector<int16_t>& values,
+                                                      const std::vector<std::string>& extraKeywordRecords = {})
+    {
+        std::vector<std::byte> bytes;
+
+        AppendKeywordRecord(bytes, "SIMPLE  =                    T");
+        AppendKeywordRecord(bytes, "BITPIX  =                   16");
+        AppendKeywordRecord(bytes, "NAXIS   =                    2");
+        AppendKeywordRecord(bytes, std::format("NAXIS1  = {:>20}", width));
+        AppendKeywordRecord(bytes, std::format("NAXIS2  = {:>20}", height));
+        for (const auto& keywordRecord : extraKeywordRecords)
+        {
+            AppendKeywordRecord(bytes, keywordRecord);
+        }
+        AppendKeywordRecord(bytes, "END");
+        PadToBlockSize(bytes, std::byte{' '});
+
+        for (const auto& value : values)
+        {
+            const auto uValue = static_cast<uint16_t>(value);
+            bytes.push_back(static_cast<std::byte>(uValue >> 8U));
+            bytes.push_back(static_cast<std::byte>(uValue & 0xFFU));
+        }
+        PadToBlockSize(bytes, std::byte{0});
+
+        return bytes;
+    }
+
+    /**
+     * @return The bytes of a FITS file containing an int16 primary image HDU followed by an int16 image
+     * extension HDU, each holding the provided values
+     */
+    inline std::vector<std::byte> BuildInt16TwoImageFITS(const std::vector<int16_t>& primaryValues, const std::vector<int16_t>& extensionValues)
+    {
+        auto bytes = BuildInt16ImageFITS(static_cast<int64_t>(primaryValues.size()), 1, primaryValues);
+
+        AppendKeywordRecord(bytes, "XTENSION= 'IMAGE   '");
+        AppendKeywordRecord(bytes, "BITPIX  =                   16");
+        AppendKeywordRecord(bytes, "NAXIS   =                    2");
+        AppendKeywordRecord(bytes, std::format("NAXIS1  = {:>20}", extensionValues.size()));
+        AppendKeywordRecord(bytes, "NAXIS2  =                    1");
+        AppendKeywordRecord(bytes, "PCOUNT  =                    0");
+        AppendKeywordRecord(bytes, "GCOUNT  =                    1");
+        AppendKeywordRecord(bytes, "END");
+        PadToBlockSize(bytes, std::byte{' '});
+
+        for (const auto& value : extensionValues)
+        {
+            const auto uValue = static_cast<uint16_t>(value);
+            bytes.push_back(static_cast<std::byte>(uValue >> 8U));
+            bytes.push_back(static_cast<std::byte>(uValue & 0xFFU));
+        }
+        PadToBlockSize(bytes, std::byte{0});
+
+        return bytes;
+    }
+
+    /**
+     * Writes the provided bytes to a file, with the provided file name, in the system's temp directory
+     *
+     * @return The path to the written file
+     */
+    inline std::filesystem::path WriteTempFile(const std::string& fileName, const std::vector<std::byte>& bytes)
+    {
+        const auto filePath = std::filesystem::temp_directory_path() / fileName;
+
+        std::ofstream stream(filePath, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        return filePath;
+    }
+}
+
+#endif //NFITS_TESTS_TESTUTIL_H